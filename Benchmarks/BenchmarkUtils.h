@@ -0,0 +1,55 @@
+#ifndef NUMERA_BENCHMARK_UTILS_H
+#define NUMERA_BENCHMARK_UTILS_H
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/*
+    Small helpers shared by the benchmark executables.
+*/
+
+namespace bench
+{
+    class Stopwatch
+    {
+    public:
+        Stopwatch() : start(std::chrono::steady_clock::now()) {}
+
+        double elapsed_ms() const
+        {
+            auto now = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::milli>(now - start).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // Reads an optional positive size argument, e.g. `bench 100000`
+    inline std::size_t size_arg(int argc, char** argv, int index, std::size_t fallback)
+    {
+        if (argc <= index) return fallback;
+        long long v = std::atoll(argv[index]);
+        return v > 0 ? static_cast<std::size_t>(v) : fallback;
+    }
+
+    // Keeps the optimizer from discarding a computed value
+    template <typename T>
+    inline void do_not_optimize(const T& value)
+    {
+        static volatile const void* sink;
+        sink = &value;
+    }
+
+    inline void report(const std::string& name, double ms, std::size_t operations)
+    {
+        std::cout << name << ": " << ms << " ms";
+        if (operations > 0)
+            std::cout << " (" << (ms * 1e6 / operations) << " ns/op)";
+        std::cout << "\n";
+    }
+}
+
+#endif // NUMERA_BENCHMARK_UTILS_H
@@ -0,0 +1,145 @@
+#include "BenchmarkUtils.h"
+#include "Core/CSVReader.h"
+#include "Core/CSVTable.h"
+#include "io/CsvDataLoader.h"
+#include "stats/RunningStats.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/*
+    Loads a generated CSV (ids, a categorical column, latencies and free
+    text) into CSVTable with one std::string per cell and with
+    string_view cells over a single file buffer, then with only the
+    latency column projected, then streams it through
+    CSVReader batches into a RunningStats without building a table.
+    Each mode runs in a forked child so its peak RSS is measured in
+    isolation (POSIX only).
+
+    usage: numera_bench_csv_load [megabytes] [path]
+*/
+
+static void write_csv(const std::string& path, std::size_t megabytes)
+{
+    const char* regions[] = {"eu-west", "eu-north", "us-east", "us-west", "apac"};
+    const char* words[] = {"timeout", "retry", "cache", "miss", "ok", "slow", "request", "upstream"};
+
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<int> pick(0, 7);
+    std::lognormal_distribution<double> latency(3.0, 0.8);
+
+    std::ofstream out(path, std::ios::binary);
+    out << "id,region,latency,message\n";
+
+    const std::size_t target = megabytes * 1024 * 1024;
+    std::size_t written = 0;
+    std::string line;
+    char number[32];
+    for (std::size_t id = 0; written < target; ++id)
+    {
+        line.clear();
+        line += std::to_string(id);
+        line += ',';
+        line += regions[id % 5];
+        line += ',';
+        std::snprintf(number, sizeof(number), "%.3f", latency(gen));
+        line += number;
+        line += ',';
+        for (int w = 0; w < 4; ++w)
+        {
+            if (w) line += ' ';
+            line += words[pick(gen)];
+        }
+        line += '\n';
+        out << line;
+        written += line.size();
+    }
+}
+
+static double peak_rss_mb()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;   // kilobytes on Linux
+}
+
+static void run(const char* name, const std::string& path, bool string_views,
+                std::vector<std::string> columns = {})
+{
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        nr::CSVLoadOptions options;
+        options.string_views = string_views;
+        options.columns = std::move(columns);
+
+        CSVDataLoader loader;
+        bench::Stopwatch load;
+        nr::CSVTable table(loader, path, options);
+        double ms = load.elapsed_ms();
+
+        std::cout << name << ": " << table.row_count() << " rows\n";
+        bench::report("  load", ms, table.row_count());
+        std::cout << "  peak RSS: " << peak_rss_mb() << " MB\n";
+        std::cout.flush();
+        bench::do_not_optimize(table);
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+static void run_stream(const std::string& path)
+{
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        bench::Stopwatch load;
+        nr::CSVReader reader(path);
+        nr::RunningStats latency;
+        for (;;)
+        {
+            const nr::CSVBatch& batch = reader.next_batch(65536);
+            if (batch.empty()) break;
+            latency.add(batch.column("latency"));
+        }
+        double ms = load.elapsed_ms();
+
+        std::cout << "CSVReader batches: " << reader.rows_read() << " rows, mean latency "
+                  << latency.mean() << "\n";
+        bench::report("  stream", ms, reader.rows_read());
+        std::cout << "  peak RSS: " << peak_rss_mb() << " MB\n";
+        std::cout.flush();
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t megabytes = bench::size_arg(argc, argv, 1, 256);
+    const std::string path = argc > 2 ? argv[2] : "numera_bench_load.csv";
+
+    write_csv(path, megabytes);
+    std::cout << "file: " << megabytes << " MB\n";
+
+    run("std::string cells", path, false);
+    run("string_view cells", path, true);
+    run("std::string cells, latency only", path, false, {"latency"});
+    run_stream(path);
+
+    std::remove(path.c_str());
+    return 0;
+}
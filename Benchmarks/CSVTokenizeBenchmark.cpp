@@ -0,0 +1,111 @@
+#include "BenchmarkUtils.h"
+#include "io/CsvDataLoader.h"
+#include "io/CsvScanner.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+    Tokenizer throughput on a generated numeric CSV (8 columns of ids,
+    counts and decimals). Compares the line-by-line std::getline split
+    the loader used before with nr::detail::scan_csv on the same text,
+    then times CSVDataLoader::load_views on the file, which adds reading
+    the file and storing the cells, with 1, 2, 4, ... parsing threads up
+    to max_threads (default hardware_concurrency()).
+
+    usage: numera_bench_csv_tokenize [megabytes] [path] [max_threads]
+*/
+
+static std::string make_csv(std::size_t megabytes)
+{
+    std::mt19937_64 gen(7);
+    std::uniform_int_distribution<int> count(0, 100000);
+    std::normal_distribution<double> value(50.0, 20.0);
+
+    std::string text = "id,a,b,c,d,e,f,g\n";
+    const std::size_t target = megabytes * 1024 * 1024;
+    char number[32];
+    for (std::size_t id = 0; text.size() < target; ++id)
+    {
+        text += std::to_string(id);
+        for (int col = 0; col < 7; ++col)
+        {
+            text += ',';
+            if (col % 2 == 0) text += std::to_string(count(gen));
+            else {
+                std::snprintf(number, sizeof(number), "%.4f", value(gen));
+                text += number;
+            }
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+static void throughput(const char* name, double ms, std::size_t bytes, std::size_t cells)
+{
+    std::cout << name << ": " << ms << " ms, " << (bytes / (1024.0 * 1024.0)) / (ms / 1000.0)
+              << " MB/s (" << cells << " cells)\n";
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t megabytes = bench::size_arg(argc, argv, 1, 256);
+    const std::string path = argc > 2 ? argv[2] : "numera_bench_tokenize.csv";
+
+    std::string text = make_csv(megabytes);
+    std::cout << "text: " << text.size() / (1024 * 1024) << " MB\n";
+
+    {
+        bench::Stopwatch sw;
+        std::istringstream in(text);
+        std::string line, token;
+        std::size_t cells = 0;
+        while (std::getline(in, line))
+        {
+            std::istringstream ss(line);
+            while (std::getline(ss, token, ',')) ++cells;
+        }
+        throughput("getline split", sw.elapsed_ms(), text.size(), cells);
+    }
+
+    {
+        std::string copy = text;
+        bench::Stopwatch sw;
+        std::size_t cells = 0, bytes = 0;
+        nr::detail::scan_csv(&copy[0], copy.size(),
+            [&](std::size_t, std::string_view cell) { ++cells; bytes += cell.size(); },
+            [](std::size_t) {});
+        double ms = sw.elapsed_ms();
+        bench::do_not_optimize(bytes);
+        throughput("scan_csv", ms, text.size(), cells);
+    }
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    }
+    const std::size_t hardware = bench::size_arg(argc, argv, 3, std::max(1u, std::thread::hardware_concurrency()));
+    for (std::size_t threads = 1;; threads = std::min(threads * 2, hardware))
+    {
+        CSVDataLoader loader;
+        loader.set_threads(threads);
+        bench::Stopwatch sw;
+        auto raw = loader.load_views(path);
+        double ms = sw.elapsed_ms();
+        std::size_t cells = 0;
+        for (const auto& col : raw.columns) cells += col.size();
+        throughput(("load_views, " + std::to_string(threads) + " threads").c_str(), ms, text.size(), cells);
+        bench::do_not_optimize(raw);
+        if (threads == hardware) break;
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
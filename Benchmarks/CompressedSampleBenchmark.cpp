@@ -0,0 +1,70 @@
+#include "BenchmarkUtils.h"
+#include "Core/CompressedSample.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/*
+    Per-second metric history: a gauge (double) that moves in 0.1 steps and
+    its timestamps (int64) with occasional gaps. Reports the compression
+    ratio, decode throughput and the cost of aggregate queries.
+
+    usage: numera_bench_compressed_sample [values]
+*/
+
+template <typename T>
+static void run(const char* name, const std::vector<T>& values)
+{
+    bench::Stopwatch encode;
+    nr::CompressedSample<T> sample(values);
+    double encode_ms = encode.elapsed_ms();
+
+    const double raw_mb = values.size() * sizeof(T) / (1024.0 * 1024.0);
+    std::cout << name << ": " << values.size() << " values, "
+              << raw_mb << " MB raw, " << sample.compressed_bytes() / (1024.0 * 1024.0)
+              << " MB compressed, ratio " << sample.compression_ratio() << "\n";
+    bench::report("  encode", encode_ms, values.size());
+
+    bench::Stopwatch decode;
+    double checksum = 0.0;
+    sample.for_each_block([&](nr::Span<const T> block) {
+        for (const auto& v : block) checksum += static_cast<double>(v);
+    });
+    double decode_ms = decode.elapsed_ms();
+    bench::report("  block decode", decode_ms, values.size());
+    std::cout << "  decode throughput: " << raw_mb / (decode_ms / 1000.0) << " MB/s\n";
+
+    bench::Stopwatch aggregates;
+    double agg = static_cast<double>(sample.min()) + static_cast<double>(sample.max()) + sample.sum();
+    bench::report("  min + max + sum from block aggregates", aggregates.elapsed_ms(), 0);
+
+    bench::do_not_optimize(checksum);
+    bench::do_not_optimize(agg);
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t n = bench::size_arg(argc, argv, 1, 10000000);
+
+    std::mt19937_64 gen(42);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::uniform_int_distribution<int> gap(0, 999);
+
+    std::vector<double> gauge(n);
+    std::vector<std::int64_t> timestamps(n);
+    double level = 500.0;
+    std::int64_t t = 1700000000;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (i % 4 == 0) level += std::round(step(gen)) / 10.0;
+        gauge[i] = level;
+        t += gap(gen) == 0 ? 2 : 1;
+        timestamps[i] = t;
+    }
+
+    run("gauge (double, XOR)", gauge);
+    run("timestamps (int64, delta-of-delta)", timestamps);
+    return 0;
+}
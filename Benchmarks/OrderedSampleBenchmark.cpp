@@ -0,0 +1,63 @@
+#include "BenchmarkUtils.h"
+#include "Core/NumericSample.h"
+#include "Core/OrderedSample.h"
+
+#include <random>
+#include <vector>
+
+/*
+    Live leaderboard workload: every update inserts one value, removes the
+    oldest one and then queries the median and the 99th percentile.
+
+    usage: numera_bench_ordered_sample [sample_size] [updates]
+*/
+
+int main(int argc, char** argv)
+{
+    const std::size_t n = bench::size_arg(argc, argv, 1, 100000);
+    const std::size_t updates = bench::size_arg(argc, argv, 2, 2000);
+
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, 1000.0);
+
+    std::vector<double> initial(n);
+    for (auto& v : initial) v = dist(gen);
+    std::vector<double> incoming(updates);
+    for (auto& v : incoming) v = dist(gen);
+
+    std::cout << "sample size " << n << ", " << updates << " updates\n";
+
+    double checksum_ordered = 0.0;
+    {
+        bench::Stopwatch build;
+        nr::OrderedSample<double> ordered(initial);
+        bench::report("OrderedSample build", build.elapsed_ms(), n);
+
+        bench::Stopwatch sw;
+        for (std::size_t i = 0; i < updates; ++i)
+        {
+            ordered.erase(initial[i % n]);
+            ordered.insert(incoming[i]);
+            checksum_ordered += ordered.median() + ordered.percentile(99.0);
+        }
+        bench::report("OrderedSample update + median + p99", sw.elapsed_ms(), updates);
+    }
+
+    double checksum_sample = 0.0;
+    {
+        nr::NumericSample<double> sample(initial);
+
+        bench::Stopwatch sw;
+        for (std::size_t i = 0; i < updates; ++i)
+        {
+            sample.remove_at(0);
+            sample.push_back(incoming[i]);
+            checksum_sample += sample.median() + sample.percentile(99.0);
+        }
+        bench::report("NumericSample update + median + p99", sw.elapsed_ms(), updates);
+    }
+
+    bench::do_not_optimize(checksum_ordered);
+    bench::do_not_optimize(checksum_sample);
+    return 0;
+}
@@ -0,0 +1,352 @@
+#ifndef NUMERA_CORE_BITMAP_H
+#define NUMERA_CORE_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+
+/**
+ * @brief A compact, word-addressable bit vector.
+ *
+ * Bitmap stores one bit per element in 64-bit words so that callers can
+ * inspect or combine 64 flags at a time. It is used by the containers to
+ * keep per-element flags (e.g. tombstones) alongside their values without
+ * touching the values themselves.
+ *
+ * The same type serves as an Arrow-style validity bitmap (bit set = value
+ * present). for_each_run() walks it a word at a time and reports maximal
+ * runs of set bits, so fully valid stretches are handed to the caller as
+ * plain contiguous index ranges that compile to tight (vectorizable) loops.
+ *
+ * Bits beyond size() in the last word are always kept at zero.
+ */
+
+namespace nr
+{
+    class Bitmap
+    {
+    public:
+        using word_type = std::uint64_t;
+        using size_type = std::size_t;
+
+        static constexpr size_type word_bits = 64;
+
+        Bitmap() = default;
+        explicit Bitmap(size_type size, bool value = false);
+
+        /// Takes over ready-made words (e.g. from a comparison kernel), bits beyond size are dropped
+        static Bitmap from_words(std::vector<word_type> words, size_type size);
+
+        size_type size() const noexcept;
+        bool empty() const noexcept;
+        void clear() noexcept;
+        void resize(size_type size, bool value = false);
+        void reserve(size_type size);
+        void push_back(bool value);
+
+        /// Removes bit at index and shifts the following bits down by one (O(n/64))
+        void erase(size_type index);
+
+        bool test(size_type index) const;
+        bool operator[](size_type index) const;
+        void set(size_type index, bool value = true);
+        void reset(size_type index);
+
+        /// Number of set bits
+        size_type count() const noexcept;
+
+        /// Word-wise combination, both bitmaps must have the same size
+        Bitmap& operator&=(const Bitmap& other);
+        Bitmap& operator|=(const Bitmap& other);
+        void flip() noexcept;
+
+        /// Calls f(begin, end) for every maximal run [begin, end) of set bits
+        template <typename F>
+        void for_each_run(F f) const;
+
+        /// Calls f(index) for every set bit in increasing order
+        template <typename F>
+        void for_each_set(F f) const;
+
+        /// Raw word access, word i holds bits [64*i, 64*i + 63]
+        size_type word_count() const noexcept;
+        word_type word(size_type index) const;
+        const std::vector<word_type>& words() const noexcept;
+
+        /// Overwrites word i, bits beyond size() are dropped
+        void set_word(size_type index, word_type value);
+
+    private:
+        static size_type words_for(size_type bits) noexcept;
+        void clear_tail() noexcept;
+
+        std::vector<word_type> bits;
+        size_type bit_count = 0;
+    };
+
+    inline Bitmap::Bitmap(size_type size, bool value)
+    {
+        resize(size, value);
+    }
+
+    inline Bitmap Bitmap::from_words(std::vector<word_type> words, size_type size)
+    {
+        if (words.size() != words_for(size))
+            throw std::invalid_argument("Bitmap::from_words: word count does not match size");
+        Bitmap result;
+        result.bits = std::move(words);
+        result.bit_count = size;
+        result.clear_tail();
+        return result;
+    }
+
+    inline Bitmap::size_type Bitmap::size() const noexcept
+    {
+        return bit_count;
+    }
+
+    inline bool Bitmap::empty() const noexcept
+    {
+        return bit_count == 0;
+    }
+
+    inline void Bitmap::clear() noexcept
+    {
+        bits.clear();
+        bit_count = 0;
+    }
+
+    inline void Bitmap::resize(size_type size, bool value)
+    {
+        if (size > bit_count && value)
+        {
+            // fill the partially used last word before growing
+            for (size_type i = bit_count; i < size && (i % word_bits) != 0; ++i)
+                bits[i / word_bits] |= word_type{1} << (i % word_bits);
+        }
+        bits.resize(words_for(size), value ? ~word_type{0} : word_type{0});
+        bit_count = size;
+        clear_tail();
+    }
+
+    inline void Bitmap::reserve(size_type size)
+    {
+        bits.reserve(words_for(size));
+    }
+
+    inline void Bitmap::push_back(bool value)
+    {
+        if (bit_count % word_bits == 0)
+            bits.push_back(0);
+        if (value)
+            bits.back() |= word_type{1} << (bit_count % word_bits);
+        ++bit_count;
+    }
+
+    inline void Bitmap::erase(size_type index)
+    {
+        if (index >= bit_count)
+            throw std::out_of_range("Bitmap::erase: index out of range");
+
+        size_type w = index / word_bits;
+        size_type b = index % word_bits;
+
+        // Shift the tail of the first affected word, keeping the bits below index
+        word_type low_mask = (word_type{1} << b) - 1;
+        word_type high = (b + 1 < word_bits) ? (bits[w] >> (b + 1)) << b : 0;
+        bits[w] = (bits[w] & low_mask) | high;
+
+        // Pull the lowest bit of every following word into the previous one
+        for (size_type i = w + 1; i < bits.size(); ++i)
+        {
+            bits[i - 1] |= (bits[i] & 1) << (word_bits - 1);
+            bits[i] >>= 1;
+        }
+
+        --bit_count;
+        if (bits.size() > words_for(bit_count))
+            bits.pop_back();
+        clear_tail();
+    }
+
+    inline bool Bitmap::test(size_type index) const
+    {
+        if (index >= bit_count)
+            throw std::out_of_range("Bitmap::test: index out of range");
+        return (bits[index / word_bits] >> (index % word_bits)) & 1;
+    }
+
+    inline bool Bitmap::operator[](size_type index) const
+    {
+        return (bits[index / word_bits] >> (index % word_bits)) & 1;
+    }
+
+    inline void Bitmap::set(size_type index, bool value)
+    {
+        if (index >= bit_count)
+            throw std::out_of_range("Bitmap::set: index out of range");
+        word_type mask = word_type{1} << (index % word_bits);
+        if (value)
+            bits[index / word_bits] |= mask;
+        else
+            bits[index / word_bits] &= ~mask;
+    }
+
+    inline void Bitmap::reset(size_type index)
+    {
+        set(index, false);
+    }
+
+    inline Bitmap::size_type Bitmap::count() const noexcept
+    {
+        size_type total = 0;
+        for (word_type w : bits)
+            total += static_cast<size_type>(__builtin_popcountll(w));
+        return total;
+    }
+
+    inline Bitmap& Bitmap::operator&=(const Bitmap& other)
+    {
+        if (other.bit_count != bit_count)
+            throw std::invalid_argument("Bitmap: size mismatch");
+        for (size_type i = 0; i < bits.size(); ++i)
+            bits[i] &= other.bits[i];
+        return *this;
+    }
+
+    inline Bitmap& Bitmap::operator|=(const Bitmap& other)
+    {
+        if (other.bit_count != bit_count)
+            throw std::invalid_argument("Bitmap: size mismatch");
+        for (size_type i = 0; i < bits.size(); ++i)
+            bits[i] |= other.bits[i];
+        return *this;
+    }
+
+    inline void Bitmap::flip() noexcept
+    {
+        for (auto& w : bits)
+            w = ~w;
+        clear_tail();
+    }
+
+    template <typename F>
+    inline void Bitmap::for_each_run(F f) const
+    {
+        size_type run_begin = 0;
+        size_type run_end = 0;
+        bool open = false;
+
+        auto emit = [&](size_type b, size_type e) {
+            // Glue runs that continue across a word boundary
+            if (open && run_end == b)
+            {
+                run_end = e;
+                return;
+            }
+            if (open) f(run_begin, run_end);
+            run_begin = b;
+            run_end = e;
+            open = true;
+        };
+
+        for (size_type w = 0; w < bits.size(); ++w)
+        {
+            word_type word = bits[w];
+            const size_type base = w * word_bits;
+
+            // Fast paths: all-valid and all-missing words
+            if (word == ~word_type{0})
+            {
+                emit(base, base + word_bits);
+                continue;
+            }
+
+            while (word != 0)
+            {
+                size_type start = static_cast<size_type>(__builtin_ctzll(word));
+                word_type shifted = word >> start;
+                size_type len = (~shifted == 0) ? word_bits - start
+                                                : static_cast<size_type>(__builtin_ctzll(~shifted));
+                emit(base + start, base + start + len);
+
+                if (start + len >= word_bits)
+                    word = 0;
+                else
+                    word &= ~((word_type{1} << (start + len)) - 1);
+            }
+        }
+
+        if (open) f(run_begin, run_end);
+    }
+
+    template <typename F>
+    inline void Bitmap::for_each_set(F f) const
+    {
+        for (size_type w = 0; w < bits.size(); ++w)
+        {
+            word_type word = bits[w];
+            while (word != 0)
+            {
+                f(w * word_bits + static_cast<size_type>(__builtin_ctzll(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+    inline Bitmap::size_type Bitmap::word_count() const noexcept
+    {
+        return bits.size();
+    }
+
+    inline Bitmap::word_type Bitmap::word(size_type index) const
+    {
+        return bits.at(index);
+    }
+
+    inline const std::vector<Bitmap::word_type>& Bitmap::words() const noexcept
+    {
+        return bits;
+    }
+
+    inline void Bitmap::set_word(size_type index, word_type value)
+    {
+        bits.at(index) = value;
+        if (index + 1 == bits.size())
+            clear_tail();
+    }
+
+    inline Bitmap::size_type Bitmap::words_for(size_type count) noexcept
+    {
+        return (count + word_bits - 1) / word_bits;
+    }
+
+    inline void Bitmap::clear_tail() noexcept
+    {
+        size_type used = bit_count % word_bits;
+        if (used != 0 && !bits.empty())
+            bits.back() &= (word_type{1} << used) - 1;
+    }
+
+    /// Combining selections: filter_a & filter_b, filter_a | filter_b, ~filter
+    inline Bitmap operator&(Bitmap lhs, const Bitmap& rhs)
+    {
+        lhs &= rhs;
+        return lhs;
+    }
+
+    inline Bitmap operator|(Bitmap lhs, const Bitmap& rhs)
+    {
+        lhs |= rhs;
+        return lhs;
+    }
+
+    inline Bitmap operator~(Bitmap bitmap)
+    {
+        bitmap.flip();
+        return bitmap;
+    }
+}
+
+#endif // NUMERA_CORE_BITMAP_H
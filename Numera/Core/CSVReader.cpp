@@ -0,0 +1,197 @@
+#include "CSVReader.h"
+#include "io/CsvScanner.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace nr
+{
+    namespace detail
+    {
+        // Text of a raw cell; a quoted cell is unescaped into scratch (the window is left as read)
+        static std::string_view cell_text(const char* first, const char* last, std::string& scratch)
+        {
+            if (first == last || *first != '"')
+                return std::string_view(first, static_cast<std::size_t>(last - first));
+            scratch.assign(first, last);
+            return unquote(&scratch[0], &scratch[0] + scratch.size());
+        }
+    }
+}
+
+// ---- CSVBatch ----
+
+const nr::Column& nr::CSVBatch::column(size_type index) const
+{
+    if (index >= columns.size()) throw std::out_of_range("CSVBatch::column: index out of range");
+    return columns[index];
+}
+
+const nr::Column& nr::CSVBatch::column(const std::string& name) const
+{
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it == names.end()) throw std::out_of_range("CSVBatch::column: column not found: " + name);
+    return columns[static_cast<size_type>(it - names.begin())];
+}
+
+// ---- CSVReader ----
+
+nr::CSVReader::CSVReader(const std::string &filename, const CSVLoadOptions &options)
+    : file(filename, std::ios::binary), window(initial_window), options(options)
+{
+    if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+
+    while (complete == begin && fill()) {}
+    std::vector<std::string> file_headers;
+    begin = detail::scan_lines(window.data(), complete, begin, begin + 1,
+        [&](size_type, const char* first, const char* last) {
+            file_headers.emplace_back(detail::cell_text(first, last, scratch));
+        },
+        [](size_type) {});
+
+    for (const auto &entry : options.schema) {
+        if (std::find(file_headers.begin(), file_headers.end(), entry.first) == file_headers.end())
+            throw std::invalid_argument("CSVReader: schema column not found: " + entry.first);
+    }
+
+    // Only the projected columns are kept (all of them without options.columns)
+    slots = CSVDataLoader::Projection{options.columns, {}}.resolve(file_headers);
+    const size_type n = file_headers.size() - static_cast<size_type>(std::count(slots.begin(), slots.end(), CSVDataLoader::npos));
+    batch.names.resize(n);
+    for (size_type c = 0; c < file_headers.size(); ++c)
+        if (slots[c] != CSVDataLoader::npos) batch.names[slots[c]] = file_headers[c];
+
+    column_types.assign(n, ColumnType::string);
+    pinned.assign(n, false);
+    for (size_type c = 0; c < n; ++c) {
+        auto it = options.schema.find(batch.names[c]);
+        if (it == options.schema.end()) continue;
+        column_types[c] = it->second;
+        pinned[c] = true;
+    }
+    batch.columns.resize(n);
+}
+
+const std::vector<std::string>& nr::CSVReader::headers() const noexcept
+{
+    return batch.names;
+}
+
+const std::vector<nr::ColumnType>& nr::CSVReader::types() const noexcept
+{
+    return column_types;
+}
+
+bool nr::CSVReader::done() const noexcept
+{
+    return at_eof && begin == complete;
+}
+
+nr::CSVReader::size_type nr::CSVReader::rows_read() const noexcept
+{
+    return rows_total;
+}
+
+nr::CSVReader::size_type nr::CSVReader::window_size() const noexcept
+{
+    return window.size();
+}
+
+bool nr::CSVReader::fill()
+{
+    if (at_eof) return false;
+
+    // Keep the unconsumed bytes, growing the window only when they already fill it
+    if (begin > 0) {
+        std::memmove(window.data(), window.data() + begin, end - begin);
+        end -= begin;
+        complete -= begin;
+        begin = 0;
+    }
+    if (end == window.size()) window.resize(window.size() * 2);
+
+    file.read(window.data() + end, static_cast<std::streamsize>(window.size() - end));
+    if (file.bad()) throw std::runtime_error("CSVReader: cannot read file");
+    end += static_cast<size_type>(file.gcount());
+    at_eof = file.eof();
+
+    // Lines before complete were already whole; only the new bytes can finish more
+    complete = at_eof ? end : detail::last_line_end(window.data(), complete, end);
+    return true;
+}
+
+void nr::CSVReader::infer_types()
+{
+    inferred = true;
+
+    // Sample the first rows of the window (reading more if the window ends first)
+    while (!at_eof && complete == begin) fill();
+    std::vector<std::vector<std::string>> sample(batch.columns.size());
+    size_type rows = 0;
+    detail::scan_lines(window.data(), complete, begin, complete,
+        [&](size_type column, const char* first, const char* last) {
+            if (column < slots.size() && slots[column] != CSVDataLoader::npos)
+                sample[slots[column]].emplace_back(detail::cell_text(first, last, scratch));
+        },
+        [&](size_type cells) {
+            if (cells > 0) ++rows;
+            return rows < options.inference_rows;
+        });
+
+    for (size_type c = 0; c < column_types.size(); ++c)
+        if (!pinned[c]) column_types[c] = Column::infer(sample[c], options.inference_rows);
+}
+
+void nr::CSVReader::append_cell(size_type file_column, const char* first, const char* last)
+{
+    if (file_column >= slots.size() || slots[file_column] == CSVDataLoader::npos) return;
+    const size_type column = slots[file_column];
+
+    const std::string_view cell = first ? detail::cell_text(first, last, scratch) : std::string_view();
+    Column& col = batch.columns[column];
+    try {
+        col.push_back(cell);
+    } catch (const std::invalid_argument&) {
+        if (pinned[column])
+            throw std::invalid_argument("CSVReader: value '" + std::string(cell) + "' is not a valid " +
+                                        to_string(col.type()) + " for column: " + batch.names[column]);
+        // Later batches start at the wider type
+        column_types[column] = Column::common_type(col.type(), Column::infer_cell(cell));
+        col.widen_to(column_types[column]);
+        col.push_back(cell);
+    }
+}
+
+const nr::CSVBatch& nr::CSVReader::next_batch(size_type n_rows)
+{
+    if (!inferred) infer_types();
+
+    // Clear, keeping capacity, unless the column widened in the previous batch
+    for (size_type c = 0; c < batch.columns.size(); ++c) {
+        Column& col = batch.columns[c];
+        if (col.type() != column_types[c]) col = Column(column_types[c]);
+        else col.clear();
+    }
+    batch.rows = 0;
+    batch.first = rows_total;
+
+    while (batch.rows < n_rows) {
+        if (begin == complete) {
+            if (!fill()) break;
+            continue;
+        }
+        begin = detail::scan_lines(window.data(), complete, begin, complete,
+            [&](size_type column, const char* first, const char* last) {
+                append_cell(column, first, last);
+            },
+            [&](size_type cells) {
+                if (cells == 0) return true;    // blank line
+                for (size_type c = cells; c < slots.size(); ++c) append_cell(c, nullptr, nullptr);
+                return ++batch.rows < n_rows;
+            });
+    }
+
+    rows_total += batch.rows;
+    return batch;
+}
@@ -0,0 +1,137 @@
+#ifndef NUMERA_CORE_CSVREADER_H
+#define NUMERA_CORE_CSVREADER_H
+#include "Core/CSVTable.h"
+#include "Core/Column.h"
+#include "Core/Span.h"
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Reads a CSV file as a sequence of typed column batches.
+ *
+ *     nr::CSVReader reader("events.csv");
+ *     nr::RunningStats latency;
+ *     for (;;) {
+ *         const nr::CSVBatch& batch = reader.next_batch(65536);
+ *         if (batch.empty()) break;
+ *         latency.add(batch.column("latency"));
+ *     }
+ *
+ * Unlike CSVDataLoader and CSVTable, the reader never holds the whole
+ * file: it reads through a window of a few MiB (grown only when a
+ * single line does not fit), tokenizes it with the same scanner as the
+ * loader (RFC 4180 quotes, see io/CsvScanner.h) and parses each cell
+ * straight into the batch's typed columns. Memory is bounded by the
+ * window and one batch, whatever the file size, and pipes work too.
+ *
+ * next_batch() returns a batch owned by the reader and valid until the
+ * next call; its columns are cleared, not reallocated, between batches.
+ * Column types come from CSVLoadOptions::schema, or are inferred from
+ * the first inference_rows rows. An inferred column widens when a later
+ * cell does not fit (int64 -> float64 -> string, as in add_row), and
+ * following batches start at the wider type, so types() only grows.
+ * A cell that does not fit a schema column throws std::invalid_argument.
+ * Rows with fewer cells than headers are padded with blank (missing)
+ * cells, extra cells are ignored and blank lines are skipped. With
+ * CSVLoadOptions::columns only those columns are parsed and kept, in
+ * that order; the other cells are delimited but never converted.
+ */
+
+namespace nr
+{
+    /// Rows [first_row(), first_row() + row_count()) of a file read by CSVReader
+    class CSVBatch
+    {
+    public:
+        using size_type = std::size_t;
+
+        size_type row_count() const noexcept { return rows; }
+        size_type column_count() const noexcept { return columns.size(); }
+        bool empty() const noexcept { return rows == 0; }
+
+        /// Row number of the first row within the file (0 = first row after the headers)
+        size_type first_row() const noexcept { return first; }
+
+        const std::vector<std::string>& headers() const noexcept { return names; }
+
+        const Column& column(size_type index) const;
+        const Column& column(const std::string& name) const;
+
+        /// Typed values of a column (see Column::view)
+        template <typename T>
+        Span<const T> view(const std::string& name) const;
+
+    private:
+        friend class CSVReader;
+
+        std::vector<std::string> names;
+        std::vector<Column> columns;
+        size_type rows = 0;
+        size_type first = 0;
+    };
+
+    class CSVReader
+    {
+    public:
+        using size_type = std::size_t;
+
+        /// Opens filename and reads its header line. Throws std::runtime_error when the
+        /// file cannot be opened, std::invalid_argument for schema or projected columns not
+        /// in the header.
+        /// options.string_views does not apply (cells are always copied out of the window).
+        explicit CSVReader(const std::string& filename, const CSVLoadOptions& options = CSVLoadOptions());
+
+        const std::vector<std::string>& headers() const noexcept;
+
+        /// Storage type of every column so far (known once the first batch is read)
+        const std::vector<ColumnType>& types() const noexcept;
+
+        /// Up to n_rows further rows; an empty batch once the file is exhausted
+        const CSVBatch& next_batch(size_type n_rows);
+
+        /// True when every row has been returned
+        bool done() const noexcept;
+
+        /// Rows returned so far
+        size_type rows_read() const noexcept;
+
+        /// Bytes currently buffered for reading (the window grows only for very long lines)
+        size_type window_size() const noexcept;
+
+    private:
+        static constexpr size_type initial_window = size_type{4} << 20;
+
+        // Reads more of the file behind the unconsumed bytes; false at the end of the file
+        bool fill();
+        void infer_types();
+        void append_cell(size_type file_column, const char* first, const char* last);
+
+        std::ifstream file;
+        std::vector<char> window;
+        size_type begin = 0;        // first unconsumed byte (always the start of a line)
+        size_type complete = 0;     // end of the last complete line in the window
+        size_type end = 0;          // end of the bytes read
+        bool at_eof = false;
+
+        std::vector<size_type> slots;   // batch column of every file column (CSVDataLoader::npos: skipped)
+        std::vector<ColumnType> column_types;
+        std::vector<bool> pinned;   // type fixed by the schema
+        CSVLoadOptions options;
+        bool inferred = false;
+
+        CSVBatch batch;             // also holds the headers
+        size_type rows_total = 0;
+        std::string scratch;        // unescaped text of a quoted cell
+    };
+
+    template <typename T>
+    inline Span<const T> CSVBatch::view(const std::string& name) const
+    {
+        return column(name).view<T>();
+    }
+}
+
+#endif // NUMERA_CORE_CSVREADER_H
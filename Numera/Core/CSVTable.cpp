@@ -1,51 +1,137 @@
 #include "CSVTable.h"
+#include "RadixSort.h"
 
-nr::CSVTable::CSVTable(CSVDataLoader &loader, std::string filename)
+nr::CSVTable::CSVTable(CSVDataLoader &loader, std::string filename, const CSVLoadOptions &options)
 {
-    auto loaded_data = loader.load(filename);
+    // Columns named in the options replace the loader's own projection
+    CSVDataLoader::Projection projection = loader.projection();
+    if (!options.columns.empty()) projection = CSVDataLoader::Projection{options.columns, {}};
+
+    // Schema entries for columns that were not loaded do not apply
+    auto loaded_options = [&]() {
+        CSVLoadOptions effective = options;
+        if (projection.empty()) return effective;
+        for (auto it = effective.schema.begin(); it != effective.schema.end();)
+            it = std::find(headers.begin(), headers.end(), it->first) == headers.end() ? effective.schema.erase(it)
+                                                                                      : std::next(it);
+        return effective;
+    };
+
+    if (options.string_views)
+    {
+        auto raw = loader.load_views(filename, projection);
+        headers = std::move(raw.headers);
+        build_columns(raw.columns, loaded_options(), raw.buffer);
+        return;
+    }
+
+    auto loaded_data = loader.load(filename, projection);
     headers = loader.get_column_order();
+
+    // Validate all headers exist, then take the loaded columns in header order
+    std::vector<std::vector<std::string>> cells;
+    cells.reserve(headers.size());
+    for (const auto &h : headers) {
+        auto it = loaded_data.find(h);
+        if (it == loaded_data.end())
+            throw std::invalid_argument("CSVTable: header not found in loaded data: " + h);
+        cells.push_back(std::move(it->second));
+    }
+
+    build_columns(cells, loaded_options(), nullptr);
+}
+
+nr::CSVTable::CSVTable(CSVDataLoader &loader, std::string filename, std::vector<std::string> columns,
+                       CSVLoadOptions options)
+    : CSVTable(loader, std::move(filename), [&]() {
+          options.columns = std::move(columns);
+          return options;
+      }())
+{
+}
+
+template <typename Cell>
+void nr::CSVTable::build_columns(const std::vector<std::vector<Cell>> &cells, const CSVLoadOptions &options,
+                                 const std::shared_ptr<const void> &buffer)
+{
     // initialize counts
     cols_count = headers.size();
+    rebuild_index();
 
-    size_t n_rows = 0;
-    if (!headers.empty()) {
-        // ensure first header exists in loaded data
-        auto it0 = loaded_data.find(headers[0]);
-        if (it0 == loaded_data.end())
-            throw std::invalid_argument("CSVTable: header not found in loaded data: " + headers[0]);
-        n_rows = it0->second.size();
-
-        // Validate all headers exist and have consistent sizes
-        for (const auto &h : headers) {
-            auto it = loaded_data.find(h);
-            if (it == loaded_data.end())
-                throw std::invalid_argument("CSVTable: header not found in loaded data: " + h);
-            if (it->second.size() != n_rows)
-                throw std::invalid_argument("CSVTable: column sizes are inconsistent for header: " + h);
-        }
+    size_t n_rows = cells.empty() ? 0 : cells[0].size();
+    for (size_t i = 0; i < cells.size(); ++i) {
+        if (cells[i].size() != n_rows)
+            throw std::invalid_argument("CSVTable: column sizes are inconsistent for header: " + headers[i]);
+    }
+
+    for (const auto &entry : options.schema) {
+        if (!has_column(entry.first))
+            throw std::invalid_argument("CSVTable: schema column not found: " + entry.first);
     }
 
     rows_count = n_rows;
 
-    for (size_t i = 0; i < n_rows; ++i)
+    auto make = [&](const std::vector<Cell>& col, ColumnType type) {
+        if constexpr (std::is_same_v<Cell, std::string_view>)
+            return Column::from_views(col, type, buffer);
+        else
+            return Column::from_strings(col, type);
+    };
+
+    columns.reserve(cols_count);
+    pinned.reserve(cols_count);
+    for (size_t i = 0; i < cols_count; ++i)
     {
-        row_type row;
-        row.reserve(cols_count);
-        for (const auto& header : headers)
-        {
-            // safe to use at() because we validated sizes above
-            row.push_back(loaded_data.at(header)[i]);
+        const auto& col = cells[i];
+
+        auto it = options.schema.find(headers[i]);
+        if (it != options.schema.end()) {
+            // Explicit type: a cell that does not fit is an error
+            columns.push_back(make(col, it->second));
+            pinned.push_back(true);
+            continue;
         }
-        data.push_back(std::move(row));
+
+        // Infer from a sample; if a later row does not fit, infer again over the whole column
+        ColumnType type = Column::infer(col, options.inference_rows);
+        try {
+            columns.push_back(make(col, type));
+        } catch (const std::invalid_argument&) {
+            columns.push_back(make(col, Column::infer(col, col.size())));
+        }
+        pinned.push_back(false);
     }
 }
 
-nr::CSVTable::CSVTable(std::vector<cell_type> headers) : headers(std::move(headers)), cols_count(headers.size()), rows_count(0) {}
+nr::CSVTable::CSVTable(std::vector<cell_type> headers) 
+    : headers(std::move(headers)), columns(this->headers.size()), pinned(this->headers.size(), false),
+      rows_count(0), cols_count(this->headers.size())
+{
+    rebuild_index();
+}
+
+nr::CSVTable::CSVTable(std::vector<cell_type> headers, const CSVSchema &schema)
+    : CSVTable(std::move(headers))
+{
+    for (const auto &entry : schema)
+    {
+        size_type index = column_index(entry.first);
+        columns[index] = Column(entry.second);
+        pinned[index] = true;
+    }
+}
  
 
+nr::CSVTable::CSVTable(std::vector<cell_type> headers, std::vector<Column> columns)
+    : headers(std::move(headers)), columns(std::move(columns)), pinned(this->headers.size(), false),
+      rows_count(this->columns.empty() ? 0 : this->columns.front().size()), cols_count(this->headers.size())
+{
+    rebuild_index();
+}
+
 nr::CSVTable::size_type nr::CSVTable::row_count() const noexcept
 {
-    return data.size();
+    return rows_count;
 }
 
 nr::CSVTable::size_type nr::CSVTable::column_count() const noexcept
@@ -55,48 +141,416 @@ nr::CSVTable::size_type nr::CSVTable::column_count() const noexcept
 
 bool nr::CSVTable::empty() const noexcept
 {
-    return data.empty();
+    return rows_count == 0;
 }
 
 nr::CSVTable::row_type nr::CSVTable::row(size_type index) const
 {
-    return data.at(index);
+    if (index >= rows_count) throw std::out_of_range("row: index out of range");
+
+    row_type result;
+    result.reserve(cols_count);
+    for (const auto& col : columns)
+    {
+        result.push_back(col.format(index));
+    }
+    return result;
 }
 
 bool nr::CSVTable::has_column(const std::string &name) const noexcept
 {
-    return std::find(headers.begin(), headers.end(), name) != headers.end();
+    return index_of.find(name) != index_of.end();
 }
 
 nr::CSVTable::size_type nr::CSVTable::column_index(const std::string &name) const
 {
-    auto it = std::find(headers.begin(), headers.end(), name);
-    if (it == headers.end())
+    auto it = index_of.find(name);
+    if (it == index_of.end())
         throw std::out_of_range("column_index: column not found: " + name);
-    return static_cast<size_type>(std::distance(headers.begin(), it));
+    return it->second;
 }
 
-std::vector<nr::CSVTable::cell_type> nr::CSVTable::column(size_type index) const
+nr::ColumnHandle nr::CSVTable::handle(const std::string &name) const
 {
-    if (index >= cols_count) throw std::out_of_range("column: index out of range");
+    return ColumnHandle(column_index(name));
+}
+
+nr::CSVTable::column_type nr::CSVTable::column(size_type index) const
+{
+    const Column& col = column_data(index);
 
-    std::vector<cell_type> result;
-    result.reserve(data.size());
-    for (size_t i = 0; i < data.size(); ++i)
+    column_type result;
+    result.reserve(col.size());
+    for (size_t i = 0; i < col.size(); ++i)
     {
-        // use at() to get checked access into row
-        result.push_back(data[i].at(index));
+        result.push_back(col.format(i));
     }
-
     return result;
 }
 
-std::vector<nr::CSVTable::cell_type> nr::CSVTable::column(const std::string &name) const
+nr::CSVTable::column_type nr::CSVTable::column(const std::string &name) const
 {
     size_type index = column_index(name);
     return column(index);
 }
 
+const nr::Column& nr::CSVTable::column_data(size_type index) const
+{
+    if (index >= cols_count) throw std::out_of_range("column: index out of range");
+    return columns[index];
+}
+
+const nr::Column& nr::CSVTable::column_data(const std::string &name) const
+{
+    return column_data(column_index(name));
+}
+
+const nr::Column& nr::CSVTable::column_data(ColumnHandle column) const
+{
+    return column_data(column.index());
+}
+
+nr::ColumnType nr::CSVTable::column_type_of(const std::string &name) const
+{
+    return column_data(name).type();
+}
+
+nr::Bitmap nr::CSVTable::equal_to(const std::string &column_name, const std::string &value) const
+{
+    return column_data(column_name).equal_to(value);
+}
+
+nr::Bitmap nr::CSVTable::filter(const std::string &column_name, CompareOp op, double value) const
+{
+    return filter(handle(column_name), op, value);
+}
+
+nr::Bitmap nr::CSVTable::filter(ColumnHandle column, CompareOp op, double value) const
+{
+    return column_data(column).compare(op, value);
+}
+
+nr::Bitmap nr::CSVTable::filter(const std::string &column_name, CompareOp op, std::string_view value) const
+{
+    return filter(handle(column_name), op, value);
+}
+
+nr::Bitmap nr::CSVTable::filter(ColumnHandle column, CompareOp op, std::string_view value) const
+{
+    return column_data(column).compare(op, value);
+}
+
+void nr::CSVTable::set_cache_budget(size_type bytes)
+{
+    conversions.set_budget(bytes);
+}
+
+const nr::ConversionCache& nr::CSVTable::conversion_cache() const noexcept
+{
+    return conversions;
+}
+
+std::optional<double> nr::CSVTable::min(const std::string &column_name) const
+{
+    return column_data(column_name).min();
+}
+
+std::optional<double> nr::CSVTable::max(const std::string &column_name) const
+{
+    return column_data(column_name).max();
+}
+
+std::optional<double> nr::CSVTable::min(const std::string &column_name, const Bitmap &selection) const
+{
+    return column_data(column_name).min(selection);
+}
+
+std::optional<double> nr::CSVTable::max(const std::string &column_name, const Bitmap &selection) const
+{
+    return column_data(column_name).max(selection);
+}
+
+void nr::CSVTable::create_index(const std::string &column_name, IndexKind kind, size_type threads)
+{
+    const size_type index = column_index(column_name);
+    if (kind == IndexKind::hash)
+        hash_indexes[index] = HashIndex::build(columns[index], threads);
+    else
+        sorted_indexes[index] = SortedIndex::build(columns[index], threads);
+}
+
+void nr::CSVTable::drop_index(const std::string &column_name, IndexKind kind)
+{
+    const size_type index = column_index(column_name);
+    if (kind == IndexKind::hash)
+        hash_indexes.erase(index);
+    else
+        sorted_indexes.erase(index);
+}
+
+bool nr::CSVTable::has_index(const std::string &column_name, IndexKind kind) const
+{
+    const size_type index = column_index(column_name);
+    return kind == IndexKind::hash ? hash_indexes.count(index) != 0 : sorted_indexes.count(index) != 0;
+}
+
+nr::Bitmap nr::CSVTable::lookup(const std::string &column_name, std::string_view key) const
+{
+    const size_type index = column_index(column_name);
+    auto it = hash_indexes.find(index);
+    if (it == hash_indexes.end())
+        return columns[index].equal_to(key);
+    return it->second.lookup(columns[index], key);
+}
+
+nr::Bitmap nr::CSVTable::range(const std::string &column_name, double lo, double hi) const
+{
+    const size_type index = column_index(column_name);
+    auto it = sorted_indexes.find(index);
+    if (it == sorted_indexes.end())
+        return columns[index].compare(CompareOp::ge, lo) & columns[index].compare(CompareOp::le, hi);
+    return it->second.range(columns[index], lo, hi);
+}
+
+nr::Bitmap nr::CSVTable::range(const std::string &column_name, std::string_view lo, std::string_view hi) const
+{
+    const size_type index = column_index(column_name);
+    auto it = sorted_indexes.find(index);
+    if (it == sorted_indexes.end())
+        return columns[index].compare(CompareOp::ge, lo) & columns[index].compare(CompareOp::le, hi);
+    return it->second.range(columns[index], lo, hi);
+}
+
+nr::GroupBy nr::CSVTable::group_by(const std::string &column_name) const
+{
+    return GroupBy(*this, column_index(column_name));
+}
+
+std::vector<std::vector<nr::CSVTable::size_type>> nr::CSVTable::group_rows(const std::string &column_name) const
+{
+    const Column& col = column_data(column_name);
+    auto codes = col.view<Column::code_type>();
+
+    // Counting pass first so every group is allocated once
+    std::vector<size_type> counts(col.dictionary().size(), 0);
+    for (Column::code_type code : codes)
+        if (code != Column::na_code) ++counts[code];
+
+    std::vector<std::vector<size_type>> groups(counts.size());
+    for (size_type g = 0; g < groups.size(); ++g)
+        groups[g].reserve(counts[g]);
+    for (size_type i = 0; i < codes.size(); ++i)
+        if (codes[i] != Column::na_code) groups[codes[i]].push_back(i);
+    return groups;
+}
+
+namespace nr
+{
+    namespace detail
+    {
+        // Rank of every dictionary code in lexicographic order of the entries
+        static std::vector<std::uint64_t> dictionary_ranks(const Column& col)
+        {
+            const auto& entries = col.dictionary();
+            std::vector<std::size_t> sorted(entries.size());
+            std::iota(sorted.begin(), sorted.end(), std::size_t{0});
+            std::sort(sorted.begin(), sorted.end(),
+                      [&](std::size_t a, std::size_t b) { return entries[a] < entries[b]; });
+
+            std::vector<std::uint64_t> rank(entries.size());
+            for (std::size_t i = 0; i < sorted.size(); ++i)
+                rank[sorted[i]] = i;
+            return rank;
+        }
+
+        // Three-way comparison of two present cells; NaN sorts above every number
+        static int compare_cells(const Column& col, const std::vector<std::uint64_t>& rank,
+                                 std::size_t a, std::size_t b)
+        {
+            auto three_way = [](const auto& x, const auto& y) { return x < y ? -1 : (y < x ? 1 : 0); };
+
+            switch (col.type()) {
+                case ColumnType::int64: {
+                    auto v = col.view<std::int64_t>();
+                    return three_way(v[a], v[b]);
+                }
+                case ColumnType::float64: {
+                    auto v = col.view<double>();
+                    bool nan_a = std::isnan(v[a]), nan_b = std::isnan(v[b]);
+                    if (nan_a || nan_b) return three_way(nan_a, nan_b);
+                    return three_way(v[a], v[b]);
+                }
+                case ColumnType::boolean: {
+                    auto v = col.view<std::uint8_t>();
+                    return three_way(v[a], v[b]);
+                }
+                case ColumnType::string:
+                    return three_way(col.text(a), col.text(b));
+                case ColumnType::dictionary: {
+                    auto v = col.view<Column::code_type>();
+                    return three_way(rank[v[a]], rank[v[b]]);
+                }
+            }
+            return 0;
+        }
+
+        // Radix key of every row: unsigned order equals the requested cell order
+        static void radix_keys(const Column& col, SortOrder order, std::vector<std::uint64_t>& keys)
+        {
+            const std::uint64_t flip = order == SortOrder::descending ? ~std::uint64_t{0} : 0;
+            keys.resize(col.size());
+
+            if (col.type() == ColumnType::int64) {
+                auto v = col.view<std::int64_t>();
+                for (std::size_t i = 0; i < v.size(); ++i)
+                    keys[i] = (static_cast<std::uint64_t>(v[i]) ^ (std::uint64_t{1} << 63)) ^ flip;
+            } else if (col.type() == ColumnType::boolean) {
+                auto v = col.view<std::uint8_t>();
+                for (std::size_t i = 0; i < v.size(); ++i)
+                    keys[i] = std::uint64_t{v[i]} ^ flip;
+            } else {
+                std::vector<std::uint64_t> rank = dictionary_ranks(col);
+                auto v = col.view<Column::code_type>();
+                for (std::size_t i = 0; i < v.size(); ++i)
+                    keys[i] = (v[i] == Column::na_code ? 0 : rank[v[i]]) ^ flip;
+            }
+        }
+    }
+}
+
+nr::RowOrder nr::CSVTable::sort_by(const std::vector<std::string> &column_names, SortOrder order) const
+{
+    return sort_by(column_names, std::vector<SortOrder>(column_names.size(), order));
+}
+
+nr::RowOrder nr::CSVTable::sort_by(const std::vector<std::string> &column_names,
+                                   const std::vector<SortOrder> &orders) const
+{
+    if (column_names.empty())
+        throw std::invalid_argument("sort_by: no key columns");
+    if (orders.size() != column_names.size())
+        throw std::invalid_argument("sort_by: expected one sort order per key column");
+
+    std::vector<const Column*> keys;
+    keys.reserve(column_names.size());
+    for (const auto &name : column_names)
+        keys.push_back(&column_data(name));
+
+    RowOrder result;
+    result.permutation.resize(rows_count);
+    std::iota(result.permutation.begin(), result.permutation.end(), size_type{0});
+    result.leading = handle(column_names.front());
+    result.leading_order = orders.front();
+    result.present = rows_count - keys.front()->na_count();
+
+    bool radix = std::all_of(keys.begin(), keys.end(), [](const Column* col) {
+        return col->type() == ColumnType::int64 || col->type() == ColumnType::boolean ||
+               col->type() == ColumnType::dictionary;
+    });
+
+    if (radix)
+    {
+        // LSD over the keys: sort by the last key first, every pass is stable
+        std::vector<std::uint64_t> radix_keys;
+        for (size_type k = keys.size(); k-- > 0;)
+        {
+            const Column& col = *keys[k];
+            detail::radix_keys(col, orders[k], radix_keys);
+            detail::radix_sort_rows(radix_keys.data(), result.permutation);
+            if (col.na_count() != 0)
+                std::stable_partition(result.permutation.begin(), result.permutation.end(),
+                                      [&](size_type r) { return !col.is_na(r); });
+        }
+        return result;
+    }
+
+    std::vector<std::vector<std::uint64_t>> ranks(keys.size());
+    for (size_type k = 0; k < keys.size(); ++k)
+        if (keys[k]->type() == ColumnType::dictionary) ranks[k] = detail::dictionary_ranks(*keys[k]);
+
+    std::stable_sort(result.permutation.begin(), result.permutation.end(), [&](size_type a, size_type b) {
+        for (size_type k = 0; k < keys.size(); ++k)
+        {
+            const Column& col = *keys[k];
+            bool na_a = col.is_na(a), na_b = col.is_na(b);
+            if (na_a || na_b) {
+                if (na_a != na_b) return na_b;   // missing keys last in either direction
+                continue;
+            }
+            int c = detail::compare_cells(col, ranks[k], a, b);
+            if (c != 0) return orders[k] == SortOrder::ascending ? c < 0 : c > 0;
+        }
+        return false;
+    });
+    return result;
+}
+
+nr::CSVTable nr::CSVTable::materialize(const RowOrder &order) const
+{
+    if (order.size() != rows_count)
+        throw std::invalid_argument("materialize: row order does not match the table");
+
+    CSVTable result;
+    result.headers = headers;
+    result.pinned = pinned;
+    result.index_of = index_of;
+    result.rows_count = rows_count;
+    result.cols_count = cols_count;
+    result.columns.reserve(cols_count);
+    for (const auto& col : columns)
+        result.columns.push_back(col.gather(order.rows()));
+    return result;
+}
+
+nr::TableView nr::CSVTable::slice(size_type begin, size_type end) const
+{
+    if (begin > end || end > rows_count)
+        throw std::out_of_range("slice: row range out of range");
+    return TableView(*this, begin, end);
+}
+
+nr::TableView nr::CSVTable::take(std::vector<size_type> rows) const
+{
+    for (size_type r : rows)
+        if (r >= rows_count) throw std::out_of_range("take: row index out of range");
+    return TableView(*this, std::make_shared<const std::vector<size_type>>(std::move(rows)));
+}
+
+void nr::CSVTable::save(const std::string &filename) const
+{
+    slice(0, rows_count).save(filename);
+}
+
+double nr::CSVTable::percentile(const RowOrder &order, double p) const
+{
+    if (order.size() != rows_count)
+        throw std::invalid_argument("percentile: row order does not match the table");
+    if (p < 0.0 || p > 100.0)
+        throw std::out_of_range("percentile: p must be in [0, 100]");
+
+    const Column& col = column_data(order.key());
+    if (col.type() != ColumnType::int64 && col.type() != ColumnType::float64)
+        throw std::invalid_argument(std::string("percentile: leading key is not numeric: ") + to_string(col.type()));
+
+    const size_type n = order.present_count();
+    if (n == 0)
+        throw std::invalid_argument("percentile: empty data");
+
+    // i-th smallest present value; descending orders hold them back to front
+    auto value = [&](size_type i) {
+        size_type row = order[order.key_order() == SortOrder::ascending ? i : n - 1 - i];
+        return col.type() == ColumnType::int64 ? static_cast<double>(col.view<std::int64_t>()[row])
+                                               : col.view<double>()[row];
+    };
+
+    const double pos = (p / 100.0) * (n - 1);
+    const size_type idx = static_cast<size_type>(std::floor(pos));
+    const double frac = pos - idx;
+    if (idx + 1 < n)
+        return value(idx) * (1.0 - frac) + value(idx + 1) * frac;
+    return value(idx);
+}
+
 void nr::CSVTable::add_row(row_type row)
 {
     if (headers.empty()) {
@@ -107,14 +561,231 @@ void nr::CSVTable::add_row(row_type row)
     {
         throw std::invalid_argument("Row size does not match number of columns");
     }
-    data.push_back(std::move(row));
-    ++rows_count;
+
+    append_cells(1, [&](size_type c, size_type) -> const cell_type& { return row[c]; }, "add_row");
+}
+
+void nr::CSVTable::append_rows(Span<const row_type> rows)
+{
+    if (headers.empty())
+        throw std::invalid_argument("Cannot add rows: headers not defined");
+    for (const row_type& row : rows)
+        if (row.size() != cols_count)
+            throw std::invalid_argument("Row size does not match number of columns");
+
+    append_cells(rows.size(), [&](size_type c, size_type r) -> const cell_type& { return rows[r][c]; },
+                 "append_rows");
+}
+
+void nr::CSVTable::append_columns(const std::vector<column_type> &cells)
+{
+    if (headers.empty())
+        throw std::invalid_argument("Cannot add rows: headers not defined");
+    if (cells.size() != cols_count)
+        throw std::invalid_argument("append_columns: column count does not match number of columns");
+
+    const size_type n = cells.empty() ? 0 : cells.front().size();
+    for (const column_type& column : cells)
+        if (column.size() != n)
+            throw std::invalid_argument("append_columns: columns differ in length");
+
+    append_cells(n, [&](size_type c, size_type r) -> const cell_type& { return cells[c][r]; }, "append_columns");
+}
+
+void nr::CSVTable::reserve(size_type rows)
+{
+    for (Column& col : columns)
+        col.reserve(rows);
+}
+
+template <typename CellAt>
+void nr::CSVTable::append_cells(size_type n, CellAt cell_at, const char* caller)
+{
+    // Type every column before touching any, so a rejected cell leaves the table unchanged.
+    // Inferred columns fold the cells that do not fit into the type they widen to.
+    std::vector<ColumnType> target(cols_count);
+    for (size_type c = 0; c < cols_count; ++c)
+    {
+        const Column* check = &columns[c];
+        Column widened;     // empty column of the type widened to so far
+        for (size_type r = 0; r < n; ++r)
+        {
+            const cell_type& cell = cell_at(c, r);
+            if (check->accepts(cell)) continue;
+            if (pinned[c])
+                throw std::invalid_argument(std::string(caller) + ": value '" + cell + "' is not a valid " +
+                                            to_string(columns[c].type()) + " for column: " + headers[c]);
+            widened = Column(Column::common_type(check->type(), Column::infer_cell(cell)));
+            check = &widened;
+        }
+        target[c] = check->type();
+    }
+
+    for (size_type c = 0; c < cols_count; ++c)
+    {
+        columns[c].widen_to(target[c]);
+        // Grow once per batch, but geometrically so that many small batches stay linear
+        if (columns[c].capacity() < rows_count + n)
+            columns[c].reserve(std::max(rows_count + n, 2 * rows_count));
+        for (size_type r = 0; r < n; ++r)
+            columns[c].push_back(cell_at(c, r));
+    }
+
+    // A widened column changed its keys, so its index is rebuilt instead of extended
+    for (auto& [index, hash] : hash_indexes) {
+        if (hash.type() != columns[index].type()) hash = HashIndex::build(columns[index]);
+        else for (size_type r = 0; r < n; ++r) hash.append(columns[index], rows_count + r);
+    }
+    for (auto& [index, sorted] : sorted_indexes) {
+        if (sorted.type() != columns[index].type()) sorted = SortedIndex::build(columns[index]);
+        else for (size_type r = 0; r < n; ++r) sorted.append(columns[index], rows_count + r);
+    }
+    conversions.clear();
+    rows_count += n;
 }
 
 void nr::CSVTable::clear()
 {
-    data.clear();
+    columns.clear();
+    pinned.clear();
     headers.clear();
+    index_of.clear();
+    hash_indexes.clear();
+    sorted_indexes.clear();
+    conversions.clear();
     rows_count = 0;
     cols_count = 0;
 }
+
+void nr::CSVTable::rebuild_index()
+{
+    index_of.clear();
+    index_of.reserve(headers.size());
+    for (size_type i = 0; i < headers.size(); ++i)
+    {
+        // emplace keeps the first column for duplicated names
+        index_of.emplace(headers[i], i);
+    }
+}
+
+// ---- TableView ----
+
+nr::TableView::size_type nr::TableView::row_count() const noexcept
+{
+    return count;
+}
+
+nr::TableView::size_type nr::TableView::column_count() const noexcept
+{
+    return table->column_count();
+}
+
+bool nr::TableView::empty() const noexcept
+{
+    return count == 0;
+}
+
+nr::TableView::size_type nr::TableView::table_row(size_type index) const
+{
+    if (index >= count) throw std::out_of_range("TableView: row index out of range");
+    return picked ? (*picked)[index] : first + index;
+}
+
+bool nr::TableView::contiguous() const noexcept
+{
+    return !picked;
+}
+
+nr::TableView::row_type nr::TableView::row(size_type index) const
+{
+    return table->row(table_row(index));
+}
+
+nr::TableView::column_type nr::TableView::column(const std::string &name) const
+{
+    const Column& col = table->column_data(name);
+    column_type result;
+    result.reserve(count);
+    for (size_type i = 0; i < count; ++i)
+        result.push_back(col.format(picked ? (*picked)[i] : first + i));
+    return result;
+}
+
+std::optional<double> nr::TableView::min(const std::string &column_name) const
+{
+    return table->column_data(column_name).min(selection());
+}
+
+std::optional<double> nr::TableView::max(const std::string &column_name) const
+{
+    return table->column_data(column_name).max(selection());
+}
+
+nr::TableView nr::TableView::slice(size_type begin, size_type end) const
+{
+    if (begin > end || end > count)
+        throw std::out_of_range("TableView::slice: row range out of range");
+    if (!picked)
+        return TableView(*table, first + begin, first + end);
+    return TableView(*table, std::make_shared<const std::vector<size_type>>(
+                                 picked->begin() + static_cast<std::ptrdiff_t>(begin),
+                                 picked->begin() + static_cast<std::ptrdiff_t>(end)));
+}
+
+nr::TableView nr::TableView::take(const std::vector<size_type> &positions) const
+{
+    std::vector<size_type> rows;
+    rows.reserve(positions.size());
+    for (size_type p : positions)
+        rows.push_back(table_row(p));
+    return TableView(*table, std::make_shared<const std::vector<size_type>>(std::move(rows)));
+}
+
+nr::CSVTable nr::TableView::to_table() const
+{
+    std::vector<Column> columns;
+    columns.reserve(table->cols_count);
+    for (size_type c = 0; c < table->cols_count; ++c)
+        columns.push_back(cells(c));
+
+    CSVTable result(table->headers, std::move(columns));
+    result.rows_count = count;
+    result.pinned = table->pinned;
+    return result;
+}
+
+void nr::TableView::save(const std::string &filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open()) throw std::runtime_error("Cannot open file for writing: " + filename);
+
+    for (size_type c = 0; c < table->cols_count; ++c)
+        file << (c ? "," : "") << table->headers[c];
+    file << '\n';
+
+    for (size_type i = 0; i < count; ++i)
+    {
+        const size_type r = picked ? (*picked)[i] : first + i;
+        for (size_type c = 0; c < table->cols_count; ++c)
+            file << (c ? "," : "") << table->columns[c].format(r);
+        file << '\n';
+    }
+}
+
+nr::Column nr::TableView::cells(size_type column) const
+{
+    const Column& col = table->columns[column];
+    if (picked) return col.gather(Span<const size_type>(*picked));
+    return col.slice(first, first + count);
+}
+
+nr::Bitmap nr::TableView::selection() const
+{
+    Bitmap bits(table->rows_count);
+    if (!picked) {
+        for (size_type i = first; i < first + count; ++i) bits.set(i);
+    } else {
+        for (size_type r : *picked) bits.set(r);
+    }
+    return bits;
+}
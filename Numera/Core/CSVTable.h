@@ -2,6 +2,16 @@
 #define CSVTABLE_H
 #include "stats/BasicStats.h"
 #include "io/CsvDataLoader.h"
+#include "Core/Bitmap.h"
+#include "Core/Column.h"
+#include "Core/ColumnIndex.h"
+#include "Core/ConversionCache.h"
+#include "Core/GroupBy.h"
+#include "Core/Instrumentation.h"
+#include "Core/NumericParse.h"
+#include "Core/NumericSample.h"
+#include "Core/Span.h"
+#include "Core/TableBuilder.h"
 
 #include <optional>
 #include <iostream>
@@ -15,13 +25,84 @@
 #include <algorithm>
 #include <numeric>
 #include <cmath>
+#include <cctype>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <type_traits>
 
 /**
  * @brief A lightweight container for column-oriented CSV-like data.
  *
- * CSVTable stores data as a mapping from keys (e.g. column names)
- * to vectors of values. Each key represents a logical group or column,
- * and the associated vector holds all values belonging to that group.
+ * CSVTable stores data column-major: every column owns one contiguous,
+ * typed buffer (see Column). When a file is loaded the type of each
+ * column is inferred from its first rows, so numeric columns cost
+ * 8 bytes per cell and extract<T>/view<T> read them without parsing.
+ * An explicit schema overrides inference for selected columns.
+ * Low-cardinality text columns are dictionary-encoded; equality
+ * filters (equal_to) and grouping (group_rows) then work on the
+ * integer codes, which can also be passed to
+ * ProbabilitySampling::stratified as strata labels.
+ * row(i) and column() format the typed cells back to text.
+ *
+ * With CSVLoadOptions::string_views the file is memory-mapped (see
+ * io/MappedFile.h) and the mapping owns all text: numeric cells are
+ * parsed straight from it and string cells are std::string_view slices
+ * of it, so loading does not allocate per cell. CSVLoadOptions::columns
+ * (or CSVTable(loader, filename, {"a", "b"})) loads only those columns:
+ * the tokenizer skips the other cells without storing them, so memory
+ * grows with the selected columns only.
+ *
+ * Subsets are described by selections instead of copied tables:
+ * filter() evaluates a predicate column-at-a-time into a Bitmap (SIMD
+ * comparisons on numeric columns, codes on dictionary columns), and
+ * selections combine with &, | and ~. extract_selected() gathers the
+ * selected values, and the NullableStats functions accept a selection
+ * as their mask, e.g. nr::arithmetic_mean(view<double>("x"), sel,
+ * na_policy::skip). Note that ~filter(...) also selects missing cells.
+ * Numeric columns keep min/max zones per block of rows, so filters and
+ * min()/max() skip or answer whole blocks without reading them (counted
+ * in scan_counters(), see Instrumentation.h).
+ *
+ * sort_by() orders rows by one or more key columns without moving any
+ * cell: it returns a RowOrder, a permutation of row indices. Keys
+ * stored as integers, booleans or dictionary codes are radix sorted;
+ * float and string keys use a stable comparison sort. Missing keys sort
+ * last in either direction and ties keep their original row order. The
+ * order can be iterated lazily (for (auto r : order) table.row(r)),
+ * materialized once into a new table with materialize(), or reused for
+ * O(1) percentiles of its leading key and top-k row selections.
+ *
+ * slice(begin, end) and take(rows) return a TableView: a window of rows
+ * that shares the table's columns. Views format rows, extract typed
+ * values, answer min/max and save like a table; a slice also exposes
+ * its typed cells through view<T>() without copying. to_table() copies
+ * the rows into an owning table when one is needed.
+ *
+ * group_by(key).agg({...}) aggregates value columns per distinct key
+ * into a new table (see GroupBy).
+ *
+ * Bulk ingestion avoids the per-row cost of add_row: append_rows() and
+ * append_columns() check all cells column by column, widen each column
+ * at most once and grow it once, and reserve() preallocates. Values that
+ * are already typed go through a TableBuilder, which fills typed buffers
+ * and moves them into a table without a text round trip.
+ *
+ * Repeated point and range queries on a column can use a secondary
+ * index (see ColumnIndex.h): create_index(name, IndexKind::hash) serves
+ * lookup(), IndexKind::sorted serves range(). Both return the same
+ * selections as the equivalent filters, which they fall back to when
+ * the column has no index. add_row() keeps the indexes up to date.
+ *
+ * extract<T>() converts a column on every call. extract_cached<T>()
+ * keeps the converted buffer in a per-table, memory-bounded LRU cache
+ * (see ConversionCache) and returns the same shared buffer until the
+ * table changes.
+ *
+ * Column names are resolved through a hash map. Hot loops can resolve
+ * a name once with handle() and pass the ColumnHandle instead.
  *
  * The class provides basic container semantics (iteration, access,
  * insertion, removal) as well as simple descriptive statistics
@@ -36,22 +117,113 @@
 
 namespace nr
 {
+    /// Column name -> storage type, overrides schema inference
+    using CSVSchema = std::unordered_map<std::string, ColumnType>;
+
+    struct CSVLoadOptions
+    {
+        CSVSchema schema;                   // explicit column types
+        std::size_t inference_rows = 1024;  // rows sampled to infer the other columns
+        bool string_views = false;          // keep the file in one buffer, text cells view into it
+        std::vector<std::string> columns;   // load only these, in this order (empty: the loader's projection)
+    };
+
+    class CSVTable;
+    class TableView;
+
+    /// A column resolved once by CSVTable::handle(); stays valid while the
+    /// table keeps its column layout (until clear())
+    class ColumnHandle
+    {
+    public:
+        ColumnHandle() = default;
+
+        std::size_t index() const noexcept { return idx; }
+        bool valid() const noexcept { return idx != npos; }
+
+    private:
+        friend class CSVTable;
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        explicit ColumnHandle(std::size_t index) noexcept : idx(index) {}
+
+        std::size_t idx = npos;
+    };
+
+    enum class SortOrder
+    {
+        ascending,
+        descending
+    };
+
+    enum class IndexKind
+    {
+        hash,       // equality lookups
+        sorted      // range queries
+    };
+
+    /// Permutation of row indices produced by CSVTable::sort_by(). Position i
+    /// holds the row that comes i-th in sorted order.
+    class RowOrder
+    {
+    public:
+        using size_type      = std::size_t;
+        using const_iterator = std::vector<size_type>::const_iterator;
+
+        RowOrder() = default;
+
+        size_type size() const noexcept { return permutation.size(); }
+        bool empty() const noexcept { return permutation.empty(); }
+
+        /// Row index at a sorted position (unchecked)
+        size_type operator[](size_type position) const noexcept { return permutation[position]; }
+
+        const_iterator begin() const noexcept { return permutation.begin(); }
+        const_iterator end() const noexcept { return permutation.end(); }
+        Span<const size_type> rows() const noexcept { return Span<const size_type>(permutation); }
+
+        /// First k rows in sorted order (all rows when k >= size())
+        Span<const size_type> top(size_type k) const { return rows().subspan(0, k); }
+
+        /// Leading key column and its direction
+        ColumnHandle key() const noexcept { return leading; }
+        SortOrder key_order() const noexcept { return leading_order; }
+
+        /// Rows whose leading key is present; they occupy positions [0, present_count())
+        size_type present_count() const noexcept { return present; }
+
+    private:
+        friend class CSVTable;
+
+        std::vector<size_type> permutation;
+        ColumnHandle leading;
+        SortOrder leading_order = SortOrder::ascending;
+        size_type present = 0;
+    };
+
     class CSVTable
     {
     public:
         // Basic types
         using cell_type   = std::string;
         using row_type    = std::vector<cell_type>;
-        using table_type  = std::vector<row_type>;
+        using column_type = std::vector<cell_type>;
+        using table_type  = std::vector<Column>;
         using size_type   = std::size_t;
 
-        CSVTable() : headers(), data(), rows_count(0), cols_count(0) {};
-        CSVTable(CSVDataLoader& loader, std::string filename);
+        CSVTable() : headers(), columns(), pinned(), index_of(), rows_count(0), cols_count(0) {};
+        CSVTable(CSVDataLoader& loader, std::string filename, const CSVLoadOptions& options = {});
+
+        /// Load only the named columns, in that order (see CSVLoadOptions::columns)
+        CSVTable(CSVDataLoader& loader, std::string filename, std::vector<std::string> columns,
+                 CSVLoadOptions options = {});
         CSVTable(const CSVTable&) = default;
         CSVTable(CSVTable&&) = default;
         CSVTable& operator=(const CSVTable&) = default;
         CSVTable& operator=(CSVTable&&) = default;
         explicit CSVTable(std::vector<cell_type> headers);
+        /// Empty table with explicit column types (columns missing from the schema hold strings)
+        CSVTable(std::vector<cell_type> headers, const CSVSchema& schema);
         //CSVTable(IDataLoader<std::unordered_map<std::string, std::vector<std::string>>>& loader, std::string filename);
         ~CSVTable() = default;
 
@@ -64,7 +236,7 @@ namespace nr
         /// Check if table is empty
         bool empty() const noexcept;
 
-        /// Access row by index (throws if out of range)
+        /// Access row by index (throws if out of range), gathered from the columns
         row_type row(size_type index) const;
 
         /// Check if column exists
@@ -73,65 +245,601 @@ namespace nr
         /// Get column index by name (throws if not found)
         size_type column_index(const std::string& name) const;
 
-        /// Extract raw string column by index
-        std::vector<cell_type> column(size_type index) const;
+        /// Resolve a column name once for repeated access (throws if not found)
+        ColumnHandle handle(const std::string& name) const;
+
+        /// Column formatted as strings, by index
+        column_type column(size_type index) const;
+
+        /// Column formatted as strings, by name
+        column_type column(const std::string& name) const;
+
+        /// Typed column storage (no copy)
+        const Column& column_data(size_type index) const;
+        const Column& column_data(const std::string& name) const;
+        const Column& column_data(ColumnHandle column) const;
+
+        /// Storage type of a column
+        ColumnType column_type_of(const std::string& name) const;
+
+        /// Rows whose cell in the column equals value
+        Bitmap equal_to(const std::string& column_name, const std::string& value) const;
+
+        /// Selection of rows where (cell op value) holds; missing cells never match
+        Bitmap filter(const std::string& column_name, CompareOp op, double value) const;
+        Bitmap filter(ColumnHandle column, CompareOp op, double value) const;
+
+        /// Text comparison on string/dictionary columns (numeric columns parse value)
+        Bitmap filter(const std::string& column_name, CompareOp op, std::string_view value) const;
+        Bitmap filter(ColumnHandle column, CompareOp op, std::string_view value) const;
+
+        /// Smallest / largest present value of an int64 or float64 column, optionally among
+        /// the selected rows; empty if there is none (see Column::min)
+        std::optional<double> min(const std::string& column_name) const;
+        std::optional<double> max(const std::string& column_name) const;
+        std::optional<double> min(const std::string& column_name, const Bitmap& selection) const;
+        std::optional<double> max(const std::string& column_name, const Bitmap& selection) const;
+
+        /// Build a secondary index on a column (threads = 0: hardware_concurrency()),
+        /// replacing an existing one of the same kind
+        void create_index(const std::string& column_name, IndexKind kind, size_type threads = 0);
+        void drop_index(const std::string& column_name, IndexKind kind);
+        bool has_index(const std::string& column_name, IndexKind kind) const;
+
+        /// Rows whose cell equals key, like equal_to(); uses the hash index if there is one
+        Bitmap lookup(const std::string& column_name, std::string_view key) const;
+
+        /// Rows with lo <= cell <= hi, like filter(ge) & filter(le); uses the sorted index
+        /// if there is one
+        Bitmap range(const std::string& column_name, double lo, double hi) const;
+        Bitmap range(const std::string& column_name, std::string_view lo, std::string_view hi) const;
+
+        /// Group rows by a key column for aggregation, see GroupBy::agg
+        GroupBy group_by(const std::string& column_name) const;
+
+        /// Row indices of a dictionary column grouped by code (entry i of the result
+        /// holds the rows with value dictionary()[i]); missing cells are left out
+        std::vector<std::vector<size_type>> group_rows(const std::string& column_name) const;
+
+        /// Row order by the key columns, all in the same direction (stable, missing keys last)
+        RowOrder sort_by(const std::vector<std::string>& column_names, SortOrder order = SortOrder::ascending) const;
+
+        /// Row order with one direction per key column
+        RowOrder sort_by(const std::vector<std::string>& column_names, const std::vector<SortOrder>& orders) const;
+
+        /// New table with the rows in the given order
+        CSVTable materialize(const RowOrder& order) const;
 
-        /// Extract raw string column by name
-        std::vector<cell_type> column(const std::string& name) const;
+        /// Rows [begin, end) as a view sharing this table's columns (see TableView)
+        TableView slice(size_type begin, size_type end) const;
+
+        /// The given rows, in that order (rows may repeat), as a view sharing this
+        /// table's columns
+        TableView take(std::vector<size_type> rows) const;
+
+        /// Write the table as CSV (header line, then one line per row; missing cells are blank)
+        void save(const std::string& filename) const;
+
+        /// p-th percentile (R7, like nr::percentile) of the order's numeric leading key,
+        /// read from the sorted positions in O(1); missing keys are ignored
+        double percentile(const RowOrder& order, double p) const;
+
+        /// Zero-copy view of a typed column, T must match its storage type
+        template <typename T>
+        Span<const T> view(const std::string& column_name) const;
+        template <typename T>
+        Span<const T> view(ColumnHandle column) const;
 
         /// Extract column and convert to type T (strict)
         template <typename T>
         std::vector<T> extract(const std::string& column_name) const;
+        template <typename T>
+        std::vector<T> extract(ColumnHandle column) const;
+
+        /// Extract column and convert to type T; empty cells become T{} with their
+        /// validity bit cleared instead of throwing (malformed cells still throw)
+        template <typename T>
+        std::vector<T> extract(const std::string& column_name, Bitmap& validity) const;
+        template <typename T>
+        std::vector<T> extract(ColumnHandle column, Bitmap& validity) const;
+
+        /// Column converted to T (strict, like extract) as a shared, immutable buffer.
+        /// Repeated calls return the same buffer from the table's conversion cache
+        /// until the table changes (add_row, append_rows, append_columns, clear).
+        /// Safe to call from concurrent readers.
+        template <typename T>
+        std::shared_ptr<const std::vector<T>> extract_cached(const std::string& column_name) const;
+        template <typename T>
+        std::shared_ptr<const std::vector<T>> extract_cached(ColumnHandle column) const;
+
+        /// Memory budget of the conversion cache in bytes, least recently used buffers
+        /// are evicted beyond it (0 disables caching)
+        void set_cache_budget(size_type bytes);
+        const ConversionCache& conversion_cache() const noexcept;
 
-        /// Add a new row (must match column count)
+        /// Present values of the selected rows converted to T, in row order
+        /// (selected missing cells are skipped)
+        template <typename T>
+        std::vector<T> extract_selected(const std::string& column_name, const Bitmap& selection) const;
+        template <typename T>
+        std::vector<T> extract_selected(ColumnHandle column, const Bitmap& selection) const;
+
+        /// Values of the given rows converted to T, in that order (strict, like extract),
+        /// e.g. extract_rows<double>("latency", order.top(10))
+        template <typename T>
+        std::vector<T> extract_rows(const std::string& column_name, Span<const size_type> rows) const;
+        template <typename T>
+        std::vector<T> extract_rows(ColumnHandle column, Span<const size_type> rows) const;
+
+        /// Convert a column into a caller-provided buffer of row_count() elements
+        /// without allocating (strict, like extract)
+        template <typename T>
+        void extract_into(const std::string& column_name, Span<T> out) const;
+        template <typename T>
+        void extract_into(ColumnHandle column, Span<T> out) const;
+
+        /// Extract column as a NumericSample, empty cells become missing values (NA)
+        template <typename T>
+        NumericSample<T> extract_sample(const std::string& column_name) const;
+
+        /// Add a new row (must match column count). Inferred columns are widened
+        /// when a cell does not fit their type, explicitly typed columns throw.
         void add_row(row_type row);
 
+        /// Add many rows at once, with the same rules as add_row. Cells are checked
+        /// column by column before anything is stored (a rejected cell leaves the
+        /// table unchanged), each column is widened at most once and grows once.
+        void append_rows(Span<const row_type> rows);
+
+        /// Same as append_rows for cells given column-wise (one vector per column,
+        /// in header order, all of the same length)
+        void append_columns(const std::vector<column_type>& cells);
+
+        /// Preallocate every column for rows rows in total
+        void reserve(size_type rows);
+
         /// Clear all data (keeps header)
         void clear();
 
     private:
+        friend class GroupBy;
+        friend class TableBuilder;
+        friend class TableView;
+
+        // Table over ready-made columns of equal length (e.g. aggregation results)
+        CSVTable(std::vector<cell_type> headers, std::vector<Column> columns);
+
         template <typename T>
-        static T string_to(const std::string& s);
+        static T string_to(std::string_view s);
+
+        // Writes the column converted to T to out. Missing cells become T{} and clear
+        // their bit in validity, or throw when validity is null.
+        template <typename T, typename Out>
+        static void fill(const Column& col, const std::string& name, Out out, Bitmap* validity);
 
-        row_type headers;  // column headers
-        table_type data;     // table data (rows)
+        // Converts a typed (non-string) column to T without parsing, NA slots become T{}
+        template <typename T, typename Out>
+        static void convert(const Column& col, const std::string& name, Out out);
+
+        // Builds the typed columns from raw cells in header order
+        template <typename Cell>
+        void build_columns(const std::vector<std::vector<Cell>>& cells, const CSVLoadOptions& options,
+                           const std::shared_ptr<const void>& buffer);
+
+        // Refills index_of from headers
+        void rebuild_index();
+
+        // Appends n rows whose cells are cell_at(column, row), see append_rows
+        template <typename CellAt>
+        void append_cells(size_type n, CellAt cell_at, const char* caller);
+
+        row_type headers;           // column headers
+        table_type columns;         // table data, one typed buffer per column
+        std::vector<bool> pinned;   // column type set by an explicit schema
+        std::unordered_map<std::string, size_type> index_of;   // header -> column index (first occurrence)
         size_t rows_count;
         size_t cols_count;
+        std::unordered_map<size_type, HashIndex> hash_indexes;      // column index -> index
+        std::unordered_map<size_type, SortedIndex> sorted_indexes;
+        mutable ConversionCache conversions;    // extract_cached buffers
     };
+
+    /// Rows of a CSVTable selected by CSVTable::slice() or take(), without copying
+    /// any cell. The view refers to the table, which must outlive it and must not
+    /// change while it is used.
+    class TableView
+    {
+    public:
+        using cell_type   = CSVTable::cell_type;
+        using row_type    = CSVTable::row_type;
+        using column_type = CSVTable::column_type;
+        using size_type   = std::size_t;
+
+        size_type row_count() const noexcept;
+        size_type column_count() const noexcept;
+        bool empty() const noexcept;
+
+        /// Row of the underlying table at position index of the view
+        size_type table_row(size_type index) const;
+
+        /// Check if the view is a contiguous row range (view<T> works on it)
+        bool contiguous() const noexcept;
+
+        /// Access row by index (throws if out of range)
+        row_type row(size_type index) const;
+
+        /// Column formatted as strings
+        column_type column(const std::string& name) const;
+
+        /// Zero-copy typed values of a slice (throws std::logic_error for take() views);
+        /// T must match the storage type
+        template <typename T>
+        Span<const T> view(const std::string& column_name) const;
+
+        /// Column values converted to T, like CSVTable::extract (strict, or with validity)
+        template <typename T>
+        std::vector<T> extract(const std::string& column_name) const;
+        template <typename T>
+        std::vector<T> extract(const std::string& column_name, Bitmap& validity) const;
+
+        /// Extract column as a NumericSample, empty cells become missing values (NA)
+        template <typename T>
+        NumericSample<T> extract_sample(const std::string& column_name) const;
+
+        /// Smallest / largest present value among the view's rows (int64 and float64
+        /// columns, answered from the column's zone maps where possible)
+        std::optional<double> min(const std::string& column_name) const;
+        std::optional<double> max(const std::string& column_name) const;
+
+        /// Rows [begin, end) / the given positions of this view, as a view of the same table
+        TableView slice(size_type begin, size_type end) const;
+        TableView take(const std::vector<size_type>& positions) const;
+
+        /// Copy the rows into an independent table (column types are kept)
+        CSVTable to_table() const;
+
+        /// Write the rows as CSV, like CSVTable::save
+        void save(const std::string& filename) const;
+
+    private:
+        friend class CSVTable;
+
+        TableView(const CSVTable& table, size_type begin, size_type end) noexcept
+            : table(&table), first(begin), count(end - begin) {}
+        TableView(const CSVTable& table, std::shared_ptr<const std::vector<size_type>> rows) noexcept
+            : table(&table), first(0), count(rows->size()), picked(std::move(rows)) {}
+
+        // The view's cells of one column as a column of their own
+        Column cells(size_type column) const;
+
+        // Bit set for every table row in the view
+        Bitmap selection() const;
+
+        const CSVTable* table;
+        size_type first;            // slice: first table row
+        size_type count;
+        std::shared_ptr<const std::vector<size_type>> picked;  // take: table rows, null for a slice
+    };
+
+    template <typename T>
+    inline Span<const T> TableView::view(const std::string &column_name) const
+    {
+        if (picked)
+            throw std::logic_error("TableView::view: rows are not contiguous, use extract");
+        return table->view<T>(column_name).subspan(first, count);
+    }
+
+    template <typename T>
+    inline std::vector<T> TableView::extract(const std::string &column_name) const
+    {
+        const size_type index = table->column_index(column_name);
+        Column col = cells(index);
+
+        std::vector<T> result;
+        result.reserve(col.size());
+        CSVTable::fill<T>(col, table->headers[index], std::back_inserter(result), nullptr);
+        return result;
+    }
+
+    template <typename T>
+    inline std::vector<T> TableView::extract(const std::string &column_name, Bitmap &validity) const
+    {
+        const size_type index = table->column_index(column_name);
+        Column col = cells(index);
+
+        std::vector<T> result;
+        result.reserve(col.size());
+        CSVTable::fill<T>(col, table->headers[index], std::back_inserter(result), &validity);
+        return result;
+    }
+
+    template <typename T>
+    inline NumericSample<T> TableView::extract_sample(const std::string &column_name) const
+    {
+        Bitmap validity;
+        std::vector<T> values = extract<T>(column_name, validity);
+        return NumericSample<T>(std::move(values), std::move(validity));
+    }
     
+    template <typename T>
+    inline Span<const T> CSVTable::view(const std::string &column_name) const
+    {
+        return view<T>(handle(column_name));
+    }
+
+    template <typename T>
+    inline Span<const T> CSVTable::view(ColumnHandle column) const
+    {
+        return column_data(column).template view<T>();
+    }
+
     template <typename T>
     inline std::vector<T> CSVTable::extract(const std::string &column_name) const
     {
-        std::vector<nr::CSVTable::cell_type> col = column(column_name);
+        return extract<T>(handle(column_name));
+    }
+
+    template <typename T>
+    inline std::vector<T> CSVTable::extract(ColumnHandle column) const
+    {
+        const Column& col = column_data(column);
 
         std::vector<T> result;
         result.reserve(col.size());
+        fill<T>(col, headers[column.index()], std::back_inserter(result), nullptr);
+        return result;
+    }
+
+    template <typename T>
+    inline std::shared_ptr<const std::vector<T>> CSVTable::extract_cached(const std::string &column_name) const
+    {
+        return extract_cached<T>(handle(column_name));
+    }
+
+    template <typename T>
+    inline std::shared_ptr<const std::vector<T>> CSVTable::extract_cached(ColumnHandle column) const
+    {
+        // A bad handle misses and extract throws, so nothing is cached for it
+        return conversions.get_or_make<T>(column.index(), [&]() { return extract<T>(column); });
+    }
 
-        for (const auto& var : col) {
-            result.push_back(string_to<T>(var));
+    template <typename T>
+    inline std::vector<T> CSVTable::extract(const std::string &column_name, Bitmap &validity) const
+    {
+        return extract<T>(handle(column_name), validity);
+    }
+
+    template <typename T>
+    inline std::vector<T> CSVTable::extract(ColumnHandle column, Bitmap &validity) const
+    {
+        const Column& col = column_data(column);
+
+        std::vector<T> result;
+        result.reserve(col.size());
+        fill<T>(col, headers[column.index()], std::back_inserter(result), &validity);
+        return result;
+    }
+
+    template <typename T>
+    inline std::vector<T> CSVTable::extract_selected(const std::string &column_name, const Bitmap &selection) const
+    {
+        return extract_selected<T>(handle(column_name), selection);
+    }
+
+    template <typename T>
+    inline std::vector<T> CSVTable::extract_selected(ColumnHandle column, const Bitmap &selection) const
+    {
+        const Column& col = column_data(column);
+        if (selection.size() != col.size())
+            throw std::invalid_argument("extract_selected: selection size does not match row count");
+
+        Bitmap rows = selection & col.present();
+        std::vector<T> result;
+        result.reserve(rows.count());
+
+        // Numeric storage is gathered directly, other combinations convert the column first
+        if constexpr (std::is_floating_point_v<T> || std::is_same_v<T, std::int64_t>) {
+            if (col.type() == ColumnType::float64 && std::is_floating_point_v<T>) {
+                auto src = col.view<double>();
+                rows.for_each_set([&](size_type i) { result.push_back(static_cast<T>(src[i])); });
+                return result;
+            }
+            if (col.type() == ColumnType::int64) {
+                auto src = col.view<std::int64_t>();
+                rows.for_each_set([&](size_type i) { result.push_back(static_cast<T>(src[i])); });
+                return result;
+            }
         }
 
+        Bitmap validity;
+        std::vector<T> all = extract<T>(column, validity);
+        rows &= validity;
+        rows.for_each_set([&](size_type i) { result.push_back(all[i]); });
         return result;
     }
 
     template <typename T>
-    inline T CSVTable::string_to(const std::string &s)
+    inline std::vector<T> CSVTable::extract_rows(const std::string &column_name, Span<const size_type> rows) const
+    {
+        return extract_rows<T>(handle(column_name), rows);
+    }
+
+    template <typename T>
+    inline std::vector<T> CSVTable::extract_rows(ColumnHandle column, Span<const size_type> rows) const
+    {
+        Column picked = column_data(column).gather(rows);
+
+        std::vector<T> result;
+        result.reserve(picked.size());
+        fill<T>(picked, headers[column.index()], std::back_inserter(result), nullptr);
+        return result;
+    }
+
+    template <typename T>
+    inline void CSVTable::extract_into(const std::string &column_name, Span<T> out) const
+    {
+        extract_into<T>(handle(column_name), out);
+    }
+
+    template <typename T>
+    inline void CSVTable::extract_into(ColumnHandle column, Span<T> out) const
     {
-        std::istringstream iss(s);
-        T value;
+        const Column& col = column_data(column);
+        if (out.size() != col.size())
+            throw std::invalid_argument("extract_into: buffer size does not match row count");
+        fill<T>(col, headers[column.index()], out.begin(), nullptr);
+    }
+
+    template <typename T>
+    inline NumericSample<T> CSVTable::extract_sample(const std::string &column_name) const
+    {
+        Bitmap validity;
+        std::vector<T> values = extract<T>(column_name, validity);
+        return NumericSample<T>(std::move(values), std::move(validity));
+    }
+
+    template <typename T, typename Out>
+    inline void CSVTable::fill(const Column &col, const std::string &name, Out out, Bitmap *validity)
+    {
+        if (col.type() == ColumnType::string) {
+            // Text column: parse every cell, blank cells are missing when a bitmap is requested
+            if (validity) {
+                validity->clear();
+                validity->reserve(col.size());
+            }
+            for (size_type i = 0; i < col.size(); ++i) {
+                std::string_view var = col.text(i);
+                if (validity && var.empty()) {
+                    *out++ = T{};
+                    validity->push_back(false);
+                } else {
+                    *out++ = string_to<T>(var);
+                    if (validity) validity->push_back(true);
+                }
+            }
+            return;
+        }
+
+        if (!validity && col.na_count() != 0)
+            throw std::invalid_argument("extract: column has missing values: " + name);
+        convert<T>(col, name, out);
+
+        if (validity) {
+            if (col.validity().empty()) {
+                validity->clear();
+                validity->resize(col.size(), true);
+            } else {
+                *validity = col.validity();
+            }
+        }
+    }
 
-        if constexpr (std::is_same_v<T, bool>) {
-            if (s == "0" || s == "false") value = false;
-            else if (s == "1" || s == "true") value = true;
-            else throw std::invalid_argument("Invalid bool: " + s);
+    template <typename T, typename Out>
+    inline void CSVTable::convert(const Column &col, const std::string &name, Out out)
+    {
+        auto mismatch = [&]() {
+            return std::invalid_argument("extract: cannot convert " + std::string(to_string(col.type())) +
+                                         " column to the requested type: " + name);
+        };
+
+        if constexpr (std::is_same_v<T, std::string>) {
+            for (size_type i = 0; i < col.size(); ++i)
+                *out++ = col.format(i);
+            return;
+        }
+
+        switch (col.type()) {
+            case ColumnType::int64: {
+                auto src = col.view<std::int64_t>();
+                if constexpr (std::is_same_v<T, bool>) {
+                    for (std::int64_t v : src) {
+                        if (v != 0 && v != 1) throw mismatch();
+                        *out++ = (v == 1);
+                    }
+                } else if constexpr (std::is_integral_v<T>) {
+                    for (std::int64_t v : src) {
+                        if constexpr (!std::is_same_v<T, std::int64_t>) {
+                            if (v < static_cast<std::int64_t>(std::numeric_limits<T>::min()) ||
+                                (v > 0 && static_cast<std::uint64_t>(v) > static_cast<std::uint64_t>(std::numeric_limits<T>::max())))
+                                throw std::invalid_argument("extract: value out of range in column: " + name);
+                        }
+                        *out++ = static_cast<T>(v);
+                    }
+                } else if constexpr (std::is_floating_point_v<T>) {
+                    std::copy(src.begin(), src.end(), out);
+                } else {
+                    for (size_type i = 0; i < src.size(); ++i)
+                        *out++ = col.is_na(i) ? T{} : string_to<T>(col.format(i));
+                }
+                break;
+            }
+            case ColumnType::float64: {
+                auto src = col.view<double>();
+                if constexpr (std::is_floating_point_v<T>) {
+                    std::copy(src.begin(), src.end(), out);
+                } else if constexpr (std::is_integral_v<T>) {
+                    throw mismatch();
+                } else {
+                    for (size_type i = 0; i < src.size(); ++i)
+                        *out++ = col.is_na(i) ? T{} : string_to<T>(col.format(i));
+                }
+                break;
+            }
+            case ColumnType::boolean: {
+                auto src = col.view<std::uint8_t>();
+                if constexpr (std::is_same_v<T, bool>) {
+                    for (std::uint8_t v : src) *out++ = (v != 0);
+                } else {
+                    throw mismatch();
+                }
+                break;
+            }
+            case ColumnType::dictionary: {
+                // Convert each distinct value once, then map the codes
+                std::vector<T> decoded;
+                decoded.reserve(col.dictionary().size());
+                for (const auto& entry : col.dictionary())
+                    decoded.push_back(string_to<T>(entry));
+                for (Column::code_type code : col.view<Column::code_type>())
+                    *out++ = code == Column::na_code ? T{} : decoded[code];
+                break;
+            }
+            case ColumnType::string:
+                throw mismatch();
+        }
+    }
+
+    template <typename T>
+    inline T CSVTable::string_to(std::string_view s)
+    {
+        if constexpr (std::is_same_v<T, std::string>) {
+            return std::string(s);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            bool value;
+            if (!detail::parse_value(s, value))
+                throw std::invalid_argument("Invalid bool: " + std::string(s));
+            return value;
+        } else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, char> &&
+                             !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char>) {
+            // Leading whitespace is tolerated, anything after the number is not
+            std::string_view trimmed = s;
+            while (!trimmed.empty() && std::isspace(static_cast<unsigned char>(trimmed.front())))
+                trimmed.remove_prefix(1);
+
+            T value;
+            if (!detail::parse_value(trimmed, value))
+                throw std::invalid_argument("Cannot convert string to value: " + std::string(s));
+            return value;
         } else {
+            // Other types (characters, user types) go through their stream operator
+            std::istringstream iss{std::string(s)};
+            T value;
             iss >> value;
             if (iss.fail() || !iss.eof()) {
-                throw std::invalid_argument("Cannot convert string to value: " + s);
+                throw std::invalid_argument("Cannot convert string to value: " + std::string(s));
             }
+            return value;
         }
-
-        return value;
     }
 
 }
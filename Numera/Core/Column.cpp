@@ -0,0 +1,906 @@
+#include "Column.h"
+#include "Instrumentation.h"
+#include "NumericParse.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_set>
+
+const char* nr::to_string(ColumnType type) noexcept
+{
+    switch (type) {
+        case ColumnType::int64:   return "int64";
+        case ColumnType::float64: return "float64";
+        case ColumnType::boolean: return "boolean";
+        case ColumnType::string:  return "string";
+        case ColumnType::dictionary: return "dictionary";
+    }
+    return "unknown";
+}
+
+std::string nr::detail::format_double(double value)
+{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    // Shortest representation that round-trips
+    char shortest[32];
+    auto [ptr, ec] = std::to_chars(shortest, shortest + sizeof(shortest), value);
+    if (ec == std::errc()) return std::string(shortest, ptr);
+#endif
+    char buf[32];
+    for (int precision = 15; precision <= 17; ++precision)
+    {
+        std::snprintf(buf, sizeof(buf), "%.*g", precision, value);
+        if (std::strtod(buf, nullptr) == value) break;
+    }
+    return buf;
+}
+
+namespace nr
+{
+    namespace detail
+    {
+        // (data[i] op value) into words, block by block: blocks decided by their
+        // zone are skipped (words stay zero) or filled without reading the cells
+        template <typename T>
+        static void compare_zoned(const T* data, CompareOp op, T value, const ZoneMap<T>& zones,
+                                  std::uint64_t* words) noexcept
+        {
+            constexpr std::size_t block = ZoneMap<T>::block_rows;
+            const std::size_t n = zones.size();
+            std::uint64_t scanned = 0, skipped = 0, answered = 0;
+
+            for (std::size_t b = 0; b < zones.zones().size(); ++b)
+            {
+                const std::size_t begin = b * block;
+                const std::size_t count = std::min(block, n - begin);
+                std::uint64_t* out = words + begin / 64;
+                switch (ZoneMap<T>::match(zones.zones()[b], op, value)) {
+                    case ZoneMatch::none:
+                        ++skipped;
+                        break;
+                    case ZoneMatch::all:
+                        // Missing cells and bits past the end are cleared by the caller
+                        std::fill(out, out + (count + 63) / 64, ~std::uint64_t{0});
+                        ++answered;
+                        break;
+                    case ZoneMatch::some:
+                        compare_to_words(data + begin, count, op, value, out);
+                        ++scanned;
+                        break;
+                }
+            }
+            count_blocks(scanned, skipped, answered);
+        }
+
+        // Smallest or largest present, non-NaN value among the selected rows (all rows
+        // when selection is null). Blocks fully selected are answered by their zone.
+        template <bool Largest, typename T>
+        static std::optional<double> zoned_extremum(const std::vector<T>& data, const ZoneMap<T>& zones,
+                                                    const Bitmap& valid, const Bitmap* selection)
+        {
+            constexpr std::size_t block = ZoneMap<T>::block_rows;
+            const std::size_t n = zones.size();
+            std::uint64_t scanned = 0, skipped = 0, answered = 0;
+
+            bool found = false;
+            T best{};
+            auto take = [&](T v) {
+                if (!found || (Largest ? v > best : v < best)) best = v;
+                found = true;
+            };
+
+            for (std::size_t b = 0; b < zones.zones().size(); ++b)
+            {
+                const auto& zone = zones.zones()[b];
+                if (zone.values == 0) {
+                    ++skipped;
+                    continue;
+                }
+                if (selection == nullptr) {
+                    take(Largest ? zone.max : zone.min);
+                    ++answered;
+                    continue;
+                }
+
+                const std::size_t begin = b * block;
+                const std::size_t count = std::min(block, n - begin);
+                const std::uint64_t* sel = selection->words().data() + begin / 64;
+                const std::uint64_t* present = valid.empty() ? nullptr : valid.words().data() + begin / 64;
+                const std::size_t word_count = (count + 63) / 64;
+
+                // Selected present cells, and whether they are all present cells of the block
+                bool any = false, every = true;
+                for (std::size_t w = 0; w < word_count; ++w)
+                {
+                    const std::size_t bits = std::min<std::size_t>(64, count - w * 64);
+                    const std::uint64_t mask = bits == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+                    const std::uint64_t live = present ? present[w] & mask : mask;
+                    any |= (sel[w] & live) != 0;
+                    every &= (sel[w] & live) == live;
+                }
+
+                if (!any) {
+                    ++skipped;
+                } else if (every) {
+                    take(Largest ? zone.max : zone.min);
+                    ++answered;
+                } else {
+                    for (std::size_t w = 0; w < word_count; ++w)
+                    {
+                        std::uint64_t word = present ? sel[w] & present[w] : sel[w];
+                        while (word != 0) {
+                            const std::size_t i = begin + w * 64 + static_cast<std::size_t>(__builtin_ctzll(word));
+                            word &= word - 1;
+                            if (data[i] == data[i]) take(data[i]);   // skips NaN
+                        }
+                    }
+                    ++scanned;
+                }
+            }
+            count_blocks(scanned, skipped, answered);
+
+            if (!found) return std::nullopt;
+            return static_cast<double>(best);
+        }
+    }
+}
+
+nr::Column::Column(ColumnType type) : kind(type) {}
+
+nr::Column::Column(const Column& other)
+    : kind(other.kind), ints(other.ints), doubles(other.doubles), bools(other.bools),
+      strings(other.strings), views(other.views), buffer(other.buffer), codes(other.codes),
+      valid_bits(other.valid_bits), missing_count(other.missing_count),
+      int_zones(other.int_zones), double_zones(other.double_zones)
+{
+    // lookup keys view the source's dictionary entries
+    rebuild_lookup();
+}
+
+nr::Column& nr::Column::operator=(const Column& other)
+{
+    if (this != &other) {
+        Column copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+nr::Column nr::Column::from_strings(const std::vector<std::string>& cells, ColumnType type)
+{
+    Column col(type);
+    col.reserve(cells.size());
+    for (const auto& cell : cells)
+        col.push_back(cell);
+    return col;
+}
+
+nr::Column nr::Column::from_views(const std::vector<std::string_view>& cells, ColumnType type,
+                                  std::shared_ptr<const void> buffer)
+{
+    Column col(type);
+    if (type == ColumnType::string) {
+        col.views = cells;
+        col.buffer = buffer ? std::move(buffer) : std::make_shared<const std::string>();
+        return col;
+    }
+
+    col.reserve(cells.size());
+    for (std::string_view cell : cells)
+        col.push_back(cell);
+    return col;
+}
+
+template <typename T>
+void nr::Column::adopt_validity(std::vector<T>& values, Bitmap validity)
+{
+    if (validity.empty()) return;
+    if (validity.size() != values.size())
+        throw std::invalid_argument("Column::from_values: validity size does not match value count");
+
+    // Missing slots hold zero, and the bitmap is only kept while something is missing
+    missing_count = values.size() - validity.count();
+    if (missing_count == 0) return;
+    for (size_type i = 0; i < values.size(); ++i)
+        if (!validity.test(i)) values[i] = T{};
+    valid_bits = std::move(validity);
+}
+
+nr::Column nr::Column::from_values(std::vector<std::int64_t> values, Bitmap validity)
+{
+    Column col(ColumnType::int64);
+    col.adopt_validity(values, std::move(validity));
+    col.ints = std::move(values);
+    col.rebuild_zones();
+    return col;
+}
+
+nr::Column nr::Column::from_values(std::vector<double> values, Bitmap validity)
+{
+    Column col(ColumnType::float64);
+    col.adopt_validity(values, std::move(validity));
+    col.doubles = std::move(values);
+    col.rebuild_zones();
+    return col;
+}
+
+nr::Column nr::Column::from_values(std::vector<std::uint8_t> values, Bitmap validity)
+{
+    Column col(ColumnType::boolean);
+    for (std::uint8_t& v : values) v = v != 0;
+    col.adopt_validity(values, std::move(validity));
+    col.bools = std::move(values);
+    return col;
+}
+
+nr::Column nr::Column::from_values(std::vector<std::string> values)
+{
+    Column col(ColumnType::string);
+    col.strings = std::move(values);
+    return col;
+}
+
+nr::ColumnType nr::Column::infer(const std::vector<std::string>& cells, size_type sample_rows)
+{
+    size_type limit = std::min(sample_rows, cells.size());
+    return infer(std::vector<std::string_view>(cells.begin(), cells.begin() + limit), limit);
+}
+
+nr::ColumnType nr::Column::infer(const std::vector<std::string_view>& cells, size_type sample_rows)
+{
+    bool can_int = true;
+    bool can_double = true;
+    bool can_bool = true;
+    size_type seen = 0;
+    std::unordered_set<std::string_view> distinct;
+
+    size_type limit = std::min(sample_rows, cells.size());
+    for (size_type i = 0; i < limit; ++i)
+    {
+        std::string_view cell = cells[i];
+        if (cell.empty()) continue;   // missing values fit every type
+        ++seen;
+
+        std::int64_t iv;
+        double dv;
+        bool bv;
+        if (can_int && !detail::parse_integer(cell, iv)) can_int = false;
+        if (can_double && !can_int && !detail::parse_floating(cell, dv)) can_double = false;
+        if (can_bool && !detail::parse_bool(cell, bv)) can_bool = false;
+
+        // Text: count distinct values while the column still looks categorical
+        if (!can_int && !can_double && !can_bool && distinct.size() * 2 <= limit)
+            distinct.insert(cell);
+    }
+
+    if (seen == 0) return ColumnType::string;
+    if (can_int) return ColumnType::int64;
+    if (can_double) return ColumnType::float64;
+    if (can_bool) return ColumnType::boolean;
+    return distinct.size() * 2 <= seen ? ColumnType::dictionary : ColumnType::string;
+}
+
+nr::ColumnType nr::Column::infer_cell(std::string_view cell)
+{
+    return infer(std::vector<std::string_view>{cell}, 1);
+}
+
+nr::ColumnType nr::Column::common_type(ColumnType a, ColumnType b) noexcept
+{
+    if (a == b) return a;
+    if ((a == ColumnType::int64 && b == ColumnType::float64) ||
+        (a == ColumnType::float64 && b == ColumnType::int64))
+        return ColumnType::float64;
+    return ColumnType::string;
+}
+
+bool nr::Column::accepts(std::string_view cell) const
+{
+    if (cell.empty()) return true;
+
+    std::int64_t iv;
+    double dv;
+    bool bv;
+    switch (kind) {
+        case ColumnType::int64:   return detail::parse_integer(cell, iv);
+        case ColumnType::float64: return detail::parse_floating(cell, dv);
+        case ColumnType::boolean: return detail::parse_bool(cell, bv);
+        case ColumnType::string:
+        case ColumnType::dictionary: return true;
+    }
+    return false;
+}
+
+nr::ColumnType nr::Column::type() const noexcept
+{
+    return kind;
+}
+
+nr::Column::size_type nr::Column::size() const noexcept
+{
+    switch (kind) {
+        case ColumnType::int64:   return ints.size();
+        case ColumnType::float64: return doubles.size();
+        case ColumnType::boolean: return bools.size();
+        case ColumnType::string:  return buffer ? views.size() : strings.size();
+        case ColumnType::dictionary: return codes.size();
+    }
+    return 0;
+}
+
+bool nr::Column::empty() const noexcept
+{
+    return size() == 0;
+}
+
+void nr::Column::reserve(size_type n)
+{
+    switch (kind) {
+        case ColumnType::int64:   ints.reserve(n); break;
+        case ColumnType::float64: doubles.reserve(n); break;
+        case ColumnType::boolean: bools.reserve(n); break;
+        case ColumnType::string:
+            if (buffer) views.reserve(n); else strings.reserve(n);
+            break;
+        case ColumnType::dictionary: codes.reserve(n); break;
+    }
+    if (!valid_bits.empty()) valid_bits.reserve(n);
+}
+
+nr::Column::size_type nr::Column::capacity() const noexcept
+{
+    switch (kind) {
+        case ColumnType::int64:   return ints.capacity();
+        case ColumnType::float64: return doubles.capacity();
+        case ColumnType::boolean: return bools.capacity();
+        case ColumnType::string:  return buffer ? views.capacity() : strings.capacity();
+        case ColumnType::dictionary: return codes.capacity();
+    }
+    return 0;
+}
+
+void nr::Column::clear() noexcept
+{
+    ints.clear();
+    doubles.clear();
+    bools.clear();
+    strings.clear();
+    views.clear();
+    buffer.reset();
+    codes.clear();
+    lookup.clear();
+    valid_bits.clear();
+    missing_count = 0;
+    int_zones.clear();
+    double_zones.clear();
+}
+
+void nr::Column::push_back(std::string_view cell)
+{
+    if (buffer) materialize();
+
+    if (cell.empty() && kind != ColumnType::string) {
+        push_na();
+        return;
+    }
+
+    bool ok = true;
+    switch (kind) {
+        case ColumnType::int64: {
+            std::int64_t v;
+            ok = detail::parse_integer(cell, v);
+            if (ok) {
+                ints.push_back(v);
+                int_zones.push_back(v);
+            }
+            break;
+        }
+        case ColumnType::float64: {
+            double v;
+            ok = detail::parse_floating(cell, v);
+            if (ok) {
+                doubles.push_back(v);
+                double_zones.push_back(v);
+            }
+            break;
+        }
+        case ColumnType::boolean: {
+            bool v;
+            ok = detail::parse_bool(cell, v);
+            if (ok) bools.push_back(v ? 1 : 0);
+            break;
+        }
+        case ColumnType::string:
+            strings.emplace_back(cell);
+            break;
+        case ColumnType::dictionary: {
+            auto it = lookup.find(cell);
+            if (it != lookup.end()) {
+                codes.push_back(it->second);
+                break;
+            }
+            if (strings.size() >= na_code)
+                throw std::length_error("Column: dictionary is full");
+
+            code_type code = static_cast<code_type>(strings.size());
+            size_type capacity = strings.capacity();
+            strings.emplace_back(cell);
+            // Growing the entry table moves the strings the keys point into
+            if (strings.capacity() != capacity)
+                rebuild_lookup();
+            else
+                lookup.emplace(strings.back(), code);
+            codes.push_back(code);
+            break;
+        }
+    }
+
+    if (!ok)
+        throw std::invalid_argument("Column: cannot store '" + std::string(cell) + "' as " + to_string(kind));
+    mark_valid();
+}
+
+void nr::Column::widen_to(ColumnType type)
+{
+    if (type == kind) return;
+
+    if (kind == ColumnType::int64 && type == ColumnType::float64)
+    {
+        doubles.assign(ints.begin(), ints.end());
+        ints.clear();
+        ints.shrink_to_fit();
+        kind = type;
+        rebuild_zones();
+        return;
+    }
+
+    if (kind == ColumnType::string && type == ColumnType::dictionary)
+    {
+        std::vector<std::string> owned = std::move(strings);
+        std::vector<std::string_view> cells = buffer ? std::move(views)
+                                                     : std::vector<std::string_view>(owned.begin(), owned.end());
+        std::shared_ptr<const void> keep = buffer;   // cells may view it
+
+        clear();
+        kind = type;
+        codes.reserve(cells.size());
+        for (std::string_view cell : cells)
+            push_back(cell);
+        return;
+    }
+
+    if (type == ColumnType::string)
+    {
+        // Blank cells are ordinary empty strings in a text column
+        std::vector<std::string> text;
+        text.reserve(size());
+        for (size_type i = 0; i < size(); ++i)
+            text.push_back(format(i));
+
+        clear();
+        strings = std::move(text);
+        kind = type;
+        return;
+    }
+
+    throw std::logic_error(std::string("Column::widen_to: cannot convert ") + to_string(kind) + " to " + to_string(type));
+}
+
+bool nr::Column::is_na(size_type index) const
+{
+    if (index >= size()) throw std::out_of_range("Column::is_na: index out of range");
+    return !valid_bits.empty() && !valid_bits[index];
+}
+
+nr::Column::size_type nr::Column::na_count() const noexcept
+{
+    return missing_count;
+}
+
+const nr::Bitmap& nr::Column::validity() const noexcept
+{
+    return valid_bits;
+}
+
+const std::vector<std::string>& nr::Column::dictionary() const
+{
+    if (kind != ColumnType::dictionary)
+        throw std::invalid_argument(std::string("Column::dictionary: column is stored as ") + to_string(kind));
+    return strings;
+}
+
+nr::Column::code_type nr::Column::find_code(std::string_view value) const
+{
+    auto it = lookup.find(value);
+    return it == lookup.end() ? na_code : it->second;
+}
+
+nr::Bitmap nr::Column::equal_to(std::string_view value) const
+{
+    const size_type n = size();
+    Bitmap mask(n, false);
+
+    // Fills the mask a word at a time from a per-row predicate
+    auto build = [&](auto match) {
+        for (size_type w = 0; w < mask.word_count(); ++w)
+        {
+            const size_type base = w * Bitmap::word_bits;
+            const size_type end = std::min(base + Bitmap::word_bits, n);
+            Bitmap::word_type word = 0;
+            for (size_type i = base; i < end; ++i)
+                word |= Bitmap::word_type{match(i)} << (i - base);
+            mask.set_word(w, word);
+        }
+    };
+
+    switch (kind) {
+        case ColumnType::int64: {
+            std::int64_t v;
+            if (detail::parse_integer(value, v)) build([&](size_type i) { return ints[i] == v; });
+            break;
+        }
+        case ColumnType::float64: {
+            double v;
+            if (detail::parse_floating(value, v)) build([&](size_type i) { return doubles[i] == v; });
+            break;
+        }
+        case ColumnType::boolean: {
+            bool v;
+            if (detail::parse_bool(value, v)) build([&](size_type i) { return bools[i] == (v ? 1 : 0); });
+            break;
+        }
+        case ColumnType::string:
+            build([&](size_type i) { return text(i) == value; });
+            break;
+        case ColumnType::dictionary: {
+            code_type code = find_code(value);
+            if (code != na_code) build([&](size_type i) { return codes[i] == code; });
+            break;
+        }
+    }
+
+    // Missing slots hold placeholder values that must not match
+    if (!valid_bits.empty())
+        mask &= valid_bits;
+    return mask;
+}
+
+nr::Bitmap nr::Column::compare(CompareOp op, double value) const
+{
+    const size_type n = size();
+    std::vector<Bitmap::word_type> words((n + Bitmap::word_bits - 1) / Bitmap::word_bits, 0);
+
+    // Result when the comparison holds for every row or for none
+    auto constant = [&](bool all) {
+        Bitmap mask(n, all);
+        if (all && !valid_bits.empty()) mask &= valid_bits;
+        return mask;
+    };
+
+    switch (kind) {
+        case ColumnType::float64:
+            detail::compare_zoned(doubles.data(), op, value, double_zones, words.data());
+            break;
+
+        case ColumnType::int64: {
+            // Map the threshold onto an integer one with the same result
+            constexpr double limit = 9223372036854775808.0;   // 2^63
+            if (std::isnan(value))
+                return constant(op == CompareOp::ne);
+            if (value >= limit)
+                return constant(op == CompareOp::ne || op == CompareOp::lt || op == CompareOp::le);
+            if (value < -limit)
+                return constant(op == CompareOp::ne || op == CompareOp::gt || op == CompareOp::ge);
+
+            double whole = std::floor(value);
+            if (whole != value) {
+                // No integer equals a fractional threshold: x < 2.5 is x <= 2, x > 2.5 is x >= 3
+                if (op == CompareOp::eq || op == CompareOp::ne) return constant(op == CompareOp::ne);
+                if (op == CompareOp::lt) op = CompareOp::le;
+                if (op == CompareOp::gt) { op = CompareOp::ge; whole += 1.0; }
+                if (op == CompareOp::ge && whole < value) whole += 1.0;
+            }
+            detail::compare_zoned(ints.data(), op, static_cast<std::int64_t>(whole), int_zones, words.data());
+            break;
+        }
+
+        case ColumnType::boolean: {
+            for (size_type i = 0; i < n; ++i)
+                if (detail::compare(static_cast<double>(bools[i]), op, value))
+                    words[i / Bitmap::word_bits] |= Bitmap::word_type{1} << (i % Bitmap::word_bits);
+            break;
+        }
+
+        case ColumnType::string:
+        case ColumnType::dictionary: {
+            // Text holding numbers: parse (once per entry for dictionaries), blank cells never match
+            auto matches = [&](std::string_view cell) {
+                if (cell.empty()) return false;
+                double number;
+                if (!detail::parse_floating(cell, number))
+                    throw std::invalid_argument("Column::compare: '" + std::string(cell) + "' is not a number");
+                return detail::compare(number, op, value);
+            };
+
+            if (kind == ColumnType::string) {
+                for (size_type i = 0; i < n; ++i)
+                    if (matches(text(i)))
+                        words[i / Bitmap::word_bits] |= Bitmap::word_type{1} << (i % Bitmap::word_bits);
+            } else {
+                std::vector<std::uint8_t> entry_matches(strings.size());
+                for (size_type c = 0; c < strings.size(); ++c)
+                    entry_matches[c] = matches(strings[c]);
+                for (size_type i = 0; i < n; ++i)
+                    if (codes[i] != na_code && entry_matches[codes[i]])
+                        words[i / Bitmap::word_bits] |= Bitmap::word_type{1} << (i % Bitmap::word_bits);
+            }
+            break;
+        }
+    }
+
+    Bitmap mask = Bitmap::from_words(std::move(words), n);
+    if (!valid_bits.empty())
+        mask &= valid_bits;
+    return mask;
+}
+
+nr::Bitmap nr::Column::compare(CompareOp op, std::string_view value) const
+{
+    const size_type n = size();
+
+    if (kind == ColumnType::int64 || kind == ColumnType::float64 || kind == ColumnType::boolean)
+    {
+        double number;
+        bool flag;
+        if (kind == ColumnType::boolean && detail::parse_bool(value, flag))
+            return compare(op, flag ? 1.0 : 0.0);
+        if (!detail::parse_floating(value, number))
+            throw std::invalid_argument("Column::compare: '" + std::string(value) + "' is not a number");
+        return compare(op, number);
+    }
+
+    if (op == CompareOp::eq)
+        return equal_to(value);
+
+    Bitmap mask(n, false);
+    if (kind == ColumnType::dictionary)
+    {
+        // Evaluate the predicate once per distinct value, then look it up per row
+        std::vector<std::uint8_t> matches(strings.size());
+        for (size_type c = 0; c < strings.size(); ++c)
+            matches[c] = detail::compare(std::string_view(strings[c]), op, value);
+
+        for (size_type w = 0; w < mask.word_count(); ++w)
+        {
+            const size_type base = w * Bitmap::word_bits;
+            const size_type end = std::min(base + Bitmap::word_bits, n);
+            Bitmap::word_type word = 0;
+            for (size_type i = base; i < end; ++i)
+                word |= Bitmap::word_type{codes[i] != na_code && matches[codes[i]]} << (i - base);
+            mask.set_word(w, word);
+        }
+    }
+    else
+    {
+        for (size_type i = 0; i < n; ++i)
+            if (detail::compare(text(i), op, value)) mask.set(i);
+    }
+
+    if (!valid_bits.empty())
+        mask &= valid_bits;
+    return mask;
+}
+
+std::optional<double> nr::Column::min() const
+{
+    return extremum<false>(nullptr);
+}
+
+std::optional<double> nr::Column::max() const
+{
+    return extremum<true>(nullptr);
+}
+
+std::optional<double> nr::Column::min(const Bitmap& selection) const
+{
+    return extremum<false>(&selection);
+}
+
+std::optional<double> nr::Column::max(const Bitmap& selection) const
+{
+    return extremum<true>(&selection);
+}
+
+template <bool Largest>
+std::optional<double> nr::Column::extremum(const Bitmap* selection) const
+{
+    const char* name = Largest ? "Column::max" : "Column::min";
+    if (kind != ColumnType::int64 && kind != ColumnType::float64)
+        throw std::invalid_argument(std::string(name) + ": column is stored as " + to_string(kind));
+    if (selection != nullptr && selection->size() != size())
+        throw std::invalid_argument(std::string(name) + ": selection size does not match the column");
+
+    if (kind == ColumnType::int64)
+        return detail::zoned_extremum<Largest>(ints, int_zones, valid_bits, selection);
+    return detail::zoned_extremum<Largest>(doubles, double_zones, valid_bits, selection);
+}
+
+nr::Bitmap nr::Column::present() const
+{
+    if (!valid_bits.empty()) return valid_bits;
+    return Bitmap(size(), true);
+}
+
+nr::Column nr::Column::slice(size_type begin, size_type end) const
+{
+    if (begin > end || end > size())
+        throw std::out_of_range("Column::slice: row range out of range");
+
+    auto copy = [&](const auto& src, auto& dst) {
+        dst.assign(src.begin() + static_cast<std::ptrdiff_t>(begin), src.begin() + static_cast<std::ptrdiff_t>(end));
+    };
+
+    Column result(kind);
+    switch (kind) {
+        case ColumnType::int64:   copy(ints, result.ints); break;
+        case ColumnType::float64: copy(doubles, result.doubles); break;
+        case ColumnType::boolean: copy(bools, result.bools); break;
+        case ColumnType::string:
+            if (buffer) {
+                copy(views, result.views);
+                result.buffer = buffer;
+            } else {
+                copy(strings, result.strings);
+            }
+            break;
+        case ColumnType::dictionary:
+            result.strings = strings;
+            result.rebuild_lookup();
+            copy(codes, result.codes);
+            break;
+    }
+
+    if (missing_count != 0) {
+        Bitmap bits(end - begin, true);
+        for (size_type i = begin; i < end; ++i) {
+            if (!valid_bits.test(i)) {
+                bits.reset(i - begin);
+                ++result.missing_count;
+            }
+        }
+        if (result.missing_count != 0) result.valid_bits = std::move(bits);
+    }
+    result.rebuild_zones();
+    return result;
+}
+
+nr::Column nr::Column::gather(Span<const size_type> rows) const
+{
+    const size_type n = size();
+    for (size_type r : rows)
+        if (r >= n) throw std::out_of_range("Column::gather: row index out of range");
+
+    auto pick = [&](const auto& src, auto& dst) {
+        dst.reserve(rows.size());
+        for (size_type r : rows) dst.push_back(src[r]);
+    };
+
+    Column result(kind);
+    switch (kind) {
+        case ColumnType::int64:   pick(ints, result.ints); break;
+        case ColumnType::float64: pick(doubles, result.doubles); break;
+        case ColumnType::boolean: pick(bools, result.bools); break;
+        case ColumnType::string:
+            if (buffer) {
+                pick(views, result.views);
+                result.buffer = buffer;
+            } else {
+                pick(strings, result.strings);
+            }
+            break;
+        case ColumnType::dictionary:
+            result.strings = strings;
+            result.rebuild_lookup();
+            pick(codes, result.codes);
+            break;
+    }
+
+    if (missing_count != 0) {
+        Bitmap bits(rows.size(), true);
+        for (size_type i = 0; i < rows.size(); ++i) {
+            if (!valid_bits.test(rows[i])) {
+                bits.reset(i);
+                ++result.missing_count;
+            }
+        }
+        if (result.missing_count != 0) result.valid_bits = std::move(bits);
+    }
+    result.rebuild_zones();
+    return result;
+}
+
+std::string nr::Column::format(size_type index) const
+{
+    if (is_na(index)) return std::string();
+
+    switch (kind) {
+        case ColumnType::int64:   return std::to_string(ints[index]);
+        case ColumnType::float64: return detail::format_double(doubles[index]);
+        case ColumnType::boolean: return bools[index] ? "true" : "false";
+        case ColumnType::string:  return std::string(text(index));
+        case ColumnType::dictionary: return strings[codes[index]];
+    }
+    return std::string();
+}
+
+std::string_view nr::Column::text(size_type index) const
+{
+    if (kind != ColumnType::string)
+        throw std::invalid_argument(std::string("Column::text: column is stored as ") + to_string(kind));
+    return buffer ? views[index] : std::string_view(strings[index]);
+}
+
+bool nr::Column::borrowed() const noexcept
+{
+    return buffer != nullptr;
+}
+
+void nr::Column::push_na()
+{
+    // Materialize the validity bitmap on the first missing value
+    if (valid_bits.empty())
+        valid_bits.resize(size(), true);
+
+    switch (kind) {
+        case ColumnType::int64:
+            ints.push_back(0);
+            int_zones.push_na();
+            break;
+        case ColumnType::float64:
+            doubles.push_back(0.0);
+            double_zones.push_na();
+            break;
+        case ColumnType::boolean: bools.push_back(0); break;
+        case ColumnType::string:  strings.emplace_back(); break;
+        case ColumnType::dictionary: codes.push_back(na_code); break;
+    }
+    valid_bits.push_back(false);
+    ++missing_count;
+}
+
+void nr::Column::mark_valid()
+{
+    if (!valid_bits.empty())
+        valid_bits.push_back(true);
+}
+
+void nr::Column::materialize()
+{
+    // Copy borrowed text into owned strings before the column is modified
+    strings.assign(views.begin(), views.end());
+    views.clear();
+    views.shrink_to_fit();
+    buffer.reset();
+}
+
+void nr::Column::rebuild_zones()
+{
+    int_zones.clear();
+    double_zones.clear();
+    if (kind == ColumnType::int64)
+        int_zones = ZoneMap<std::int64_t>::build(ints, valid_bits);
+    else if (kind == ColumnType::float64)
+        double_zones = ZoneMap<double>::build(doubles, valid_bits);
+}
+
+void nr::Column::rebuild_lookup()
+{
+    lookup.clear();
+    if (kind != ColumnType::dictionary) return;
+
+    lookup.reserve(strings.size());
+    for (size_type i = 0; i < strings.size(); ++i)
+        lookup.emplace(strings[i], static_cast<code_type>(i));
+}
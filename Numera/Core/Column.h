@@ -0,0 +1,236 @@
+#ifndef NUMERA_CORE_COLUMN_H
+#define NUMERA_CORE_COLUMN_H
+#include "Core/Bitmap.h"
+#include "Core/SimdCompare.h"
+#include "Core/Span.h"
+#include "Core/ZoneMap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief A typed, contiguous column of table cells.
+ *
+ * Column stores the cells of one CSVTable column in their native
+ * representation: 64-bit integers and doubles take 8 bytes per cell,
+ * booleans one byte, and only genuinely textual columns keep a
+ * std::string per cell. Low-cardinality text (region, status, label)
+ * is dictionary-encoded: each distinct value is stored once and cells
+ * hold 32-bit codes into that dictionary, so equality tests and
+ * grouping compare integers. Typed buffers can be viewed without
+ * copying or parsing through view<T>().
+ *
+ * Blank cells in non-string columns are missing values (NA): the slot
+ * holds a zero value and its bit in validity() is cleared. The bitmap
+ * stays empty while the column has no missing values.
+ *
+ * A string column can also borrow its text: from_views() keeps
+ * std::string_view cells into a shared buffer (e.g. the mapped input
+ * file) instead of allocating one std::string per cell. Appending to
+ * such a column copies its text out first.
+ *
+ * The storage type is either inferred from a sample of the raw cells
+ * (infer()) or chosen explicitly by the caller.
+ *
+ * int64 and float64 columns keep a ZoneMap (min/max per block of rows)
+ * up to date as cells are appended. compare() skips blocks whose zone
+ * rules out every cell and fills blocks whose zone admits every cell
+ * without reading them; min() and max() combine zones instead of
+ * scanning. Both report their blocks through scan_counters().
+ */
+
+namespace nr
+{
+    enum class ColumnType
+    {
+        int64,      // std::int64_t
+        float64,    // double
+        boolean,    // "true" / "false", stored as std::uint8_t
+        string,     // std::string
+        dictionary  // std::uint32_t codes into a table of distinct strings
+    };
+
+    /// Human-readable name of a column type (e.g. for error messages)
+    const char* to_string(ColumnType type) noexcept;
+
+    class Column
+    {
+    public:
+        using size_type = std::size_t;
+        using code_type = std::uint32_t;
+
+        /// Code of a missing value in a dictionary column
+        static constexpr code_type na_code = ~code_type{0};
+
+        Column() = default;
+        explicit Column(ColumnType type);
+        Column(const Column& other);
+        Column(Column&&) = default;
+        Column& operator=(const Column& other);
+        Column& operator=(Column&&) = default;
+
+        /// Parse raw cells into a column of the given type (throws std::invalid_argument on a bad cell)
+        static Column from_strings(const std::vector<std::string>& cells, ColumnType type);
+
+        /// Like from_strings, but a string column keeps the views and shares ownership
+        /// of whatever owns the bytes they point into instead of copying the text
+        static Column from_views(const std::vector<std::string_view>& cells, ColumnType type,
+                                 std::shared_ptr<const void> buffer);
+
+        /// Column over computed values; cells whose bit is cleared in validity are
+        /// missing (an empty validity means none are)
+        static Column from_values(std::vector<std::int64_t> values, Bitmap validity = Bitmap());
+        static Column from_values(std::vector<double> values, Bitmap validity = Bitmap());
+        static Column from_values(std::vector<std::uint8_t> values, Bitmap validity = Bitmap());   // boolean
+
+        /// String column taking over owned text (text cells are never missing)
+        static Column from_values(std::vector<std::string> values);
+
+        /// Narrowest type that can hold the first sample_rows cells (blank cells are ignored).
+        /// Text where at most half of the sampled cells are distinct is inferred as dictionary.
+        static ColumnType infer(const std::vector<std::string_view>& cells, size_type sample_rows);
+        static ColumnType infer(const std::vector<std::string>& cells, size_type sample_rows);
+
+        /// Narrowest type that can hold a single cell (string for blanks)
+        static ColumnType infer_cell(std::string_view cell);
+
+        /// Narrowest type that can hold values of both types
+        static ColumnType common_type(ColumnType a, ColumnType b) noexcept;
+
+        /// Check if a raw cell can be stored without changing the column type
+        bool accepts(std::string_view cell) const;
+
+        ColumnType type() const noexcept;
+        size_type size() const noexcept;
+        bool empty() const noexcept;
+        void reserve(size_type n);
+        size_type capacity() const noexcept;
+        void clear() noexcept;
+
+        /// Append a raw cell, parsing it into the column type (throws if it does not fit)
+        void push_back(std::string_view cell);
+
+        /// Convert the stored values to a wider type (int64 -> float64, anything -> string,
+        /// string <-> dictionary)
+        void widen_to(ColumnType type);
+
+        /// Missing values
+        bool is_na(size_type index) const;
+        size_type na_count() const noexcept;
+        const Bitmap& validity() const noexcept;
+
+        /// Cell formatted as text (blank for NA); numbers round-trip exactly
+        std::string format(size_type index) const;
+
+        /// Text of a string column cell without copying
+        std::string_view text(size_type index) const;
+
+        /// Check if a string column references a shared buffer instead of owning its text
+        bool borrowed() const noexcept;
+
+        /// Distinct values of a dictionary column, indexed by code
+        const std::vector<std::string>& dictionary() const;
+
+        /// Code of a dictionary value, na_code if the value does not occur
+        code_type find_code(std::string_view value) const;
+
+        /// Rows whose cell equals value (missing cells never match). Dictionary
+        /// columns resolve the value once and compare codes.
+        Bitmap equal_to(std::string_view value) const;
+
+        /// Rows where (cell op value) holds, evaluated with the SIMD kernels for
+        /// int64 and float64 columns. Missing cells never match. Text columns are
+        /// parsed (blank cells never match, other non-numbers throw).
+        Bitmap compare(CompareOp op, double value) const;
+
+        /// Text comparison (lexicographic) for string and dictionary columns,
+        /// dictionary entries are compared once and rows by code. Numeric
+        /// columns parse value and compare numerically.
+        Bitmap compare(CompareOp op, std::string_view value) const;
+
+        /// Smallest / largest present value of an int64 or float64 column (NaN is
+        /// ignored), empty if there is none. With a selection (one bit per row) only
+        /// selected rows count. Whole blocks are answered from the zone map.
+        std::optional<double> min() const;
+        std::optional<double> max() const;
+        std::optional<double> min(const Bitmap& selection) const;
+        std::optional<double> max(const Bitmap& selection) const;
+
+        /// Bit set for every present cell (also when the column has no missing values)
+        Bitmap present() const;
+
+        /// New column holding the cells [begin, end); borrowed text keeps sharing its buffer
+        Column slice(size_type begin, size_type end) const;
+
+        /// New column holding the cells at rows, in that order (rows may repeat).
+        /// Dictionary entries are kept, borrowed text keeps sharing its buffer.
+        Column gather(Span<const size_type> rows) const;
+
+        /// Zero-copy view of the stored values; T must match the storage type
+        /// (std::int64_t, double, std::uint8_t for boolean, std::string or
+        /// std::string_view when borrowed(), code_type for dictionary)
+        template <typename T>
+        Span<const T> view() const;
+
+    private:
+        void push_na();
+        void mark_valid();
+        void materialize();
+        void rebuild_lookup();
+        template <typename T>
+        void adopt_validity(std::vector<T>& values, Bitmap validity);
+        void rebuild_zones();
+        template <bool Largest>
+        std::optional<double> extremum(const Bitmap* selection) const;
+
+        ColumnType kind = ColumnType::string;
+        std::vector<std::int64_t> ints;
+        std::vector<double> doubles;
+        std::vector<std::uint8_t> bools;
+        std::vector<std::string> strings;   // text cells, or the dictionary entries
+        std::vector<std::string_view> views;            // borrowed text cells
+        std::shared_ptr<const void> buffer;     // keeps the borrowed text alive
+        std::vector<code_type> codes;
+        std::unordered_map<std::string_view, code_type> lookup;   // dictionary entry -> code, keys view strings
+        Bitmap valid_bits;         // empty while there are no missing values
+        size_type missing_count = 0;
+        ZoneMap<std::int64_t> int_zones;    // blocks of an int64 column
+        ZoneMap<double> double_zones;       // blocks of a float64 column
+    };
+
+    namespace detail
+    {
+        // Shortest text that parses back to the same double
+        std::string format_double(double value);
+    }
+
+    template <typename T>
+    inline Span<const T> Column::view() const
+    {
+        if constexpr (std::is_same_v<T, std::int64_t>) {
+            if (kind == ColumnType::int64) return Span<const T>(ints);
+        } else if constexpr (std::is_same_v<T, double>) {
+            if (kind == ColumnType::float64) return Span<const T>(doubles);
+        } else if constexpr (std::is_same_v<T, std::uint8_t>) {
+            if (kind == ColumnType::boolean) return Span<const T>(bools);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            if (kind == ColumnType::string && !buffer) return Span<const T>(strings);
+        } else if constexpr (std::is_same_v<T, std::string_view>) {
+            if (kind == ColumnType::string && buffer) return Span<const T>(views);
+        } else if constexpr (std::is_same_v<T, code_type>) {
+            if (kind == ColumnType::dictionary) return Span<const T>(codes);
+        }
+        throw std::invalid_argument(std::string("Column::view: column is stored as ") + to_string(kind) +
+                                    (buffer ? " (borrowed)" : ""));
+    }
+}
+
+#endif // NUMERA_CORE_COLUMN_H
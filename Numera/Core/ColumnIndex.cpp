@@ -0,0 +1,491 @@
+#include "ColumnIndex.h"
+#include "NumericParse.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace nr
+{
+    namespace detail
+    {
+        static const std::uint64_t* present_words(const Column& col) noexcept
+        {
+            return col.validity().empty() ? nullptr : col.validity().words().data();
+        }
+
+        static bool present_at(const std::uint64_t* words, std::size_t row) noexcept
+        {
+            return words == nullptr || ((words[row >> 6] >> (row & 63)) & 1);
+        }
+
+        static std::uint64_t double_word(double v) noexcept
+        {
+            if (v == 0.0) v = 0.0;   // -0.0 == 0.0
+            std::uint64_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            return bits;
+        }
+
+        // 64-bit word identifying the key of a present cell; false for NaN, which equals nothing.
+        // Text keys are identified by their hash (the key map resolves collisions).
+        static bool key_word(const Column& col, std::size_t row, std::uint64_t& word)
+        {
+            switch (col.type()) {
+                case ColumnType::int64:
+                    word = static_cast<std::uint64_t>(col.view<std::int64_t>()[row]);
+                    return true;
+                case ColumnType::float64: {
+                    double v = col.view<double>()[row];
+                    if (std::isnan(v)) return false;
+                    word = double_word(v);
+                    return true;
+                }
+                case ColumnType::boolean:
+                    word = col.view<std::uint8_t>()[row];
+                    return true;
+                case ColumnType::dictionary:
+                    word = col.view<Column::code_type>()[row];
+                    return true;
+                case ColumnType::string:
+                    word = std::hash<std::string_view>{}(col.text(row));
+                    return true;
+            }
+            return false;
+        }
+
+        // Sorts (key, row) pairs: chunks on separate threads, then pairwise merges of the runs
+        template <typename K>
+        static void parallel_sort(std::vector<std::pair<K, std::size_t>>& pairs, std::size_t threads)
+        {
+            const std::size_t n = pairs.size();
+            threads = worker_count(threads, n);
+
+            std::vector<std::size_t> bounds;
+            for (std::size_t t = 0; t < threads; ++t) bounds.push_back(n * t / threads);
+            bounds.push_back(n);
+
+            parallel_tasks(threads, [&](std::size_t t) {
+                std::sort(pairs.begin() + bounds[t], pairs.begin() + bounds[t + 1]);
+            });
+
+            while (bounds.size() > 2) {
+                const std::size_t merges = (bounds.size() - 1) / 2;
+                parallel_tasks(merges, [&](std::size_t m) {
+                    std::inplace_merge(pairs.begin() + bounds[2 * m], pairs.begin() + bounds[2 * m + 1],
+                                       pairs.begin() + bounds[2 * m + 2]);
+                });
+
+                std::vector<std::size_t> merged;
+                for (std::size_t i = 0; i < bounds.size(); i += 2) merged.push_back(bounds[i]);
+                if (merged.back() != n) merged.push_back(n);
+                bounds.swap(merged);
+            }
+        }
+
+        template <typename K>
+        static void split_pairs(std::vector<std::pair<K, std::size_t>>& pairs, std::vector<K>& keys,
+                                std::vector<std::size_t>& rows)
+        {
+            keys.reserve(pairs.size());
+            rows.reserve(pairs.size());
+            for (auto& p : pairs) {
+                keys.push_back(std::move(p.first));
+                rows.push_back(p.second);
+            }
+        }
+
+        // Merges sorted extra pairs (rows after every indexed row) into keys/rows
+        template <typename K>
+        static void merge_into(std::vector<K>& keys, std::vector<std::size_t>& rows,
+                               std::vector<std::pair<K, std::size_t>>& extra)
+        {
+            std::sort(extra.begin(), extra.end());
+
+            std::vector<K> merged_keys;
+            std::vector<std::size_t> merged_rows;
+            merged_keys.reserve(keys.size() + extra.size());
+            merged_rows.reserve(keys.size() + extra.size());
+
+            std::size_t i = 0, j = 0;
+            while (i < keys.size() || j < extra.size()) {
+                // Equal keys: the indexed row comes first, it is the smaller row
+                if (j == extra.size() || (i < keys.size() && !(extra[j].first < keys[i]))) {
+                    merged_keys.push_back(std::move(keys[i]));
+                    merged_rows.push_back(rows[i++]);
+                } else {
+                    merged_keys.push_back(std::move(extra[j].first));
+                    merged_rows.push_back(extra[j++].second);
+                }
+            }
+            keys.swap(merged_keys);
+            rows.swap(merged_rows);
+        }
+
+        // First position whose key is not before(key). Interpolation steps alternate with
+        // bisection steps, so skewed keys cost at most twice a binary search.
+        template <typename T, typename Before>
+        static std::size_t interpolation_search(const std::vector<T>& keys, double x, Before before)
+        {
+            std::size_t lo = 0, hi = keys.size();
+            bool interpolate = true;
+            while (hi - lo > 16) {
+                if (!before(keys[lo])) return lo;
+                if (before(keys[hi - 1])) return hi;
+
+                std::size_t mid = lo + (hi - lo) / 2;
+                if (interpolate) {
+                    const double a = static_cast<double>(keys[lo]);
+                    const double b = static_cast<double>(keys[hi - 1]);
+                    const double f = (x - a) / (b - a);
+                    if (b > a && std::isfinite(f))
+                        mid = lo + static_cast<std::size_t>(std::clamp(f, 0.0, 1.0) * static_cast<double>(hi - 1 - lo));
+                }
+                interpolate = !interpolate;
+
+                if (before(keys[mid])) lo = mid + 1;
+                else hi = mid;
+            }
+            while (lo < hi && before(keys[lo])) ++lo;
+            return lo;
+        }
+
+        // Text of a present string or dictionary cell
+        static std::string_view text_key(const Column& col, std::size_t row)
+        {
+            if (col.type() == ColumnType::dictionary)
+                return col.dictionary()[col.view<Column::code_type>()[row]];
+            return col.text(row);
+        }
+    }
+}
+
+// ---- HashIndex ----
+
+nr::HashIndex nr::HashIndex::build(const Column &col, size_type threads)
+{
+    const size_type n = col.size();
+    threads = detail::worker_count(threads, n);
+
+    HashIndex index;
+    index.kind = col.type();
+    while ((size_type{1} << index.partition_bits) < threads) ++index.partition_bits;
+    index.partitions.resize(size_type{1} << index.partition_bits);
+    index.next.assign(n, npos);
+
+    // Key words of all rows in parallel; 0 in keep marks missing and NaN cells
+    const std::uint64_t* valid = detail::present_words(col);
+    std::vector<std::uint64_t> words(n);
+    std::vector<std::uint8_t> keep(n, 0);
+    detail::parallel_chunks(n, threads, [&](size_type begin, size_type end, size_type) {
+        for (size_type row = begin; row < end; ++row)
+            keep[row] = detail::present_at(valid, row) && detail::key_word(col, row, words[row]);
+    });
+
+    // One thread per partition, each takes the rows whose hash falls into it
+    detail::parallel_tasks(index.partitions.size(), [&](size_type p) {
+        Partition& part = index.partitions[p];
+        for (size_type row = 0; row < n; ++row)
+            if (keep[row] && index.partition_of(detail::mix_hash(words[row])) == p)
+                index.insert(part, col, row, words[row]);
+    });
+    return index;
+}
+
+void nr::HashIndex::append(const Column &col, size_type row)
+{
+    if (row != next.size() || row >= col.size())
+        throw std::logic_error("HashIndex::append: rows must be appended in order");
+    if (partitions.empty()) partitions.resize(1);
+
+    next.push_back(npos);
+    std::uint64_t word;
+    if (col.is_na(row) || !detail::key_word(col, row, word)) return;
+    insert(partitions[partition_of(detail::mix_hash(word))], col, row, word);
+}
+
+nr::HashIndex::size_type nr::HashIndex::size() const noexcept
+{
+    return next.size();
+}
+
+nr::ColumnType nr::HashIndex::type() const noexcept
+{
+    return kind;
+}
+
+nr::Bitmap nr::HashIndex::lookup(const Column &col, std::string_view key) const
+{
+    if (col.size() != next.size() || col.type() != kind)
+        throw std::logic_error("HashIndex::lookup: column changed since the index was built");
+
+    Bitmap result(col.size());
+    if (partitions.empty()) return result;
+
+    // Same parsing as Column::equal_to: a key that cannot occur selects nothing
+    std::uint64_t word = 0;
+    switch (kind) {
+        case ColumnType::int64: {
+            std::int64_t v;
+            if (!detail::parse_integer(key, v)) return result;
+            word = static_cast<std::uint64_t>(v);
+            break;
+        }
+        case ColumnType::float64: {
+            double v;
+            if (!detail::parse_floating(key, v) || std::isnan(v)) return result;
+            word = detail::double_word(v);
+            break;
+        }
+        case ColumnType::boolean: {
+            bool v;
+            if (!detail::parse_bool(key, v)) return result;
+            word = v ? 1 : 0;
+            break;
+        }
+        case ColumnType::dictionary: {
+            Column::code_type code = col.find_code(key);
+            if (code == Column::na_code) return result;
+            word = code;
+            break;
+        }
+        case ColumnType::string:
+            word = std::hash<std::string_view>{}(key);
+            break;
+    }
+
+    const Partition& part = partitions[partition_of(detail::mix_hash(word))];
+    size_type id = npos;
+    if (kind == ColumnType::string) {
+        auto it = part.text.find(std::string(key));
+        if (it != part.text.end()) id = it->second;
+    } else {
+        id = part.words.find(word);
+    }
+    if (id == npos) return result;
+
+    for (size_type row = part.head[id]; row != npos; row = next[row])
+        result.set(row);
+    return result;
+}
+
+void nr::HashIndex::insert(Partition &part, const Column &col, size_type row, std::uint64_t word)
+{
+    size_type id;
+    if (kind == ColumnType::string)
+        id = part.text.emplace(std::string(col.text(row)), part.head.size()).first->second;
+    else
+        id = part.words.insert(word);
+
+    if (id == part.head.size()) {
+        part.head.push_back(row);
+        part.tail.push_back(row);
+    } else {
+        next[part.tail[id]] = row;
+        part.tail[id] = row;
+    }
+}
+
+nr::HashIndex::size_type nr::HashIndex::partition_of(std::uint64_t hash) const noexcept
+{
+    return partition_bits == 0 ? 0 : static_cast<size_type>(hash >> (64 - partition_bits));
+}
+
+// ---- SortedIndex ----
+
+nr::SortedIndex nr::SortedIndex::build(const Column &col, size_type threads)
+{
+    const size_type n = col.size();
+    const std::uint64_t* valid = detail::present_words(col);
+
+    SortedIndex index;
+    index.kind = col.type();
+    index.covered = n;
+
+    switch (index.kind) {
+        case ColumnType::int64:
+        case ColumnType::boolean: {
+            std::vector<std::pair<std::int64_t, size_type>> pairs;
+            pairs.reserve(n);
+            for (size_type row = 0; row < n; ++row) {
+                if (!detail::present_at(valid, row)) continue;
+                std::int64_t v = index.kind == ColumnType::int64 ? col.view<std::int64_t>()[row]
+                                                                 : col.view<std::uint8_t>()[row];
+                pairs.emplace_back(v, row);
+            }
+            detail::parallel_sort(pairs, threads);
+            detail::split_pairs(pairs, index.ints, index.order);
+            break;
+        }
+        case ColumnType::float64: {
+            auto values = col.view<double>();
+            std::vector<std::pair<double, size_type>> pairs;
+            pairs.reserve(n);
+            for (size_type row = 0; row < n; ++row)
+                if (detail::present_at(valid, row) && !std::isnan(values[row])) pairs.emplace_back(values[row], row);
+            detail::parallel_sort(pairs, threads);
+            detail::split_pairs(pairs, index.doubles, index.order);
+            break;
+        }
+        case ColumnType::string:
+        case ColumnType::dictionary: {
+            std::vector<std::pair<std::string_view, size_type>> pairs;
+            pairs.reserve(n);
+            for (size_type row = 0; row < n; ++row)
+                if (detail::present_at(valid, row)) pairs.emplace_back(detail::text_key(col, row), row);
+            detail::parallel_sort(pairs, threads);
+
+            index.texts.reserve(pairs.size());
+            index.order.reserve(pairs.size());
+            for (const auto& p : pairs) {
+                index.texts.emplace_back(p.first);
+                index.order.push_back(p.second);
+            }
+            break;
+        }
+    }
+    return index;
+}
+
+void nr::SortedIndex::append(const Column &col, size_type row)
+{
+    if (row != covered || row >= col.size())
+        throw std::logic_error("SortedIndex::append: rows must be appended in order");
+
+    ++covered;
+    pending.push_back(row);
+    if (pending.size() > std::max<size_type>(1024, order.size() / 8))
+        merge_pending(col);
+}
+
+nr::SortedIndex::size_type nr::SortedIndex::size() const noexcept
+{
+    return covered;
+}
+
+nr::ColumnType nr::SortedIndex::type() const noexcept
+{
+    return kind;
+}
+
+nr::Bitmap nr::SortedIndex::range(const Column &col, double lo, double hi) const
+{
+    if (col.size() != covered || col.type() != kind)
+        throw std::logic_error("SortedIndex::range: column changed since the index was built");
+    if (kind == ColumnType::string || kind == ColumnType::dictionary)
+        throw std::invalid_argument("SortedIndex::range: numeric bounds on a text column");
+
+    Bitmap result(covered);
+    if (!(lo <= hi)) return result;   // also NaN bounds
+
+    size_type first = 0, last = 0;
+    std::function<bool(size_type)> in_range;   // check for the pending rows
+
+    if (kind == ColumnType::float64) {
+        first = detail::interpolation_search(doubles, lo, [&](double k) { return k < lo; });
+        last = detail::interpolation_search(doubles, hi, [&](double k) { return k <= hi; });
+        auto values = col.view<double>();
+        in_range = [values, lo, hi](size_type row) { return values[row] >= lo && values[row] <= hi; };
+    } else {
+        // Integer keys: the bounds become the integers they enclose
+        constexpr double limit = 9223372036854775808.0;    // 2^63
+        if (lo >= limit || hi < -limit) return result;
+        const std::int64_t lo_i = lo <= -limit ? std::numeric_limits<std::int64_t>::min()
+                                               : static_cast<std::int64_t>(std::ceil(lo));
+        const std::int64_t hi_i = hi >= limit ? std::numeric_limits<std::int64_t>::max()
+                                              : static_cast<std::int64_t>(std::floor(hi));
+        if (lo_i > hi_i) return result;
+
+        first = detail::interpolation_search(ints, static_cast<double>(lo_i), [&](std::int64_t k) { return k < lo_i; });
+        last = detail::interpolation_search(ints, static_cast<double>(hi_i), [&](std::int64_t k) { return k <= hi_i; });
+        if (kind == ColumnType::int64) {
+            auto values = col.view<std::int64_t>();
+            in_range = [values, lo_i, hi_i](size_type row) { return values[row] >= lo_i && values[row] <= hi_i; };
+        } else {
+            auto values = col.view<std::uint8_t>();
+            in_range = [values, lo_i, hi_i](size_type row) { return values[row] >= lo_i && values[row] <= hi_i; };
+        }
+    }
+
+    for (size_type i = first; i < last; ++i) result.set(order[i]);
+    for (size_type row : pending)
+        if (!col.is_na(row) && in_range(row)) result.set(row);
+    return result;
+}
+
+nr::Bitmap nr::SortedIndex::range(const Column &col, std::string_view lo, std::string_view hi) const
+{
+    if (kind != ColumnType::string && kind != ColumnType::dictionary)
+    {
+        // Numeric column: parse the bounds like Column::compare
+        auto number = [&](std::string_view s) {
+            double v;
+            bool flag;
+            if (kind == ColumnType::boolean && detail::parse_bool(s, flag)) return flag ? 1.0 : 0.0;
+            if (!detail::parse_floating(s, v))
+                throw std::invalid_argument("SortedIndex::range: '" + std::string(s) + "' is not a number");
+            return v;
+        };
+        return range(col, number(lo), number(hi));
+    }
+
+    if (col.size() != covered || col.type() != kind)
+        throw std::logic_error("SortedIndex::range: column changed since the index was built");
+
+    Bitmap result(covered);
+    if (hi < lo) return result;
+
+    auto first = std::lower_bound(texts.begin(), texts.end(), lo,
+                                  [](const std::string& k, std::string_view x) { return std::string_view(k) < x; });
+    auto last = std::upper_bound(texts.begin(), texts.end(), hi,
+                                 [](std::string_view x, const std::string& k) { return x < std::string_view(k); });
+    for (auto it = first; it != last; ++it)
+        result.set(order[static_cast<size_type>(it - texts.begin())]);
+
+    for (size_type row : pending) {
+        if (col.is_na(row)) continue;
+        std::string_view text = detail::text_key(col, row);
+        if (text >= lo && text <= hi) result.set(row);
+    }
+    return result;
+}
+
+void nr::SortedIndex::merge_pending(const Column &col)
+{
+    switch (kind) {
+        case ColumnType::int64:
+        case ColumnType::boolean: {
+            std::vector<std::pair<std::int64_t, size_type>> extra;
+            for (size_type row : pending) {
+                if (col.is_na(row)) continue;
+                std::int64_t v = kind == ColumnType::int64 ? col.view<std::int64_t>()[row] : col.view<std::uint8_t>()[row];
+                extra.emplace_back(v, row);
+            }
+            detail::merge_into(ints, order, extra);
+            break;
+        }
+        case ColumnType::float64: {
+            std::vector<std::pair<double, size_type>> extra;
+            for (size_type row : pending) {
+                double v = col.view<double>()[row];
+                if (!col.is_na(row) && !std::isnan(v)) extra.emplace_back(v, row);
+            }
+            detail::merge_into(doubles, order, extra);
+            break;
+        }
+        case ColumnType::string:
+        case ColumnType::dictionary: {
+            std::vector<std::pair<std::string, size_type>> extra;
+            for (size_type row : pending)
+                if (!col.is_na(row)) extra.emplace_back(std::string(detail::text_key(col, row)), row);
+            detail::merge_into(texts, order, extra);
+            break;
+        }
+    }
+    pending.clear();
+}
@@ -0,0 +1,126 @@
+#ifndef NUMERA_CORE_COLUMNINDEX_H
+#define NUMERA_CORE_COLUMNINDEX_H
+#include "Core/Bitmap.h"
+#include "Core/Column.h"
+#include "Core/Hashing.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Secondary indexes over a single Column.
+ *
+ * HashIndex answers equality lookups. SortedIndex answers inclusive
+ * range queries. Both return a row selection (Bitmap) with exactly the
+ * rows that a scan with Column::equal_to or Column::compare would
+ * select. Missing cells and NaN are never indexed.
+ *
+ * Both indexes are built in parallel:
+ * - HashIndex is partitioned by the top bits of the key hash. Every
+ *   partition has its own key map and is filled by its own thread, and
+ *   rows with equal keys are chained in row order.
+ * - SortedIndex sorts (key, row) pairs chunk by chunk on separate
+ *   threads and merges the runs pairwise. Numeric keys are searched by
+ *   interpolation (alternating with bisection, so the worst case stays
+ *   logarithmic).
+ *
+ * Rows appended to the column are added with append(). HashIndex
+ * inserts them directly. SortedIndex keeps them in a small unsorted
+ * tail that queries scan, and merges the tail into the sorted keys once
+ * it grows past a fraction of the index.
+ *
+ * An index stores its own copy of text keys. It does not refer to the
+ * column between calls, but every call must pass the column it was
+ * built from.
+ */
+
+namespace nr
+{
+    class HashIndex
+    {
+    public:
+        using size_type = std::size_t;
+
+        HashIndex() = default;
+
+        /// Index every row of col (threads = 0: hardware_concurrency())
+        static HashIndex build(const Column& col, size_type threads = 0);
+
+        /// Index row size(), which was just appended to col
+        void append(const Column& col, size_type row);
+
+        /// Number of rows covered (indexed or missing)
+        size_type size() const noexcept;
+
+        /// Storage type of the column when the index was built
+        ColumnType type() const noexcept;
+
+        /// Rows whose cell equals key, parsed like Column::equal_to
+        Bitmap lookup(const Column& col, std::string_view key) const;
+
+    private:
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        struct Partition
+        {
+            detail::FlatIdMap words;                        // numeric keys and dictionary codes
+            std::unordered_map<std::string, size_type> text;    // string keys
+            std::vector<size_type> head;                    // first row of each key
+            std::vector<size_type> tail;                    // last row of each key
+        };
+
+        // Adds row to the chain of its key in partition p
+        void insert(Partition& p, const Column& col, size_type row, std::uint64_t word);
+        size_type partition_of(std::uint64_t hash) const noexcept;
+
+        ColumnType kind = ColumnType::string;
+        unsigned partition_bits = 0;
+        std::vector<Partition> partitions;
+        std::vector<size_type> next;        // next row with the same key, npos at the end
+    };
+
+    class SortedIndex
+    {
+    public:
+        using size_type = std::size_t;
+
+        SortedIndex() = default;
+
+        /// Sort every present row of col by its key (threads = 0: hardware_concurrency())
+        static SortedIndex build(const Column& col, size_type threads = 0);
+
+        /// Index row size(), which was just appended to col
+        void append(const Column& col, size_type row);
+
+        /// Number of rows covered (indexed or missing)
+        size_type size() const noexcept;
+
+        /// Storage type of the column when the index was built
+        ColumnType type() const noexcept;
+
+        /// Rows with lo <= cell <= hi on a numeric column (throws for text columns)
+        Bitmap range(const Column& col, double lo, double hi) const;
+
+        /// Rows with lo <= cell <= hi, lexicographic for string/dictionary columns;
+        /// numeric columns parse the bounds (throws if they are not numbers)
+        Bitmap range(const Column& col, std::string_view lo, std::string_view hi) const;
+
+    private:
+        // Sorts the pending rows and merges them into the sorted keys
+        void merge_pending(const Column& col);
+
+        ColumnType kind = ColumnType::string;
+        size_type covered = 0;
+        std::vector<size_type> order;           // indexed rows sorted by (key, row)
+        std::vector<std::int64_t> ints;         // keys of int64 and boolean columns
+        std::vector<double> doubles;            // keys of float64 columns
+        std::vector<std::string> texts;         // keys of string and dictionary columns
+        std::vector<size_type> pending;         // appended rows, not sorted yet
+    };
+}
+
+#endif // NUMERA_CORE_COLUMNINDEX_H
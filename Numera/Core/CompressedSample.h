@@ -0,0 +1,573 @@
+#ifndef NUMERA_CORE_COMPRESSEDSAMPLE_H
+#define NUMERA_CORE_COMPRESSEDSAMPLE_H
+#include "stats/BasicStats.h"
+#include "Core/Span.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief A compressed, append-only numeric sample for long metric histories.
+ *
+ * Values are appended to an uncompressed tail; every block_size values the
+ * tail is sealed into an independently decodable, word-aligned block:
+ *
+ * - floating point values use Gorilla-style XOR encoding: each value is
+ *   XORed with its predecessor and only the meaningful bits are stored
+ *   (one bit for a repeated value);
+ * - integral values use delta-of-delta encoding: the second difference is
+ *   zigzag-mapped and bit-packed with the smallest width that fits the
+ *   whole block (zero bits per value for perfectly regular series).
+ *
+ * Each sealed block keeps its count, min, max and sum, so min(), max(),
+ * arithmetic_mean() and sum() are answered from the block aggregates without
+ * decompressing anything. Order statistics decode block by block.
+ *
+ * @tparam T Arithmetic type of stored values
+ */
+
+namespace nr
+{
+    namespace detail
+    {
+        // Appends bit fields to a stream of 64-bit words (LSB first)
+        class BitWriter
+        {
+        public:
+            explicit BitWriter(std::vector<std::uint64_t>& words)
+                : words(words), bit_pos(words.size() * 64) {}
+
+            void write(std::uint64_t value, unsigned bits)
+            {
+                if (bits == 0) return;
+                if (bits < 64) value &= (std::uint64_t{1} << bits) - 1;
+
+                const unsigned offset = static_cast<unsigned>(bit_pos % 64);
+                if (offset == 0) words.push_back(0);
+                words.back() |= value << offset;
+                if (offset + bits > 64) words.push_back(value >> (64 - offset));
+                bit_pos += bits;
+            }
+
+        private:
+            std::vector<std::uint64_t>& words;
+            std::size_t bit_pos;
+        };
+
+        class BitReader
+        {
+        public:
+            BitReader(const std::uint64_t* words, std::size_t bit_pos = 0)
+                : words(words), bit_pos(bit_pos) {}
+
+            std::uint64_t read(unsigned bits)
+            {
+                if (bits == 0) return 0;
+
+                const std::size_t word = bit_pos / 64;
+                const unsigned offset = static_cast<unsigned>(bit_pos % 64);
+                std::uint64_t value = words[word] >> offset;
+                if (offset + bits > 64) value |= words[word + 1] << (64 - offset);
+                if (bits < 64) value &= (std::uint64_t{1} << bits) - 1;
+                bit_pos += bits;
+                return value;
+            }
+
+            bool read_bit()
+            {
+                bool bit = (words[bit_pos / 64] >> (bit_pos % 64)) & 1;
+                ++bit_pos;
+                return bit;
+            }
+
+        private:
+            const std::uint64_t* words;
+            std::size_t bit_pos;
+        };
+
+        inline std::uint64_t zigzag_encode(std::int64_t v)
+        {
+            return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+        }
+
+        inline std::int64_t zigzag_decode(std::uint64_t v)
+        {
+            return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+        }
+
+        inline unsigned bit_width(std::uint64_t v)
+        {
+            return v == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(v));
+        }
+    }
+
+    template <typename T>
+    class CompressedSample
+    {
+        static_assert(std::is_arithmetic_v<T>, "CompressedSample requires arithmetic type");
+        static_assert(sizeof(T) <= 8, "CompressedSample supports values up to 64 bits");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+
+        static constexpr size_type default_block_size = 1024;
+
+        // Per-block metadata kept next to the compressed stream
+        struct BlockInfo
+        {
+            size_type word_offset;  // first word of the block in the stream
+            size_type count;
+            T min;
+            T max;
+            double sum;
+        };
+
+        explicit CompressedSample(size_type block_size = default_block_size);
+        explicit CompressedSample(const std::vector<T>& values, size_type block_size = default_block_size);
+
+        void push_back(value_type value);
+        void add(value_type value);
+        void add(const std::vector<T>& values);
+
+        size_type size() const noexcept;
+        bool empty() const noexcept;
+        void clear();
+
+        /// Number of blocks including the open (not yet sealed) tail, if any
+        size_type block_count() const noexcept;
+        size_type block_size() const noexcept;
+        const std::vector<BlockInfo>& sealed_blocks() const noexcept;
+
+        /// Decodes block `index` into out (out is cleared first)
+        void decode_block(size_type index, std::vector<T>& out) const;
+
+        /// Calls f(Span<const T>) for every block in order, reusing one decode buffer
+        template <typename F>
+        void for_each_block(F f) const;
+
+        std::vector<T> decompress() const;
+
+        /// Answered from block aggregates, no decompression
+        value_type min() const;
+        value_type max() const;
+        double sum() const;
+        value_type arithmetic_mean() const;
+
+        /// Decode, then select
+        value_type median() const;
+        auto percentile(double p) const -> std::common_type_t<value_type, double>;
+
+        /// Memory held by the compressed stream, block metadata and the open tail
+        size_type compressed_bytes() const noexcept;
+        /// Raw size (size() * sizeof(T)) divided by compressed_bytes()
+        double compression_ratio() const noexcept;
+
+    private:
+        using bits_type = std::conditional_t<sizeof(T) <= 4, std::uint32_t, std::uint64_t>;
+
+        void seal_tail();
+        void encode_floating(const T* values, size_type n);
+        void encode_integral(const T* values, size_type n);
+        void decode_floating(const BlockInfo& info, T* out) const;
+        void decode_integral(const BlockInfo& info, T* out) const;
+
+        static std::uint64_t to_bits(T value);
+        static T from_bits(std::uint64_t bits);
+
+        size_type block_len;
+        std::vector<std::uint64_t> stream;
+        std::vector<BlockInfo> blocks;
+        std::vector<T> tail;
+        size_type total = 0;
+    };
+
+    template <typename T>
+    inline CompressedSample<T>::CompressedSample(size_type block_size)
+        : block_len(block_size)
+    {
+        if (block_size < 2)
+            throw std::invalid_argument("CompressedSample: block size must be at least 2");
+        tail.reserve(block_len);
+    }
+
+    template <typename T>
+    inline CompressedSample<T>::CompressedSample(const std::vector<T>& values, size_type block_size)
+        : CompressedSample(block_size)
+    {
+        add(values);
+    }
+
+    template <typename T>
+    inline void CompressedSample<T>::push_back(value_type value)
+    {
+        tail.push_back(value);
+        ++total;
+        if (tail.size() == block_len)
+            seal_tail();
+    }
+
+    template <typename T>
+    inline void CompressedSample<T>::add(value_type value)
+    {
+        push_back(value);
+    }
+
+    template <typename T>
+    inline void CompressedSample<T>::add(const std::vector<T>& values)
+    {
+        for (const auto& v : values)
+            push_back(v);
+    }
+
+    template <typename T>
+    inline typename CompressedSample<T>::size_type CompressedSample<T>::size() const noexcept
+    {
+        return total;
+    }
+
+    template <typename T>
+    inline bool CompressedSample<T>::empty() const noexcept
+    {
+        return total == 0;
+    }
+
+    template <typename T>
+    inline void CompressedSample<T>::clear()
+    {
+        stream.clear();
+        blocks.clear();
+        tail.clear();
+        total = 0;
+    }
+
+    template <typename T>
+    inline typename CompressedSample<T>::size_type CompressedSample<T>::block_count() const noexcept
+    {
+        return blocks.size() + (tail.empty() ? 0 : 1);
+    }
+
+    template <typename T>
+    inline typename CompressedSample<T>::size_type CompressedSample<T>::block_size() const noexcept
+    {
+        return block_len;
+    }
+
+    template <typename T>
+    inline const std::vector<typename CompressedSample<T>::BlockInfo>& CompressedSample<T>::sealed_blocks() const noexcept
+    {
+        return blocks;
+    }
+
+    template <typename T>
+    inline void CompressedSample<T>::decode_block(size_type index, std::vector<T>& out) const
+    {
+        if (index >= block_count())
+            throw std::out_of_range("decode_block: block index out of range");
+
+        if (index == blocks.size())
+        {
+            out.assign(tail.begin(), tail.end());
+            return;
+        }
+
+        const BlockInfo& info = blocks[index];
+        out.resize(info.count);
+        if constexpr (std::is_floating_point_v<T>)
+            decode_floating(info, out.data());
+        else
+            decode_integral(info, out.data());
+    }
+
+    template <typename T>
+    template <typename F>
+    inline void CompressedSample<T>::for_each_block(F f) const
+    {
+        std::vector<T> buffer;
+        buffer.reserve(block_len);
+        for (size_type b = 0; b < blocks.size(); ++b)
+        {
+            decode_block(b, buffer);
+            f(Span<const T>(buffer));
+        }
+        if (!tail.empty())
+            f(Span<const T>(tail));
+    }
+
+    template <typename T>
+    inline std::vector<T> CompressedSample<T>::decompress() const
+    {
+        std::vector<T> out;
+        out.reserve(total);
+        for_each_block([&](Span<const T> block) {
+            out.insert(out.end(), block.begin(), block.end());
+        });
+        return out;
+    }
+
+    template <typename T>
+    inline T CompressedSample<T>::min() const
+    {
+        if (total == 0) throw std::invalid_argument("min: empty container");
+
+        bool found = false;
+        T result{};
+        for (const auto& info : blocks)
+        {
+            if (!found || info.min < result) result = info.min;
+            found = true;
+        }
+        for (const auto& v : tail)
+        {
+            if (!found || v < result) result = v;
+            found = true;
+        }
+        return result;
+    }
+
+    template <typename T>
+    inline T CompressedSample<T>::max() const
+    {
+        if (total == 0) throw std::invalid_argument("max: empty container");
+
+        bool found = false;
+        T result{};
+        for (const auto& info : blocks)
+        {
+            if (!found || info.max > result) result = info.max;
+            found = true;
+        }
+        for (const auto& v : tail)
+        {
+            if (!found || v > result) result = v;
+            found = true;
+        }
+        return result;
+    }
+
+    template <typename T>
+    inline double CompressedSample<T>::sum() const
+    {
+        double result = 0.0;
+        for (const auto& info : blocks)
+            result += info.sum;
+        for (const auto& v : tail)
+            result += static_cast<double>(v);
+        return result;
+    }
+
+    template <typename T>
+    inline T CompressedSample<T>::arithmetic_mean() const
+    {
+        if (total == 0) throw std::invalid_argument("arithmetic_mean: empty container");
+        return static_cast<T>(sum() / total);
+    }
+
+    template <typename T>
+    inline T CompressedSample<T>::median() const
+    {
+        if (total == 0) throw std::invalid_argument("median: empty container");
+        std::vector<T> values = decompress();
+        return detail::median_of(values);
+    }
+
+    template <typename T>
+    inline auto CompressedSample<T>::percentile(double p) const -> std::common_type_t<value_type, double>
+    {
+        return nr::percentile(decompress(), p);
+    }
+
+    template <typename T>
+    inline typename CompressedSample<T>::size_type CompressedSample<T>::compressed_bytes() const noexcept
+    {
+        return stream.size() * sizeof(std::uint64_t)
+             + blocks.size() * sizeof(BlockInfo)
+             + tail.size() * sizeof(T);
+    }
+
+    template <typename T>
+    inline double CompressedSample<T>::compression_ratio() const noexcept
+    {
+        size_type bytes = compressed_bytes();
+        return bytes == 0 ? 1.0 : static_cast<double>(total * sizeof(T)) / bytes;
+    }
+
+    template <typename T>
+    inline void CompressedSample<T>::seal_tail()
+    {
+        if (tail.empty()) return;
+
+        BlockInfo info;
+        info.word_offset = stream.size();
+        info.count = tail.size();
+        info.min = *std::min_element(tail.begin(), tail.end());
+        info.max = *std::max_element(tail.begin(), tail.end());
+        info.sum = 0.0;
+        for (const auto& v : tail)
+            info.sum += static_cast<double>(v);
+
+        if constexpr (std::is_floating_point_v<T>)
+            encode_floating(tail.data(), tail.size());
+        else
+            encode_integral(tail.data(), tail.size());
+
+        blocks.push_back(info);
+        tail.clear();
+    }
+
+    template <typename T>
+    inline void CompressedSample<T>::encode_floating(const T* values, size_type n)
+    {
+        // Gorilla XOR encoding:
+        //   '0'                             value equals its predecessor
+        //   '10' + bits                     meaningful bits fit the previous window
+        //   '11' + 5b lead + 6b len + bits  new window
+        detail::BitWriter writer(stream);
+
+        std::uint64_t prev = to_bits(values[0]);
+        writer.write(prev, 64);
+
+        unsigned prev_lead = 65;
+        unsigned prev_trail = 0;
+
+        for (size_type i = 1; i < n; ++i)
+        {
+            std::uint64_t cur = to_bits(values[i]);
+            std::uint64_t x = cur ^ prev;
+            prev = cur;
+
+            if (x == 0)
+            {
+                writer.write(0, 1);
+                continue;
+            }
+
+            unsigned lead = static_cast<unsigned>(__builtin_clzll(x));
+            unsigned trail = static_cast<unsigned>(__builtin_ctzll(x));
+            if (lead > 31) lead = 31;
+
+            if (prev_lead <= 64 && lead >= prev_lead && trail >= prev_trail)
+            {
+                writer.write(0b01, 2);
+                writer.write(x >> prev_trail, 64 - prev_lead - prev_trail);
+            }
+            else
+            {
+                unsigned len = 64 - lead - trail;
+                writer.write(0b11, 2);
+                writer.write(lead, 5);
+                writer.write(len == 64 ? 0 : len, 6);
+                writer.write(x >> trail, len);
+                prev_lead = lead;
+                prev_trail = trail;
+            }
+        }
+    }
+
+    template <typename T>
+    inline void CompressedSample<T>::decode_floating(const BlockInfo& info, T* out) const
+    {
+        detail::BitReader reader(stream.data() + info.word_offset);
+
+        std::uint64_t prev = reader.read(64);
+        out[0] = from_bits(prev);
+
+        unsigned lead = 0;
+        unsigned trail = 0;
+
+        for (size_type i = 1; i < info.count; ++i)
+        {
+            if (reader.read_bit())
+            {
+                if (reader.read_bit())
+                {
+                    lead = static_cast<unsigned>(reader.read(5));
+                    unsigned len = static_cast<unsigned>(reader.read(6));
+                    if (len == 0) len = 64;
+                    trail = 64 - lead - len;
+                }
+                prev ^= reader.read(64 - lead - trail) << trail;
+            }
+            out[i] = from_bits(prev);
+        }
+    }
+
+    template <typename T>
+    inline void CompressedSample<T>::encode_integral(const T* values, size_type n)
+    {
+        // Delta-of-delta: first value and first delta verbatim, then the second
+        // differences zigzag-mapped and bit-packed with one width per block.
+        // Arithmetic wraps modulo 2^64, so any 64-bit input round-trips.
+        detail::BitWriter writer(stream);
+
+        auto as_u64 = [](T v) { return static_cast<std::uint64_t>(static_cast<std::int64_t>(v)); };
+
+        writer.write(as_u64(values[0]), 64);
+        if (n < 2) return;
+        std::uint64_t prev_delta = as_u64(values[1]) - as_u64(values[0]);
+        writer.write(prev_delta, 64);
+
+        std::vector<std::uint64_t> dods;
+        dods.reserve(n);
+        unsigned width = 0;
+        for (size_type i = 2; i < n; ++i)
+        {
+            std::uint64_t delta = as_u64(values[i]) - as_u64(values[i - 1]);
+            std::uint64_t zz = detail::zigzag_encode(static_cast<std::int64_t>(delta - prev_delta));
+            width = std::max(width, detail::bit_width(zz));
+            dods.push_back(zz);
+            prev_delta = delta;
+        }
+
+        writer.write(width, 7);
+        for (auto zz : dods)
+            writer.write(zz, width);
+    }
+
+    template <typename T>
+    inline void CompressedSample<T>::decode_integral(const BlockInfo& info, T* out) const
+    {
+        detail::BitReader reader(stream.data() + info.word_offset);
+
+        std::uint64_t prev = reader.read(64);
+        out[0] = static_cast<T>(static_cast<std::int64_t>(prev));
+        if (info.count < 2) return;
+
+        std::uint64_t delta = reader.read(64);
+        prev += delta;
+        out[1] = static_cast<T>(static_cast<std::int64_t>(prev));
+
+        unsigned width = static_cast<unsigned>(reader.read(7));
+        for (size_type i = 2; i < info.count; ++i)
+        {
+            delta += static_cast<std::uint64_t>(detail::zigzag_decode(reader.read(width)));
+            prev += delta;
+            out[i] = static_cast<T>(static_cast<std::int64_t>(prev));
+        }
+    }
+
+    template <typename T>
+    inline std::uint64_t CompressedSample<T>::to_bits(T value)
+    {
+        bits_type bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        return bits;
+    }
+
+    template <typename T>
+    inline T CompressedSample<T>::from_bits(std::uint64_t bits)
+    {
+        bits_type narrow = static_cast<bits_type>(bits);
+        T value;
+        std::memcpy(&value, &narrow, sizeof(T));
+        return value;
+    }
+}
+
+#endif // NUMERA_CORE_COMPRESSEDSAMPLE_H
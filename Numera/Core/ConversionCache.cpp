@@ -0,0 +1,106 @@
+#include "ConversionCache.h"
+
+nr::ConversionCache::ConversionCache(const ConversionCache &other) : limit(other.budget())
+{
+}
+
+nr::ConversionCache& nr::ConversionCache::operator=(const ConversionCache &other)
+{
+    if (this != &other) {
+        const size_type budget = other.budget();
+        std::lock_guard<std::mutex> guard(lock);
+        cached.clear();
+        recent.clear();
+        used = 0;
+        limit = budget;
+    }
+    return *this;
+}
+
+void nr::ConversionCache::clear()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    cached.clear();
+    recent.clear();
+    used = 0;
+}
+
+void nr::ConversionCache::set_budget(size_type bytes)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    limit = bytes;
+    evict();
+}
+
+nr::ConversionCache::size_type nr::ConversionCache::budget() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return limit;
+}
+
+nr::ConversionCache::size_type nr::ConversionCache::bytes() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return used;
+}
+
+nr::ConversionCache::size_type nr::ConversionCache::entries() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return cached.size();
+}
+
+std::uint64_t nr::ConversionCache::hits() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return hit_count;
+}
+
+std::uint64_t nr::ConversionCache::misses() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return miss_count;
+}
+
+std::shared_ptr<const void> nr::ConversionCache::find(const Key &key)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = cached.find(key);
+    if (it == cached.end()) {
+        ++miss_count;
+        return nullptr;
+    }
+
+    ++hit_count;
+    recent.splice(recent.begin(), recent, it->second.recent);
+    return it->second.buffer;
+}
+
+std::shared_ptr<const void> nr::ConversionCache::insert(const Key &key, std::shared_ptr<const void> buffer,
+                                                        size_type bytes)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = cached.find(key);
+    if (it != cached.end()) {
+        // Another reader converted the same column first
+        recent.splice(recent.begin(), recent, it->second.recent);
+        return it->second.buffer;
+    }
+    if (bytes > limit) return buffer;
+
+    recent.push_front(key);
+    cached.emplace(key, Entry{buffer, bytes, recent.begin()});
+    used += bytes;
+    evict();
+    return buffer;
+}
+
+void nr::ConversionCache::evict()
+{
+    while (used > limit && !recent.empty()) {
+        auto it = cached.find(recent.back());
+        used -= it->second.bytes;
+        cached.erase(it);
+        recent.pop_back();
+    }
+}
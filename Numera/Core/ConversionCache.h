@@ -0,0 +1,136 @@
+#ifndef NUMERA_CORE_CONVERSIONCACHE_H
+#define NUMERA_CORE_CONVERSIONCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Memory-bounded cache of converted column buffers.
+ *
+ * CSVTable::extract_cached<T>() keeps the result of converting a column
+ * to T here, keyed by (column, T), and hands out the same immutable
+ * buffer (std::shared_ptr<const std::vector<T>>) until the table changes.
+ *
+ * The cache holds at most budget() bytes of buffers. When an insert
+ * goes over the budget, the least recently used buffers are evicted;
+ * a buffer larger than the whole budget is returned but not kept.
+ * Evicted buffers stay valid for callers that still hold them.
+ *
+ * All members lock an internal mutex, so concurrent readers of a const
+ * table may share one cache. A conversion runs outside the lock: two
+ * readers missing on the same key at once both convert, and the first
+ * buffer inserted is the one kept and returned to both.
+ *
+ * Copies start empty with the same budget (the buffers describe the
+ * source table, which may change independently).
+ */
+
+namespace nr
+{
+    class ConversionCache
+    {
+    public:
+        using size_type = std::size_t;
+
+        static constexpr size_type default_budget = size_type{64} << 20;   // 64 MiB
+
+        explicit ConversionCache(size_type budget = default_budget) : limit(budget) {}
+        ConversionCache(const ConversionCache& other);
+        ConversionCache& operator=(const ConversionCache& other);
+
+        /// Buffer of column converted to T, made by make() (returning std::vector<T>) on a miss
+        template <typename T, typename Make>
+        std::shared_ptr<const std::vector<T>> get_or_make(size_type column, Make make);
+
+        /// Drop every buffer (e.g. when the table changes)
+        void clear();
+
+        /// Change the budget, evicting down to it (0 disables caching)
+        void set_budget(size_type bytes);
+        size_type budget() const;
+
+        /// Bytes and buffers currently held
+        size_type bytes() const;
+        size_type entries() const;
+
+        /// Lookups answered from the cache and conversions made since construction
+        std::uint64_t hits() const;
+        std::uint64_t misses() const;
+
+    private:
+        struct Key
+        {
+            size_type column;
+            std::type_index type;
+
+            bool operator==(const Key& other) const noexcept { return column == other.column && type == other.type; }
+        };
+
+        struct KeyHash
+        {
+            size_type operator()(const Key& key) const noexcept
+            {
+                return std::hash<std::type_index>{}(key.type) ^ (key.column * 0x9e3779b97f4a7c15ULL);
+            }
+        };
+
+        struct Entry
+        {
+            std::shared_ptr<const void> buffer;
+            size_type bytes;
+            std::list<Key>::iterator recent;    // position in the LRU list
+        };
+
+        // Buffer for key (marked most recently used), null on a miss
+        std::shared_ptr<const void> find(const Key& key);
+
+        // Keeps buffer unless key was inserted meanwhile; returns the buffer that is kept
+        std::shared_ptr<const void> insert(const Key& key, std::shared_ptr<const void> buffer, size_type bytes);
+
+        // Evicts least recently used buffers until used <= limit (lock held)
+        void evict();
+
+        template <typename T>
+        static size_type footprint(const std::vector<T>& values) noexcept;
+
+        mutable std::mutex lock;
+        std::unordered_map<Key, Entry, KeyHash> cached;
+        std::list<Key> recent;      // front: most recently used
+        size_type limit;
+        size_type used = 0;
+        std::uint64_t hit_count = 0;
+        std::uint64_t miss_count = 0;
+    };
+
+    template <typename T, typename Make>
+    inline std::shared_ptr<const std::vector<T>> ConversionCache::get_or_make(size_type column, Make make)
+    {
+        const Key key{column, std::type_index(typeid(T))};
+        if (auto found = find(key))
+            return std::static_pointer_cast<const std::vector<T>>(found);
+
+        auto buffer = std::make_shared<const std::vector<T>>(make());
+        const size_type size = footprint(*buffer);
+        return std::static_pointer_cast<const std::vector<T>>(insert(key, std::move(buffer), size));
+    }
+
+    template <typename T>
+    inline ConversionCache::size_type ConversionCache::footprint(const std::vector<T>& values) noexcept
+    {
+        size_type bytes = values.capacity() * sizeof(T);
+        if constexpr (std::is_same_v<T, std::string>)
+            for (const std::string& s : values)
+                if (s.capacity() >= sizeof(std::string)) bytes += s.capacity() + 1;    // heap text
+        return bytes;
+    }
+}
+
+#endif // NUMERA_CORE_CONVERSIONCACHE_H
@@ -0,0 +1,437 @@
+#include "GroupBy.h"
+#include "CSVTable.h"
+#include "Hashing.h"
+#include "Parallel.h"
+#include "stats/BasicStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nr
+{
+    namespace detail
+    {
+        static constexpr std::size_t no_group = static_cast<std::size_t>(-1);
+
+        // Bit i of validity words, all present when the column has no bitmap
+        static bool present_in(const std::uint64_t* words, std::size_t row) noexcept
+        {
+            return words == nullptr || ((words[row >> 6] >> (row & 63)) & 1);
+        }
+
+        static const std::uint64_t* validity_words(const Column& col) noexcept
+        {
+            return col.validity().empty() ? nullptr : col.validity().words().data();
+        }
+
+        // Key cells of the key column as the type the group ids are built on
+        template <typename Key>
+        struct KeyCells;
+
+        // int64, float64 and boolean keys as 64-bit patterns (-0.0 and NaNs canonicalized)
+        template <>
+        struct KeyCells<std::uint64_t>
+        {
+            explicit KeyCells(const Column& col) : type(col.type())
+            {
+                if (type == ColumnType::int64) ints = col.view<std::int64_t>();
+                else if (type == ColumnType::float64) doubles = col.view<double>();
+                else bools = col.view<std::uint8_t>();
+            }
+
+            std::uint64_t at(std::size_t row) const noexcept
+            {
+                if (type == ColumnType::int64) return static_cast<std::uint64_t>(ints[row]);
+                if (type == ColumnType::boolean) return bools[row];
+
+                double v = doubles[row];
+                if (v == 0.0) v = 0.0;
+                if (std::isnan(v)) v = std::numeric_limits<double>::quiet_NaN();
+                std::uint64_t bits;
+                std::memcpy(&bits, &v, sizeof(bits));
+                return bits;
+            }
+
+            ColumnType type;
+            Span<const std::int64_t> ints;
+            Span<const double> doubles;
+            Span<const std::uint8_t> bools;
+        };
+
+        template <>
+        struct KeyCells<std::string_view>
+        {
+            explicit KeyCells(const Column& col) : col(col) {}
+            std::string_view at(std::size_t row) const { return col.text(row); }
+            const Column& col;
+        };
+
+        template <>
+        struct KeyCells<Column::code_type>
+        {
+            explicit KeyCells(const Column& col) : codes(col.view<Column::code_type>()) {}
+            Column::code_type at(std::size_t row) const noexcept { return codes[row]; }
+            Span<const Column::code_type> codes;
+        };
+
+        // Dense ids for the keys of one chunk, in first-seen order
+        template <typename Key>
+        class GroupIds;
+
+        template <>
+        class GroupIds<std::uint64_t>
+        {
+        public:
+            explicit GroupIds(const Column&) {}
+            std::size_t insert(std::uint64_t key) { return map.insert(key); }
+            std::size_t size() const noexcept { return map.size(); }
+            std::uint64_t key(std::size_t id) const { return map.key(id); }
+
+        private:
+            FlatIdMap map;
+        };
+
+        template <>
+        class GroupIds<std::string_view>
+        {
+        public:
+            explicit GroupIds(const Column&) {}
+
+            std::size_t insert(std::string_view key)
+            {
+                auto [it, inserted] = ids.emplace(key, keys.size());
+                if (inserted) keys.push_back(key);
+                return it->second;
+            }
+
+            std::size_t size() const noexcept { return keys.size(); }
+            std::string_view key(std::size_t id) const { return keys[id]; }
+
+        private:
+            std::unordered_map<std::string_view, std::size_t> ids;
+            std::vector<std::string_view> keys;
+        };
+
+        // Dictionary codes are already dense: a flat array maps code -> id
+        template <>
+        class GroupIds<Column::code_type>
+        {
+        public:
+            explicit GroupIds(const Column& col) : id_of(col.dictionary().size(), no_group) {}
+
+            std::size_t insert(Column::code_type code)
+            {
+                std::size_t& id = id_of[code];
+                if (id == no_group) {
+                    id = codes.size();
+                    codes.push_back(code);
+                }
+                return id;
+            }
+
+            std::size_t size() const noexcept { return codes.size(); }
+            Column::code_type key(std::size_t id) const { return codes[id]; }
+
+        private:
+            std::vector<std::size_t> id_of;
+            std::vector<Column::code_type> codes;
+        };
+
+        // Fixed-size partial aggregate of one group and value column
+        struct AggState
+        {
+            std::size_t count = 0;
+            double sum = 0.0;
+            double min = std::numeric_limits<double>::infinity();
+            double max = -std::numeric_limits<double>::infinity();
+
+            void add(double v) noexcept
+            {
+                ++count;
+                sum += v;
+                min = std::min(min, v);
+                max = std::max(max, v);
+            }
+
+            void merge(const AggState& other) noexcept
+            {
+                count += other.count;
+                sum += other.sum;
+                min = std::min(min, other.min);
+                max = std::max(max, other.max);
+            }
+        };
+
+        // A value column referenced by at least one spec
+        struct ValueSlot
+        {
+            explicit ValueSlot(const Column& col)
+                : type(col.type()), valid(validity_words(col)),
+                  numeric(type == ColumnType::int64 || type == ColumnType::float64 || type == ColumnType::boolean)
+            {
+                if (type == ColumnType::int64) ints = col.view<std::int64_t>();
+                else if (type == ColumnType::float64) doubles = col.view<double>();
+                else if (type == ColumnType::boolean) bools = col.view<std::uint8_t>();
+            }
+
+            double at(std::size_t row) const noexcept
+            {
+                if (type == ColumnType::float64) return doubles[row];
+                if (type == ColumnType::int64) return static_cast<double>(ints[row]);
+                return bools[row];
+            }
+
+            ColumnType type;
+            const std::uint64_t* valid;
+            bool numeric;
+            bool holistic = false;      // median or percentile requested
+            Span<const std::int64_t> ints;
+            Span<const double> doubles;
+            Span<const std::uint8_t> bools;
+        };
+
+        struct Grouped
+        {
+            std::vector<std::size_t> first_row;             // per group
+            std::vector<std::vector<AggState>> states;      // per slot, per group
+            std::vector<std::size_t> row_group;             // per row (when a slot is holistic)
+        };
+
+        template <typename Key>
+        struct Partial
+        {
+            explicit Partial(const Column& key) : ids(key) {}
+
+            GroupIds<Key> ids;
+            std::vector<std::size_t> first_row;
+            std::vector<std::vector<AggState>> states;
+        };
+
+        template <typename Key>
+        static Grouped group_and_accumulate(const Column& key_col, const std::vector<ValueSlot>& slots,
+                                            bool keep_rows, std::size_t threads)
+        {
+            const std::size_t n = key_col.size();
+            const KeyCells<Key> keys(key_col);
+            const std::uint64_t* key_valid = validity_words(key_col);
+
+            Grouped out;
+            out.row_group.assign(n, no_group);
+
+            // Each chunk groups its rows with local ids and local partial states
+            std::vector<Partial<Key>> partials;
+            partials.reserve(threads);
+            for (std::size_t t = 0; t < threads; ++t) {
+                partials.emplace_back(key_col);
+                partials.back().states.resize(slots.size());
+            }
+
+            parallel_chunks(n, threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+                Partial<Key>& part = partials[t];
+                for (std::size_t row = begin; row < end; ++row) {
+                    if (!present_in(key_valid, row)) continue;
+
+                    std::size_t g = part.ids.insert(keys.at(row));
+                    if (g == part.first_row.size()) {
+                        part.first_row.push_back(row);
+                        for (auto& s : part.states) s.emplace_back();
+                    }
+                    out.row_group[row] = g;
+
+                    for (std::size_t s = 0; s < slots.size(); ++s) {
+                        const ValueSlot& slot = slots[s];
+                        if (!present_in(slot.valid, row)) continue;
+                        if (slot.numeric) part.states[s][g].add(slot.at(row));
+                        else ++part.states[s][g].count;
+                    }
+                }
+            });
+
+            // Merge in chunk order, so global ids follow the first occurrence of each key
+            GroupIds<Key> global(key_col);
+            out.states.resize(slots.size());
+            std::vector<std::vector<std::size_t>> remap(threads);
+            for (std::size_t t = 0; t < threads; ++t) {
+                const Partial<Key>& part = partials[t];
+                remap[t].resize(part.ids.size());
+                for (std::size_t local = 0; local < part.ids.size(); ++local) {
+                    std::size_t g = global.insert(part.ids.key(local));
+                    if (g == out.first_row.size()) {
+                        out.first_row.push_back(part.first_row[local]);
+                        for (auto& s : out.states) s.emplace_back();
+                    }
+                    remap[t][local] = g;
+                    for (std::size_t s = 0; s < slots.size(); ++s)
+                        out.states[s][g].merge(part.states[s][local]);
+                }
+            }
+
+            if (!keep_rows) {
+                out.row_group.clear();
+                return out;
+            }
+
+            // Same chunks as above: translate local ids to global ones
+            parallel_chunks(n, threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+                for (std::size_t row = begin; row < end; ++row)
+                    if (out.row_group[row] != no_group) out.row_group[row] = remap[t][out.row_group[row]];
+            });
+            return out;
+        }
+
+        // Values of one column bucketed by group: group g owns values[offsets[g], offsets[g + 1])
+        static void bucket_values(const ValueSlot& slot, const std::vector<std::size_t>& row_group,
+                                  std::size_t groups, std::vector<std::size_t>& offsets, std::vector<double>& values)
+        {
+            offsets.assign(groups + 1, 0);
+            for (std::size_t row = 0; row < row_group.size(); ++row)
+                if (row_group[row] != no_group && present_in(slot.valid, row)) ++offsets[row_group[row] + 1];
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            values.resize(offsets.back());
+            std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (std::size_t row = 0; row < row_group.size(); ++row)
+                if (row_group[row] != no_group && present_in(slot.valid, row))
+                    values[cursor[row_group[row]]++] = slot.at(row);
+        }
+
+        static std::string aggregate_name(const Aggregate& a)
+        {
+            switch (a.kind) {
+                case AggregateKind::count:  return "count";
+                case AggregateKind::sum:    return "sum";
+                case AggregateKind::mean:   return "mean";
+                case AggregateKind::min:    return "min";
+                case AggregateKind::max:    return "max";
+                case AggregateKind::median: return "median";
+                case AggregateKind::percentile: return "p" + format_double(a.p);
+            }
+            return "unknown";
+        }
+    }
+}
+
+nr::CSVTable nr::GroupBy::agg(const std::vector<AggregateSpec> &specs, size_type threads) const
+{
+    const Column& key_col = table->column_data(key);
+    const size_type n = key_col.size();
+
+    // Validate the specs and collect the distinct value columns
+    std::vector<std::string> headers{table->headers[key]};
+    std::unordered_set<std::string> names{headers.front()};
+    std::vector<detail::ValueSlot> slots;
+    std::unordered_map<size_type, size_type> slot_of;     // column index -> slot
+    std::vector<size_type> spec_slot;
+    for (const auto& spec : specs)
+    {
+        size_type index = table->column_index(spec.column);
+        const Column& col = table->column_data(index);
+        const AggregateKind kind = spec.aggregate.kind;
+
+        auto [it, inserted] = slot_of.emplace(index, slots.size());
+        if (inserted) slots.emplace_back(col);
+        if (!slots[it->second].numeric && kind != AggregateKind::count)
+            throw std::invalid_argument("agg: column is not numeric: " + spec.column);
+        if (kind == AggregateKind::percentile && !(spec.aggregate.p >= 0.0 && spec.aggregate.p <= 100.0))
+            throw std::out_of_range("agg: percentile must be in [0, 100]");
+
+        std::string name = spec.name.empty() ? spec.column + "_" + detail::aggregate_name(spec.aggregate) : spec.name;
+        if (!names.insert(name).second)
+            throw std::invalid_argument("agg: duplicate output column: " + name);
+        headers.push_back(std::move(name));
+
+        if (kind == AggregateKind::median || kind == AggregateKind::percentile)
+            slots[it->second].holistic = true;
+        spec_slot.push_back(it->second);
+    }
+
+    const bool keep_rows = std::any_of(slots.begin(), slots.end(), [](const detail::ValueSlot& s) { return s.holistic; });
+    threads = detail::worker_count(threads, n);
+
+    detail::Grouped grouped;
+    switch (key_col.type()) {
+        case ColumnType::dictionary:
+            grouped = detail::group_and_accumulate<Column::code_type>(key_col, slots, keep_rows, threads);
+            break;
+        case ColumnType::string:
+            grouped = detail::group_and_accumulate<std::string_view>(key_col, slots, keep_rows, threads);
+            break;
+        default:
+            grouped = detail::group_and_accumulate<std::uint64_t>(key_col, slots, keep_rows, threads);
+            break;
+    }
+
+    // Output rows in order of first occurrence
+    const size_type groups = grouped.first_row.size();
+    std::vector<size_type> order(groups);
+    std::iota(order.begin(), order.end(), size_type{0});
+    std::sort(order.begin(), order.end(),
+              [&](size_type a, size_type b) { return grouped.first_row[a] < grouped.first_row[b]; });
+    std::vector<size_type> first_rows(groups);
+    for (size_type i = 0; i < groups; ++i) first_rows[i] = grouped.first_row[order[i]];
+
+    std::vector<Column> columns;
+    columns.reserve(headers.size());
+    columns.push_back(key_col.gather(Span<const size_type>(first_rows)));
+
+    // Holistic columns: one flat buffer per slot, selection per group slice
+    std::vector<std::vector<size_type>> offsets(slots.size());
+    std::vector<std::vector<double>> values(slots.size());
+    for (size_type s = 0; s < slots.size(); ++s)
+        if (slots[s].holistic) detail::bucket_values(slots[s], grouped.row_group, groups, offsets[s], values[s]);
+
+    for (size_type i = 0; i < specs.size(); ++i)
+    {
+        const Aggregate& a = specs[i].aggregate;
+        const size_type s = spec_slot[i];
+        const auto& states = grouped.states[s];
+
+        if (a.kind == AggregateKind::count) {
+            std::vector<std::int64_t> counts(groups);
+            for (size_type o = 0; o < groups; ++o) counts[o] = static_cast<std::int64_t>(states[order[o]].count);
+            columns.push_back(Column::from_values(std::move(counts)));
+            continue;
+        }
+
+        std::vector<double> result(groups, 0.0);
+        Bitmap valid(groups, true);
+        if (a.kind == AggregateKind::median || a.kind == AggregateKind::percentile) {
+            const double p = a.kind == AggregateKind::median ? 50.0 : a.p;
+            auto& buffer = values[s];
+            const auto& off = offsets[s];
+            detail::parallel_chunks(groups, threads, [&](size_type begin, size_type end, size_type) {
+                for (size_type o = begin; o < end; ++o) {
+                    size_type g = order[o];
+                    if (off[g] == off[g + 1]) {
+                        valid.reset(o);
+                        continue;
+                    }
+                    result[o] = detail::percentile_of_range(buffer.begin() + off[g], buffer.begin() + off[g + 1], p);
+                }
+            });
+        } else {
+            for (size_type o = 0; o < groups; ++o) {
+                const detail::AggState& st = states[order[o]];
+                if (a.kind == AggregateKind::sum) {
+                    result[o] = st.sum;
+                } else if (st.count == 0) {
+                    valid.reset(o);
+                } else if (a.kind == AggregateKind::mean) {
+                    result[o] = st.sum / static_cast<double>(st.count);
+                } else {
+                    result[o] = a.kind == AggregateKind::min ? st.min : st.max;
+                }
+            }
+        }
+        columns.push_back(Column::from_values(std::move(result), std::move(valid)));
+    }
+
+    return CSVTable(std::move(headers), std::move(columns));
+}
@@ -0,0 +1,102 @@
+#ifndef NUMERA_CORE_GROUPBY_H
+#define NUMERA_CORE_GROUPBY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Group-by aggregation over a CSVTable key column.
+ *
+ *     nr::CSVTable summary = table.group_by("host").agg({
+ *         {"latency", nr::agg::mean},
+ *         {"latency", nr::agg::p99},
+ *         {"bytes",   nr::agg::sum}});
+ *
+ * The result is a new CSVTable. It has one row per distinct present key,
+ * in order of first occurrence. Its columns are the key followed by one
+ * column per spec, named latency_mean, latency_p99, bytes_sum unless
+ * AggregateSpec::name says otherwise.
+ *
+ * Aggregation is hash based and runs in parallel. Each thread maps the
+ * keys of its chunk of rows to local group ids: dictionary codes index
+ * a flat array, numeric keys go through an open-addressing table, and
+ * text keys through a hash map. Next to each local group the thread
+ * keeps a fixed-size partial state (count, sum, min, max). The partial
+ * states are merged once at the end, so count, sum, mean, min and max
+ * never allocate per group.
+ *
+ * Median and percentiles need every value. They are computed from one
+ * flat buffer per value column, bucketed by group with a counting sort,
+ * with a selection (nth_element) on each group's slice.
+ *
+ * Missing values are skipped, and rows with a missing key belong to no
+ * group. A group without present values reports sum 0, count 0 and a
+ * missing value for the other aggregates.
+ */
+
+namespace nr
+{
+    class CSVTable;
+
+    enum class AggregateKind
+    {
+        count,      // present values
+        sum,
+        mean,
+        min,
+        max,
+        median,
+        percentile  // Aggregate::p, R7 like nr::percentile
+    };
+
+    struct Aggregate
+    {
+        AggregateKind kind = AggregateKind::count;
+        double p = 0.0;     // percentile in [0, 100]
+    };
+
+    namespace agg
+    {
+        inline constexpr Aggregate count{AggregateKind::count};
+        inline constexpr Aggregate sum{AggregateKind::sum};
+        inline constexpr Aggregate mean{AggregateKind::mean};
+        inline constexpr Aggregate min{AggregateKind::min};
+        inline constexpr Aggregate max{AggregateKind::max};
+        inline constexpr Aggregate median{AggregateKind::median};
+        inline constexpr Aggregate p90{AggregateKind::percentile, 90.0};
+        inline constexpr Aggregate p95{AggregateKind::percentile, 95.0};
+        inline constexpr Aggregate p99{AggregateKind::percentile, 99.0};
+
+        constexpr Aggregate percentile(double p) { return Aggregate{AggregateKind::percentile, p}; }
+    }
+
+    struct AggregateSpec
+    {
+        std::string column;     // value column
+        Aggregate aggregate;
+        std::string name;       // output column, empty: column + "_" + aggregate (count, sum, ..., p99)
+    };
+
+    /// Returned by CSVTable::group_by(); refers to the table, which must outlive it
+    class GroupBy
+    {
+    public:
+        using size_type = std::size_t;
+
+        /// Aggregate every group. Throws std::invalid_argument for non-numeric columns
+        /// (except count) or duplicate output names, std::out_of_range for unknown columns
+        /// and percentiles outside [0, 100].
+        CSVTable agg(const std::vector<AggregateSpec>& specs, size_type threads = 0) const;
+
+    private:
+        friend class CSVTable;
+
+        GroupBy(const CSVTable& table, size_type key) noexcept : table(&table), key(key) {}
+
+        const CSVTable* table;
+        size_type key;          // key column index
+    };
+}
+
+#endif // NUMERA_CORE_GROUPBY_H
@@ -0,0 +1,98 @@
+#ifndef NUMERA_CORE_HASHING_H
+#define NUMERA_CORE_HASHING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Hashing helpers shared by the join and aggregation kernels.
+ *
+ * mix_hash() is the MurmurHash3 64-bit finalizer: every input bit
+ * affects every output bit, so both the low bits (slot) and the high
+ * bits (partition) of the result are usable.
+ *
+ * FlatIdMap assigns dense ids 0, 1, 2, ... to 64-bit keys in the order
+ * they are first inserted. It uses open addressing with linear probing
+ * over a flat slot array (load factor <= 1/2), so a lookup touches one
+ * or two cache lines and inserting allocates nothing per key.
+ */
+
+namespace nr
+{
+    namespace detail
+    {
+        inline std::uint64_t mix_hash(std::uint64_t h) noexcept
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        class FlatIdMap
+        {
+        public:
+            static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+            explicit FlatIdMap(std::size_t expected = 16)
+            {
+                std::size_t capacity = 16;
+                while (capacity < 2 * expected) capacity <<= 1;
+                slots.assign(capacity, 0);
+            }
+
+            /// Id of key, assigning the next id when the key is new
+            std::size_t insert(std::uint64_t key)
+            {
+                std::size_t mask = slots.size() - 1;
+                std::size_t pos = mix_hash(key) & mask;
+                while (slots[pos] != 0) {
+                    if (by_id[slots[pos] - 1] == key) return slots[pos] - 1;
+                    pos = (pos + 1) & mask;
+                }
+
+                by_id.push_back(key);
+                slots[pos] = by_id.size();
+                if (2 * by_id.size() > slots.size()) grow();
+                return by_id.size() - 1;
+            }
+
+            /// Id of key, npos when the key was never inserted
+            std::size_t find(std::uint64_t key) const noexcept
+            {
+                std::size_t mask = slots.size() - 1;
+                std::size_t pos = mix_hash(key) & mask;
+                while (slots[pos] != 0) {
+                    if (by_id[slots[pos] - 1] == key) return slots[pos] - 1;
+                    pos = (pos + 1) & mask;
+                }
+                return npos;
+            }
+
+            std::size_t size() const noexcept { return by_id.size(); }
+
+            /// Key of an id
+            std::uint64_t key(std::size_t id) const { return by_id[id]; }
+
+        private:
+            void grow()
+            {
+                slots.assign(2 * slots.size(), 0);
+                std::size_t mask = slots.size() - 1;
+                for (std::size_t id = 0; id < by_id.size(); ++id) {
+                    std::size_t pos = mix_hash(by_id[id]) & mask;
+                    while (slots[pos] != 0) pos = (pos + 1) & mask;
+                    slots[pos] = id + 1;
+                }
+            }
+
+            std::vector<std::size_t> slots;      // id + 1, 0 = empty
+            std::vector<std::uint64_t> by_id;
+        };
+    }
+}
+
+#endif // NUMERA_CORE_HASHING_H
@@ -0,0 +1,70 @@
+#ifndef NUMERA_CORE_INSTRUMENTATION_H
+#define NUMERA_CORE_INSTRUMENTATION_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Process-wide counters describing the work done by scans.
+ *
+ * Filters and min/max queries on numeric columns walk their data in
+ * blocks (see ZoneMap). For every block they record whether its cells
+ * were read, or whether the block's zone alone decided the result:
+ *
+ *     nr::reset_scan_counters();
+ *     nr::Bitmap recent = table.filter("ts", nr::CompareOp::ge, cutoff);
+ *     nr::ScanCounters c = nr::scan_counters();
+ *     // c.blocks_skipped blocks were never read
+ *
+ * The counters are relaxed atomics shared by all threads and tables, so
+ * they are meant for tests, benchmarks and diagnostics rather than for
+ * attributing work to one query while others run.
+ */
+
+namespace nr
+{
+    struct ScanCounters
+    {
+        std::uint64_t blocks_scanned = 0;   // blocks whose cells were read
+        std::uint64_t blocks_skipped = 0;   // blocks ruled out by their zone (nothing matches)
+        std::uint64_t blocks_answered = 0;  // blocks decided by their zone without reading cells
+    };
+
+    namespace detail
+    {
+        struct ScanCounterCells
+        {
+            std::atomic<std::uint64_t> scanned{0};
+            std::atomic<std::uint64_t> skipped{0};
+            std::atomic<std::uint64_t> answered{0};
+        };
+
+        inline ScanCounterCells scan_counter_cells;
+
+        inline void count_blocks(std::uint64_t scanned, std::uint64_t skipped, std::uint64_t answered) noexcept
+        {
+            scan_counter_cells.scanned.fetch_add(scanned, std::memory_order_relaxed);
+            scan_counter_cells.skipped.fetch_add(skipped, std::memory_order_relaxed);
+            scan_counter_cells.answered.fetch_add(answered, std::memory_order_relaxed);
+        }
+    }
+
+    /// Counters accumulated since the start of the process or the last reset
+    inline ScanCounters scan_counters() noexcept
+    {
+        ScanCounters c;
+        c.blocks_scanned = detail::scan_counter_cells.scanned.load(std::memory_order_relaxed);
+        c.blocks_skipped = detail::scan_counter_cells.skipped.load(std::memory_order_relaxed);
+        c.blocks_answered = detail::scan_counter_cells.answered.load(std::memory_order_relaxed);
+        return c;
+    }
+
+    inline void reset_scan_counters() noexcept
+    {
+        detail::scan_counter_cells.scanned.store(0, std::memory_order_relaxed);
+        detail::scan_counter_cells.skipped.store(0, std::memory_order_relaxed);
+        detail::scan_counter_cells.answered.store(0, std::memory_order_relaxed);
+    }
+}
+
+#endif // NUMERA_CORE_INSTRUMENTATION_H
@@ -0,0 +1,379 @@
+#include "Join.h"
+#include "Hashing.h"
+#include "Parallel.h"
+#include "RadixSort.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <string_view>
+#include <type_traits>
+
+namespace nr
+{
+    namespace detail
+    {
+        static constexpr std::size_t no_group = static_cast<std::size_t>(-1);
+
+        static std::uint64_t hash_key(std::int64_t key) noexcept
+        {
+            return mix_hash(static_cast<std::uint64_t>(key));
+        }
+
+        static std::uint64_t hash_key(double key) noexcept
+        {
+            if (key == 0.0) key = 0.0;   // -0.0 == 0.0
+            std::uint64_t bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+            return mix_hash(bits);
+        }
+
+        static std::uint64_t hash_key(std::string_view key) noexcept
+        {
+            return mix_hash(std::hash<std::string_view>{}(key));
+        }
+
+        // Key cells of one side as Key: a view of the column when it already stores
+        // Key, otherwise converted (formatted text is owned by the struct)
+        template <typename Key>
+        struct JoinKeys
+        {
+            const Column* column = nullptr;
+            Span<const Key> values;
+            std::vector<Key> converted;
+            std::vector<std::string> text;
+
+            explicit JoinKeys(const Column& col) : column(&col)
+            {
+                const std::size_t n = col.size();
+                if constexpr (std::is_same_v<Key, std::int64_t>) {
+                    if (col.type() == ColumnType::int64) {
+                        values = col.view<std::int64_t>();
+                        return;
+                    }
+                    auto src = col.view<std::uint8_t>();   // boolean
+                    converted.assign(src.begin(), src.end());
+                } else if constexpr (std::is_same_v<Key, double>) {
+                    if (col.type() == ColumnType::float64) {
+                        values = col.view<double>();
+                        return;
+                    }
+                    auto src = col.view<std::int64_t>();
+                    converted.assign(src.begin(), src.end());
+                } else {
+                    converted.reserve(n);
+                    if (col.type() == ColumnType::string) {
+                        for (std::size_t i = 0; i < n; ++i) converted.push_back(col.text(i));
+                    } else if (col.type() == ColumnType::dictionary) {
+                        const auto& entries = col.dictionary();
+                        for (Column::code_type code : col.view<Column::code_type>())
+                            converted.push_back(code == Column::na_code ? std::string_view() : std::string_view(entries[code]));
+                    } else {
+                        // reserved up front so the views stay valid
+                        text.reserve(n);
+                        for (std::size_t i = 0; i < n; ++i) {
+                            text.push_back(col.format(i));
+                            converted.push_back(text.back());
+                        }
+                    }
+                }
+                values = Span<const Key>(converted);
+            }
+
+            JoinKeys(const JoinKeys&) = delete;
+            JoinKeys& operator=(const JoinKeys&) = delete;
+
+            bool missing(std::size_t row) const { return column->is_na(row); }
+        };
+
+        // Build rows grouped by key: group g holds rows[offsets[g], offsets[g + 1]) in row order
+        struct BuildGroups
+        {
+            std::vector<std::size_t> offsets;
+            std::vector<std::size_t> rows;
+
+            Span<const std::size_t> group(std::size_t g) const
+            {
+                return Span<const std::size_t>(rows.data() + offsets[g], offsets[g + 1] - offsets[g]);
+            }
+
+            // Counting sort of the rows by group id (no_group rows are left out)
+            void fill(const std::vector<std::size_t>& row_group, std::size_t group_count)
+            {
+                offsets.assign(group_count + 1, 0);
+                for (std::size_t g : row_group)
+                    if (g != no_group) ++offsets[g + 1];
+                std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+                rows.resize(offsets.back());
+                std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+                for (std::size_t r = 0; r < row_group.size(); ++r)
+                    if (row_group[r] != no_group) rows[cursor[row_group[r]]++] = r;
+            }
+        };
+
+        // Radix-partitioned open-addressing table from key to group of build rows
+        template <typename Key>
+        class HashBuild
+        {
+        public:
+            explicit HashBuild(const JoinKeys<Key>& keys) : keys(keys)
+            {
+                const std::size_t n = keys.values.size();
+                std::vector<std::uint64_t> hashes(n);
+                std::vector<std::size_t> present;
+                present.reserve(n);
+                for (std::size_t r = 0; r < n; ++r) {
+                    if (keys.missing(r)) continue;
+                    hashes[r] = hash_key(keys.values[r]);
+                    present.push_back(r);
+                }
+
+                // About 4096 build rows per partition, at most 256 partitions
+                while (partition_bits < 8 && (present.size() >> partition_bits) > 4096) ++partition_bits;
+                const std::size_t partitions = std::size_t{1} << partition_bits;
+
+                // Cluster the rows by partition (stable) and size each partition's slot range
+                std::vector<std::size_t> part_count(partitions + 1, 0);
+                for (std::size_t r : present) ++part_count[partition_of(hashes[r]) + 1];
+                std::vector<std::size_t> order(present.size());
+                {
+                    std::vector<std::size_t> cursor(partitions);
+                    std::partial_sum(part_count.begin(), part_count.end() - 1, cursor.begin());
+                    for (std::size_t r : present) order[cursor[partition_of(hashes[r])]++] = r;
+                }
+
+                base.resize(partitions);
+                mask.resize(partitions);
+                std::size_t total = 0;
+                for (std::size_t p = 0; p < partitions; ++p) {
+                    std::size_t capacity = 2;
+                    while (capacity < 2 * part_count[p + 1]) capacity <<= 1;
+                    base[p] = total;
+                    mask[p] = capacity - 1;
+                    total += capacity;
+                }
+                slots.assign(total, 0);
+
+                // Insert partition by partition; equal keys share a group
+                std::vector<std::size_t> row_group(n, no_group);
+                for (std::size_t r : order) {
+                    const std::uint64_t h = hashes[r];
+                    std::size_t g = find(keys.values[r], h);
+                    if (g == no_group) {
+                        g = group_hash.size();
+                        group_hash.push_back(h);
+                        group_row.push_back(r);
+                        std::size_t p = partition_of(h);
+                        std::size_t pos = h & mask[p];
+                        while (slots[base[p] + pos] != 0) pos = (pos + 1) & mask[p];
+                        slots[base[p] + pos] = g + 1;
+                    }
+                    row_group[r] = g;
+                }
+                groups.fill(row_group, group_hash.size());
+            }
+
+            /// Group of the build rows with this key, no_group if there is none
+            std::size_t find(const Key& key, std::uint64_t h) const
+            {
+                const std::size_t p = partition_of(h);
+                std::size_t pos = h & mask[p];
+                while (true) {
+                    std::size_t s = slots[base[p] + pos];
+                    if (s == 0) return no_group;
+                    if (group_hash[s - 1] == h && keys.values[group_row[s - 1]] == key) return s - 1;
+                    pos = (pos + 1) & mask[p];
+                }
+            }
+
+            const BuildGroups& rows() const noexcept { return groups; }
+
+        private:
+            std::size_t partition_of(std::uint64_t h) const noexcept
+            {
+                return partition_bits == 0 ? 0 : static_cast<std::size_t>(h >> (64 - partition_bits));
+            }
+
+            const JoinKeys<Key>& keys;
+            unsigned partition_bits = 0;
+            std::vector<std::size_t> base;       // first slot of each partition
+            std::vector<std::size_t> mask;       // slot count - 1 of each partition
+            std::vector<std::size_t> slots;      // group id + 1, 0 = empty
+            std::vector<std::uint64_t> group_hash;
+            std::vector<std::size_t> group_row;  // first build row of each group
+            BuildGroups groups;
+        };
+
+        // Probes every row of the probe side against the build groups and assembles the
+        // result; group_of(row) returns the matching group or no_group
+        template <typename GroupOf>
+        static JoinResult probe(const BuildGroups& build, bool build_left, std::size_t left_rows,
+                                std::size_t probe_rows, JoinKind kind, std::size_t threads, GroupOf group_of)
+        {
+            JoinResult result;
+            result.kind = kind;
+            threads = worker_count(threads, probe_rows);
+
+            const bool selection = kind == JoinKind::semi || kind == JoinKind::anti;
+            if (selection && !build_left)
+            {
+                // Left rows are probed: each chunk owns whole words of the selection
+                result.selection = Bitmap(left_rows);
+                parallel_chunks(probe_rows, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t l = begin; l < end; ++l)
+                        if (group_of(l) != no_group) result.selection.set(l);
+                });
+                if (kind == JoinKind::anti) result.selection.flip();
+                return result;
+            }
+
+            if (selection)
+            {
+                // Right rows are probed: mark the left rows they reach, per thread
+                std::vector<Bitmap> marks(threads, Bitmap(left_rows));
+                parallel_chunks(probe_rows, threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+                    for (std::size_t r = begin; r < end; ++r) {
+                        std::size_t g = group_of(r);
+                        if (g == no_group) continue;
+                        for (std::size_t l : build.group(g)) marks[t].set(l);
+                    }
+                });
+                result.selection = std::move(marks[0]);
+                for (std::size_t t = 1; t < threads; ++t) result.selection |= marks[t];
+                if (kind == JoinKind::anti) result.selection.flip();
+                return result;
+            }
+
+            // Pairs, collected per chunk and concatenated in chunk order
+            std::vector<std::vector<std::size_t>> probe_side(threads), build_side(threads);
+            const bool keep_unmatched = kind == JoinKind::left && !build_left;
+            parallel_chunks(probe_rows, threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+                for (std::size_t row = begin; row < end; ++row) {
+                    std::size_t g = group_of(row);
+                    if (g == no_group) {
+                        if (keep_unmatched) {
+                            probe_side[t].push_back(row);
+                            build_side[t].push_back(JoinResult::no_match);
+                        }
+                        continue;
+                    }
+                    for (std::size_t b : build.group(g)) {
+                        probe_side[t].push_back(row);
+                        build_side[t].push_back(b);
+                    }
+                }
+            });
+
+            auto& out_left = result.left_rows;
+            auto& out_right = result.right_rows;
+            for (std::size_t t = 0; t < threads; ++t) {
+                const auto& l = build_left ? build_side[t] : probe_side[t];
+                const auto& r = build_left ? probe_side[t] : build_side[t];
+                out_left.insert(out_left.end(), l.begin(), l.end());
+                out_right.insert(out_right.end(), r.begin(), r.end());
+            }
+            if (!build_left) return result;
+
+            // Pairs come out in right-row order; a stable sort by left row restores (left, right) order
+            std::vector<std::uint64_t> keys(out_left.begin(), out_left.end());
+            std::vector<std::size_t> order(out_left.size());
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            radix_sort_rows(keys.data(), order);
+
+            std::vector<std::size_t> sorted_left, sorted_right;
+            sorted_left.reserve(order.size() + (kind == JoinKind::left ? left_rows : 0));
+            sorted_right.reserve(sorted_left.capacity());
+            std::size_t next = 0;   // next left row not yet emitted (left join)
+            for (std::size_t i : order) {
+                if (kind == JoinKind::left) {
+                    for (; next < out_left[i]; ++next) {
+                        sorted_left.push_back(next);
+                        sorted_right.push_back(JoinResult::no_match);
+                    }
+                    next = out_left[i] + 1;
+                }
+                sorted_left.push_back(out_left[i]);
+                sorted_right.push_back(out_right[i]);
+            }
+            if (kind == JoinKind::left) {
+                for (; next < left_rows; ++next) {
+                    sorted_left.push_back(next);
+                    sorted_right.push_back(JoinResult::no_match);
+                }
+            }
+            out_left = std::move(sorted_left);
+            out_right = std::move(sorted_right);
+            return result;
+        }
+
+        template <typename Key>
+        static JoinResult hash_join(const Column& build_col, const Column& probe_col, bool build_left,
+                                    std::size_t left_rows, JoinKind kind, std::size_t threads)
+        {
+            JoinKeys<Key> build_keys(build_col);
+            JoinKeys<Key> probe_keys(probe_col);
+            HashBuild<Key> table(build_keys);
+
+            return probe(table.rows(), build_left, left_rows, probe_col.size(), kind, threads,
+                         [&](std::size_t row) {
+                             if (probe_keys.missing(row)) return no_group;
+                             const Key& key = probe_keys.values[row];
+                             return table.find(key, hash_key(key));
+                         });
+        }
+
+        static JoinResult code_join(const Column& build_col, const Column& probe_col, bool build_left,
+                                    std::size_t left_rows, JoinKind kind, std::size_t threads)
+        {
+            // Build rows bucketed by code, probe codes translated once per dictionary entry
+            auto build_codes = build_col.view<Column::code_type>();
+            std::vector<std::size_t> row_group(build_codes.begin(), build_codes.end());
+            for (auto& g : row_group)
+                if (g == Column::na_code) g = no_group;
+            BuildGroups groups;
+            groups.fill(row_group, build_col.dictionary().size());
+
+            std::vector<std::size_t> translate;
+            translate.reserve(probe_col.dictionary().size());
+            for (const auto& entry : probe_col.dictionary()) {
+                Column::code_type code = build_col.find_code(entry);
+                translate.push_back(code == Column::na_code ? no_group : code);
+            }
+
+            auto probe_codes = probe_col.view<Column::code_type>();
+            return probe(groups, build_left, left_rows, probe_col.size(), kind, threads,
+                         [&](std::size_t row) {
+                             Column::code_type code = probe_codes[row];
+                             return code == Column::na_code ? no_group : translate[code];
+                         });
+        }
+    }
+}
+
+nr::JoinResult nr::join(const CSVTable &left, const CSVTable &right, const std::string &on,
+                        JoinKind kind, const JoinOptions &options)
+{
+    const Column& left_col = left.column_data(on);
+    const Column& right_col = right.column_data(options.right_on.empty() ? on : options.right_on);
+
+    const std::size_t threads = options.threads;
+
+    // Build on the smaller side, probe with the larger one
+    const bool build_left = left.row_count() < right.row_count();
+    const Column& build = build_left ? left_col : right_col;
+    const Column& probe = build_left ? right_col : left_col;
+
+    auto numeric = [](ColumnType t) { return t == ColumnType::int64 || t == ColumnType::float64; };
+    const ColumnType lt = left_col.type(), rt = right_col.type();
+
+    if (lt == ColumnType::dictionary && rt == ColumnType::dictionary)
+        return detail::code_join(build, probe, build_left, left.row_count(), kind, threads);
+    if (lt == rt && (lt == ColumnType::int64 || lt == ColumnType::boolean))
+        return detail::hash_join<std::int64_t>(build, probe, build_left, left.row_count(), kind, threads);
+    if (numeric(lt) && numeric(rt))
+        return detail::hash_join<double>(build, probe, build_left, left.row_count(), kind, threads);
+    return detail::hash_join<std::string_view>(build, probe, build_left, left.row_count(), kind, threads);
+}
@@ -0,0 +1,81 @@
+#ifndef NUMERA_CORE_JOIN_H
+#define NUMERA_CORE_JOIN_H
+#include "Core/Bitmap.h"
+#include "Core/CSVTable.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Equi-joins between two CSVTables on a key column.
+ *
+ * join() never copies rows. Inner and left joins return matching
+ * (left row, right row) index pairs; semi and anti joins return a
+ * selection over the left table. The pairs plug into
+ * CSVTable::extract_rows, and the selection plugs into
+ * extract_selected and the NullableStats mask overloads.
+ *
+ * The smaller table is the build side. How the keys are indexed
+ * depends on their column types:
+ * - Two dictionary columns are joined on codes. Each probe-side
+ *   dictionary entry is resolved against the build side once, and the
+ *   build rows are bucketed by code in a flat array, so probing hashes
+ *   nothing.
+ * - Other keys are hashed into an open-addressing table. The table is
+ *   radix-partitioned by the top bits of the hash, so each partition's
+ *   slots stay small and cache resident while it is built.
+ *
+ * The probe side is split into contiguous chunks that are probed in
+ * parallel with std::thread.
+ *
+ * Keys match when they are equal as values. int64 and float64 keys
+ * compare numerically (1 matches 1.0). Other combinations compare
+ * their text. Missing keys never match.
+ */
+
+namespace nr
+{
+    enum class JoinKind
+    {
+        inner,  // pairs of matching rows
+        left,   // like inner, plus unmatched left rows paired with JoinResult::no_match
+        semi,   // left rows with at least one match
+        anti    // left rows without a match (including missing keys)
+    };
+
+    struct JoinOptions
+    {
+        std::string right_on;       // key column of the right table, empty: same name as on
+        std::size_t threads = 0;    // probe threads, 0: std::thread::hardware_concurrency()
+    };
+
+    struct JoinResult
+    {
+        using size_type = std::size_t;
+
+        /// Right row of an unmatched left row in a left join
+        static constexpr size_type no_match = static_cast<size_type>(-1);
+
+        JoinKind kind = JoinKind::inner;
+
+        /// inner/left: left_rows[i] joins right_rows[i], ordered by left row, then right row
+        std::vector<size_type> left_rows;
+        std::vector<size_type> right_rows;
+
+        /// semi/anti: selection over the rows of the left table
+        Bitmap selection;
+
+        /// Number of result rows
+        size_type size() const noexcept
+        {
+            return kind == JoinKind::semi || kind == JoinKind::anti ? selection.count() : left_rows.size();
+        }
+    };
+
+    /// Join left and right on the key column `on` (throws std::out_of_range for a missing column)
+    JoinResult join(const CSVTable& left, const CSVTable& right, const std::string& on,
+                    JoinKind kind = JoinKind::inner, const JoinOptions& options = {});
+}
+
+#endif // NUMERA_CORE_JOIN_H
@@ -0,0 +1,181 @@
+#ifndef NUMERA_CORE_NUMERICPARSE_H
+#define NUMERA_CORE_NUMERICPARSE_H
+
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+/**
+ * @brief Locale-independent, allocation-free text to number conversion.
+ *
+ * The parsers are strict: the whole input must be consumed, so "12",
+ * "-3.5" and "1e9" parse but "12 ", "3.5x" and "" do not. An explicit
+ * leading '+' is accepted. Integers use std::from_chars. Floating point
+ * values use std::from_chars where the standard library provides it
+ * (__cpp_lib_to_chars); otherwise a hand-written decimal parser handles
+ * the common case exactly (<= 19 significant digits and a small
+ * exponent) and falls back to strtod for the rest.
+ */
+
+namespace nr
+{
+    namespace detail
+    {
+        // Skips an explicit plus sign (from_chars only accepts '-'); "+-1" stays invalid
+        inline const char* skip_plus(const char* first, const char* last) noexcept
+        {
+            if (first != last && *first == '+' && (last - first == 1 || first[1] != '-'))
+                ++first;
+            return first;
+        }
+
+        template <typename T>
+        bool parse_integer(std::string_view s, T& out) noexcept
+        {
+            static_assert(std::is_integral_v<T>, "parse_integer: integral type required");
+            const char* last = s.data() + s.size();
+            const char* first = skip_plus(s.data(), last);
+            if (first == last) return false;
+
+            auto [ptr, ec] = std::from_chars(first, last, out);
+            return ec == std::errc() && ptr == last;
+        }
+
+        // Correctly rounded conversion through the C library, used for the rare inputs
+        // the fast paths do not cover (inf, nan, very long mantissas, large exponents)
+        template <typename T>
+        bool parse_floating_strtod(std::string_view s, T& out) noexcept
+        {
+            if (s.empty() || s.size() >= 64) return false;
+
+            // Hexadecimal floats are not plain numbers, and strtod would skip leading spaces
+            const char* first = skip_plus(s.data(), s.data() + s.size());
+            std::size_t sign = (first != s.data() + s.size() && *first == '-') ? 1 : 0;
+            std::string_view body(first + sign, s.size() - static_cast<std::size_t>(first - s.data()) - sign);
+            if (body.empty() || body[0] == ' ' || body[0] == '\t' || body[0] == '\n' ||
+                (body.size() > 1 && body[0] == '0' && (body[1] == 'x' || body[1] == 'X')))
+                return false;
+
+            char local[64];
+            s.copy(local, s.size());
+            local[s.size()] = '\0';
+
+            char* end = nullptr;
+            errno = 0;
+            long double value = std::strtold(local, &end);
+            if (end != local + s.size()) return false;
+            if (errno == ERANGE && std::isinf(value)) return false;
+
+            out = static_cast<T>(value);
+            return !std::isinf(out) || std::isinf(value);
+        }
+
+        template <typename T>
+        bool parse_floating_fallback(std::string_view s, T& out) noexcept
+        {
+            static constexpr double powers[] = {
+                1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+
+            const char* p = s.data();
+            const char* last = p + s.size();
+            bool negative = false;
+            if (p != last && (*p == '+' || *p == '-')) negative = (*p++ == '-');
+
+            std::uint64_t mantissa = 0;
+            int digits = 0;          // significant digits kept in mantissa
+            int exponent = 0;        // decimal exponent applied to mantissa
+            bool any = false;
+            bool truncated = false;
+
+            auto digit = [&](char c, bool fraction) {
+                any = true;
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + static_cast<unsigned>(c - '0');
+                    if (mantissa != 0) ++digits;
+                    if (fraction) --exponent;
+                } else {
+                    if (c != '0') truncated = true;
+                    if (!fraction) ++exponent;
+                }
+            };
+
+            while (p != last && *p >= '0' && *p <= '9') digit(*p++, false);
+            if (p != last && *p == '.') {
+                ++p;
+                while (p != last && *p >= '0' && *p <= '9') digit(*p++, true);
+            }
+            if (!any) return parse_floating_strtod(s, out);   // inf, nan or malformed
+
+            if (p != last && (*p == 'e' || *p == 'E')) {
+                ++p;
+                bool exp_negative = false;
+                if (p != last && (*p == '+' || *p == '-')) exp_negative = (*p++ == '-');
+                if (p == last || *p < '0' || *p > '9') return false;
+                int e = 0;
+                while (p != last && *p >= '0' && *p <= '9') {
+                    if (e < 100000) e = e * 10 + (*p - '0');
+                    ++p;
+                }
+                exponent += exp_negative ? -e : e;
+            }
+            if (p != last) return false;
+
+            // Exact when both the mantissa and the power of ten are exact doubles
+            if (!truncated && mantissa <= (std::uint64_t{1} << 53) && exponent >= -22 && exponent <= 22) {
+                double value = static_cast<double>(mantissa);
+                value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+                out = static_cast<T>(negative ? -value : value);
+                return true;
+            }
+            return parse_floating_strtod(s, out);
+        }
+
+        template <typename T>
+        bool parse_floating(std::string_view s, T& out) noexcept
+        {
+            static_assert(std::is_floating_point_v<T>, "parse_floating: floating point type required");
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            const char* last = s.data() + s.size();
+            const char* first = skip_plus(s.data(), last);
+            if (first == last) return false;
+
+            auto [ptr, ec] = std::from_chars(first, last, out);
+            return ec == std::errc() && ptr == last;
+#else
+            return parse_floating_fallback(s, out);
+#endif
+        }
+
+        inline bool parse_bool(std::string_view s, bool& out) noexcept
+        {
+            if (s == "true")  { out = true;  return true; }
+            if (s == "false") { out = false; return true; }
+            return false;
+        }
+
+        /// Dispatches on T; bool accepts "0", "1", "true" and "false"
+        template <typename T>
+        bool parse_value(std::string_view s, T& out) noexcept
+        {
+            if constexpr (std::is_same_v<T, bool>) {
+                if (s == "0" || s == "false") { out = false; return true; }
+                if (s == "1" || s == "true")  { out = true;  return true; }
+                return false;
+            } else if constexpr (std::is_integral_v<T>) {
+                return parse_integer(s, out);
+            } else {
+                return parse_floating(s, out);
+            }
+        }
+    }
+}
+
+#endif // NUMERA_CORE_NUMERICPARSE_H
@@ -2,6 +2,7 @@
 #define NUMERA_CORE_VECTORDATA_H
 #include "stats/BasicStats.h"
 #include "io/IDataLoader.h"
+#include "Core/Bitmap.h"
 
 #include<iostream>
 #include<vector>
@@ -23,6 +24,15 @@
  *
  * This container owns its data and performs no I/O by itself.
  *
+ * Bulk removal (remove_if, remove_indices) compacts the storage in one
+ * linear pass. For workloads that delete many elements over time the
+ * sample also supports lazy deletion: mark_removed() only sets a tombstone
+ * bit, indices stay stable, statistics skip tombstoned values and compact()
+ * drops them all in a single pass.
+ *
+ * Missing values (NA) are tracked Arrow-style in a validity bitmap that is
+ * only allocated once the first NA appears; statistics skip them as well.
+ *
  * @tparam T Type of stored elements (must support comparison and arithmetic operations)
  */
 
@@ -43,6 +53,7 @@ namespace nr
         ~NumericSample() = default;
         NumericSample(const NumericSample& other);
         explicit NumericSample(container_type vec) : container(std::move(vec)) {}
+        NumericSample(container_type vec, Bitmap validity);
         NumericSample(IDataLoader<std::vector<T>>& loader, std::string filename);
         NumericSample(iterator begin, iterator end);
 
@@ -57,6 +68,28 @@ namespace nr
         void add(value_type element);
         void add(container_type elements);
         void remove_at(size_t index);
+
+        // Removes all elements matching pred in one pass, returns number removed
+        template <typename Predicate>
+        size_type remove_if(Predicate pred);
+
+        // Removes elements at the given ascending, unique indices in one pass
+        void remove_indices(const std::vector<size_type>& sorted_indices);
+
+        // Lazy deletion: tombstone the element, keep indices stable until compact()
+        void mark_removed(size_type index);
+        bool is_removed(size_type index) const;
+        size_type removed_count() const noexcept;
+        size_type live_size() const noexcept;
+        void compact();
+
+        // Missing values (NA): kept as a placeholder value with its validity bit cleared
+        void push_na();
+        bool is_na(size_type index) const;
+        size_type na_count() const noexcept;
+        // Empty when the sample has no missing values
+        const Bitmap& validity() const noexcept;
+
         const value_type& at(size_type index) const;
         size_type size() const;
         void clear();
@@ -92,13 +125,44 @@ namespace nr
         const_iterator cend () const noexcept; 
 
     private:
+        // Calls f with the live values: the container itself when nothing is
+        // tombstoned or missing, otherwise a compacted copy
+        template <typename F>
+        decltype(auto) with_live_values(F f) const;
+
+        // Bit set for elements that are present and not tombstoned
+        Bitmap live_mask() const;
+
+        // Drops elements for which skip(i) is true together with tombstoned ones
+        template <typename Skip>
+        void compact_where(Skip skip);
+
         container_type container;
+        Bitmap tombstones;          // empty unless mark_removed() was used
+        size_type tombstone_count = 0;
+        Bitmap valid_bits;          // empty unless the sample has missing values
+        size_type missing_count = 0;
     };
 
     template <typename T>
     inline NumericSample<T>::NumericSample(const NumericSample<T> &other)
     {
         this->container = other.container; 
+        this->tombstones = other.tombstones;
+        this->tombstone_count = other.tombstone_count;
+        this->valid_bits = other.valid_bits;
+        this->missing_count = other.missing_count;
+    }
+
+    template <typename T>
+    inline NumericSample<T>::NumericSample(container_type vec, Bitmap validity)
+        : container(std::move(vec)), valid_bits(std::move(validity))
+    {
+        if (!valid_bits.empty() && valid_bits.size() != container.size())
+            throw std::invalid_argument("NumericSample: validity bitmap size mismatch");
+
+        missing_count = valid_bits.empty() ? 0 : container.size() - valid_bits.count();
+        if (missing_count == 0) valid_bits.clear();
     }
 
     template <typename T>
@@ -119,6 +183,10 @@ namespace nr
         if(this != &other) 
         {
             this->container = other.container;     
+            this->tombstones = other.tombstones;
+            this->tombstone_count = other.tombstone_count;
+            this->valid_bits = other.valid_bits;
+            this->missing_count = other.missing_count;
         }
         return *this; 
     }
@@ -127,6 +195,14 @@ namespace nr
     inline NumericSample<T>::NumericSample(NumericSample<T> &&other) noexcept
     {
         this->container = std::move(other.container);
+        this->tombstones = std::move(other.tombstones);
+        this->tombstone_count = other.tombstone_count;
+        this->valid_bits = std::move(other.valid_bits);
+        this->missing_count = other.missing_count;
+        other.tombstones.clear();
+        other.tombstone_count = 0;
+        other.valid_bits.clear();
+        other.missing_count = 0;
     }
 
     template <typename T>
@@ -135,6 +211,14 @@ namespace nr
         if (this != &other) 
         {
             this->container = std::move(other.container);
+            this->tombstones = std::move(other.tombstones);
+            this->tombstone_count = other.tombstone_count;
+            this->valid_bits = std::move(other.valid_bits);
+            this->missing_count = other.missing_count;
+            other.tombstones.clear();
+            other.tombstone_count = 0;
+            other.valid_bits.clear();
+            other.missing_count = 0;
         }
         return *this;
     }
@@ -155,26 +239,218 @@ namespace nr
     inline void NumericSample<T>::push_back(value_type value)
     {
         container.push_back(value);
+        if (!tombstones.empty()) tombstones.push_back(false);
+        if (!valid_bits.empty()) valid_bits.push_back(true);
+    }
+
+    template <typename T>
+    inline void NumericSample<T>::push_na()
+    {
+        if (valid_bits.empty()) valid_bits.resize(container.size(), true);
+        container.push_back(value_type{});
+        valid_bits.push_back(false);
+        if (!tombstones.empty()) tombstones.push_back(false);
+        ++missing_count;
     }
 
     template <typename T>
     inline void NumericSample<T>::add(value_type element)
     {
-        this->container.push_back(element);
+        push_back(element);
     }
 
     template <typename T>
     inline void NumericSample<T>::add(container_type elements) 
     {
         this->container.insert(this->container.end(), elements.begin(), elements.end());
+        if (!tombstones.empty()) tombstones.resize(container.size(), false);
+        if (!valid_bits.empty()) valid_bits.resize(container.size(), true);
     }
 
     template <typename T>
     inline void NumericSample<T>::remove_at(size_t index)
     {
+        if (!tombstones.empty())
+        {
+            if (tombstones.test(index)) --tombstone_count;
+            tombstones.erase(index);
+        }
+        if (!valid_bits.empty())
+        {
+            if (!valid_bits.test(index)) --missing_count;
+            valid_bits.erase(index);
+        }
         this->container.erase(this->container.begin() + index);
     }
 
+    template <typename T>
+    template <typename Predicate>
+    inline typename NumericSample<T>::size_type NumericSample<T>::remove_if(Predicate pred)
+    {
+        // Missing values are kept and never passed to pred
+        size_type removed = 0;
+        compact_where([&](size_type i) {
+            if (missing_count != 0 && !valid_bits[i]) return false;
+            if (!pred(container[i])) return false;
+            ++removed;
+            return true;
+        });
+        return removed;
+    }
+
+    template <typename T>
+    inline void NumericSample<T>::remove_indices(const std::vector<size_type>& sorted_indices)
+    {
+        // Validate up front so that a bad index leaves the sample untouched
+        const size_type n = container.size();
+        for (size_type k = 0; k < sorted_indices.size(); ++k)
+        {
+            if (sorted_indices[k] >= n)
+                throw std::out_of_range("remove_indices: index out of range");
+            if (k > 0 && sorted_indices[k] <= sorted_indices[k - 1])
+                throw std::invalid_argument("remove_indices: indices must be sorted and unique");
+        }
+
+        size_type next = 0;
+        compact_where([&](size_type i) {
+            if (next < sorted_indices.size() && sorted_indices[next] == i)
+            {
+                ++next;
+                return true;
+            }
+            return false;
+        });
+    }
+
+    template <typename T>
+    inline void NumericSample<T>::mark_removed(size_type index)
+    {
+        if (index >= container.size())
+            throw std::out_of_range("mark_removed: index out of range");
+
+        if (tombstones.empty()) tombstones.resize(container.size(), false);
+        if (!tombstones[index])
+        {
+            tombstones.set(index);
+            ++tombstone_count;
+        }
+    }
+
+    template <typename T>
+    inline bool NumericSample<T>::is_removed(size_type index) const
+    {
+        if (index >= container.size())
+            throw std::out_of_range("is_removed: index out of range");
+        return !tombstones.empty() && tombstones[index];
+    }
+
+    template <typename T>
+    inline typename NumericSample<T>::size_type NumericSample<T>::removed_count() const noexcept
+    {
+        return tombstone_count;
+    }
+
+    template <typename T>
+    inline typename NumericSample<T>::size_type NumericSample<T>::live_size() const noexcept
+    {
+        return container.size() - tombstone_count;
+    }
+
+    template <typename T>
+    inline void NumericSample<T>::compact()
+    {
+        if (tombstone_count == 0)
+        {
+            tombstones.clear();
+            return;
+        }
+        compact_where([](size_type) { return false; });
+    }
+
+    template <typename T>
+    inline bool NumericSample<T>::is_na(size_type index) const
+    {
+        if (index >= container.size())
+            throw std::out_of_range("is_na: index out of range");
+        return !valid_bits.empty() && !valid_bits[index];
+    }
+
+    template <typename T>
+    inline typename NumericSample<T>::size_type NumericSample<T>::na_count() const noexcept
+    {
+        return missing_count;
+    }
+
+    template <typename T>
+    inline const Bitmap& NumericSample<T>::validity() const noexcept
+    {
+        return valid_bits;
+    }
+
+    template <typename T>
+    template <typename Skip>
+    inline void NumericSample<T>::compact_where(Skip skip)
+    {
+        // Single pass: survivors (and their validity bits) are moved down over
+        // removed and tombstoned slots
+        const size_type n = container.size();
+        const bool has_tombstones = tombstone_count != 0;
+        const bool has_validity = !valid_bits.empty();
+        size_type out = 0;
+
+        for (size_type i = 0; i < n; ++i)
+        {
+            if (skip(i)) continue;
+            if (has_tombstones && tombstones[i]) continue;
+            if (out != i)
+            {
+                container[out] = std::move(container[i]);
+                if (has_validity) valid_bits.set(out, valid_bits[i]);
+            }
+            ++out;
+        }
+
+        container.resize(out);
+        tombstones.clear();
+        tombstone_count = 0;
+        if (has_validity)
+        {
+            valid_bits.resize(out);
+            missing_count = out - valid_bits.count();
+            if (missing_count == 0) valid_bits.clear();
+        }
+    }
+
+    template <typename T>
+    inline Bitmap NumericSample<T>::live_mask() const
+    {
+        Bitmap mask = valid_bits.empty() ? Bitmap(container.size(), true) : valid_bits;
+        if (tombstone_count != 0)
+        {
+            Bitmap alive = tombstones;
+            alive.flip();
+            mask &= alive;
+        }
+        return mask;
+    }
+
+    template <typename T>
+    template <typename F>
+    inline decltype(auto) NumericSample<T>::with_live_values(F f) const
+    {
+        if (tombstone_count == 0 && missing_count == 0)
+            return f(container);
+
+        // Gather the live values run by run, a word of flags at a time
+        Bitmap mask = live_mask();
+        container_type live;
+        live.reserve(mask.count());
+        mask.for_each_run([&](size_type b, size_type e) {
+            live.insert(live.end(), container.begin() + b, container.begin() + e);
+        });
+        return f(live);
+    }
+
     template <typename T>
     inline const T& NumericSample<T>::at(size_type index) const
     {
@@ -191,6 +467,10 @@ namespace nr
     inline void NumericSample<T>::clear()
     {
         this->container.clear();
+        this->tombstones.clear();
+        this->tombstone_count = 0;
+        this->valid_bits.clear();
+        this->missing_count = 0;
     }
 
     template <typename T>
@@ -268,78 +548,94 @@ namespace nr
     template <typename T>
     inline T NumericSample<T>::min() const
     {
-        return nr::min(this->container);
+        return with_live_values([](const container_type& c) { return nr::min(c); });
     }
 
     template <typename T>
     inline T NumericSample<T>::max() const
     {
-        return nr::max(this->container);
+        return with_live_values([](const container_type& c) { return nr::max(c); });
     }
     template <typename T>
     inline T NumericSample<T>::arithmetic_mean() const
     {
-        return nr::arithmetic_mean(this->container);
+        return with_live_values([](const container_type& c) { return nr::arithmetic_mean(c); });
     }
     template <typename T>
     inline T NumericSample<T>::median() const
     {
-        return nr::median(this->container);
+        return with_live_values([](const container_type& c) { return nr::median(c); });
     }
     template <typename T>
     inline typename NumericSample<T>::value_type NumericSample<T>::geometric_mean() const
     {
-        return nr::geometric_mean(container);
+        return with_live_values([](const container_type& c) { return nr::geometric_mean(c); });
     }
     template <typename T>
     inline typename NumericSample<T>::value_type NumericSample<T>::harmonic_mean() const
     {
-        return nr::harmonic_mean(container);
+        return with_live_values([](const container_type& c) { return nr::harmonic_mean(c); });
     }
     template <typename T>
     inline typename NumericSample<T>::value_type NumericSample<T>::lower_quartile() const
     {
-        return nr::lower_quartile(container);
+        return with_live_values([](const container_type& c) { return nr::lower_quartile(c); });
     }
     template <typename T>
     inline typename NumericSample<T>::value_type NumericSample<T>::upper_quartile() const
     {
-        return nr::upper_quartile(container);
+        return with_live_values([](const container_type& c) { return nr::upper_quartile(c); });
     }
     template <typename T>
     inline auto NumericSample<T>::percentile(double p) const -> std::common_type_t<NumericSample<T>::value_type, double>
     {
-        return nr::percentile(container, p);
+        return with_live_values([p](const container_type& c) { return nr::percentile(c, p); });
     }
     template <typename T>
     inline std::optional<typename NumericSample<T>::value_type> NumericSample<T>::mode() const
     {
-        return nr::mode(container);
+        return with_live_values([](const container_type& c) { return nr::mode(c); });
     }
     template <typename T>
     inline std::vector<typename NumericSample<T>::value_type> NumericSample<T>::modes() const
     {
-        return nr::modes(container);
+        return with_live_values([](const container_type& c) { return nr::modes(c); });
     }
     template <typename T>
     inline typename NumericSample<T>::value_type NumericSample<T>::Scope() const
     {
-        return nr::Scope(container);
+        return with_live_values([](const container_type& c) { return nr::Scope(c); });
     }
     template <typename T>
     inline typename NumericSample<T>::value_type NumericSample<T>::interquartile_range() const
     {
-        return nr::interquartile_range(container);
+        return with_live_values([](const container_type& c) { return nr::interquartile_range(c); });
     }
     template <typename T>
     inline auto NumericSample<T>::mean_absolute_deviation() const -> std::common_type_t<NumericSample<T>::value_type, double>
     {
-        return nr::mean_absolute_deviation(container);
+        return with_live_values([](const container_type& c) { return nr::mean_absolute_deviation(c); });
     }
     template <typename T>
     inline typename NumericSample<T>::value_type NumericSample<T>::weighted_mean(container_type weights) const
     {
-        return nr::weighted_mean(container, weights);
+        if (tombstone_count == 0 && missing_count == 0)
+            return nr::weighted_mean(container, weights);
+
+        if (weights.size() != container.size())
+            throw std::invalid_argument("Values and weights must have the same size");
+
+        // weights are aligned with physical indices, drop the tombstoned and missing pairs
+        Bitmap mask = live_mask();
+        container_type live_values;
+        container_type live_weights;
+        live_values.reserve(mask.count());
+        live_weights.reserve(mask.count());
+        mask.for_each_run([&](size_type b, size_type e) {
+            live_values.insert(live_values.end(), container.begin() + b, container.begin() + e);
+            live_weights.insert(live_weights.end(), weights.begin() + b, weights.begin() + e);
+        });
+        return nr::weighted_mean(live_values, live_weights);
     }
 }
 
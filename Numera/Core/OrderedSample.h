@@ -0,0 +1,793 @@
+#ifndef NUMERA_CORE_ORDEREDSAMPLE_H
+#define NUMERA_CORE_ORDEREDSAMPLE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A sorted multiset of numbers with O(log n) order-statistic queries.
+ *
+ * OrderedSample is a counted B+tree: every internal node stores, next to
+ * each child pointer, the number of values in that child's subtree. This
+ * makes insert, erase, kth (select), rank and percentile all O(log n),
+ * so the median or any percentile of a continuously changing sample can be
+ * queried without copying and sorting the data (as NumericSample does).
+ *
+ * Nodes keep their keys, subtree counts and child pointers in fixed
+ * arrays of NodeCapacity entries, so each level of a descent scans one or
+ * two contiguous cache lines instead of chasing a pointer per element.
+ * Leaves are chained, giving ordered iteration in O(1) per step.
+ *
+ * Percentiles use the same linear interpolation (R7) as nr::percentile.
+ *
+ * @tparam T            Arithmetic type of stored values
+ * @tparam NodeCapacity Maximum number of entries per node (>= 4)
+ */
+
+namespace nr
+{
+    template <typename T, std::size_t NodeCapacity = 64>
+    class OrderedSample
+    {
+        static_assert(std::is_arithmetic_v<T>, "OrderedSample requires arithmetic type");
+        static_assert(NodeCapacity >= 4, "OrderedSample: NodeCapacity must be at least 4");
+
+        struct Node
+        {
+            std::size_t count = 0;  // keys in a leaf, children in an internal node
+        };
+
+        // One spare slot lets a node overflow by one entry before it is split
+        struct Leaf : Node
+        {
+            T keys[NodeCapacity + 1];
+            Leaf* next = nullptr;
+        };
+
+        struct Internal : Node
+        {
+            T keys[NodeCapacity + 1];              // lower bound of each child subtree
+            std::size_t sizes[NodeCapacity + 1];   // number of values in each child subtree
+            Node* children[NodeCapacity + 1];
+        };
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            const_iterator() = default;
+
+            reference operator*() const { return leaf->keys[pos]; }
+            pointer operator->() const { return &leaf->keys[pos]; }
+
+            const_iterator& operator++()
+            {
+                if (++pos == leaf->count)
+                {
+                    leaf = leaf->next;
+                    pos = 0;
+                }
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator==(const const_iterator& other) const { return leaf == other.leaf && pos == other.pos; }
+            bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+        private:
+            friend class OrderedSample;
+            const_iterator(const Leaf* leaf, size_type pos) : leaf(leaf), pos(pos) {}
+
+            const Leaf* leaf = nullptr;
+            size_type pos = 0;
+        };
+
+        using iterator = const_iterator;
+
+        OrderedSample();
+        template <typename Iterator>
+        OrderedSample(Iterator begin, Iterator end);
+        explicit OrderedSample(std::vector<T> values);
+        OrderedSample(const OrderedSample& other);
+        OrderedSample(OrderedSample&& other) noexcept;
+        OrderedSample& operator=(const OrderedSample& other);
+        OrderedSample& operator=(OrderedSample&& other) noexcept;
+        ~OrderedSample();
+
+        /// Inserts a value (duplicates allowed), O(log n)
+        void insert(value_type value);
+
+        /// Removes one occurrence of value, returns false if it is not present, O(log n)
+        bool erase(value_type value);
+
+        /// Removes the value at sorted position index, O(log n)
+        void erase_at(size_type index);
+
+        size_type size() const noexcept;
+        bool empty() const noexcept;
+        void clear();
+
+        /// k-th smallest value, 0-based (throws if out of range)
+        const value_type& kth(size_type k) const;
+
+        /// Number of values strictly less than x
+        size_type rank(value_type x) const;
+
+        /// Number of values equal to x
+        size_type count(value_type x) const;
+        bool contains(value_type x) const;
+
+        value_type min() const;
+        value_type max() const;
+        value_type median() const;
+        auto percentile(double p) const -> std::common_type_t<value_type, double>;
+
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cbegin() const noexcept;
+        const_iterator cend() const noexcept;
+
+    private:
+        static constexpr size_type min_fill = NodeCapacity / 4 > 0 ? NodeCapacity / 4 : 1;
+
+        struct Split
+        {
+            Node* right = nullptr;
+            T key{};
+            size_type right_size = 0;
+        };
+
+        bool insert_into(Node* node, size_type height, const T& value, Split& split);
+        void erase_from(Node* node, size_type height, size_type index);
+        void rebalance_child(Internal* parent, size_type child, size_type child_height);
+        size_type count_not_greater(const T& x) const;
+
+        void build_sorted(const std::vector<T>& sorted);
+        static void destroy(Node* node, size_type height) noexcept;
+        const Leaf* leftmost_leaf() const noexcept;
+
+        Node* root = nullptr;
+        size_type height = 0;       // 0 when the root is a leaf
+        size_type total = 0;
+    };
+
+    template <typename T, std::size_t NodeCapacity>
+    inline OrderedSample<T, NodeCapacity>::OrderedSample()
+        : root(new Leaf())
+    {
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    template <typename Iterator>
+    inline OrderedSample<T, NodeCapacity>::OrderedSample(Iterator begin, Iterator end)
+    {
+        std::vector<T> values(begin, end);
+        std::sort(values.begin(), values.end());
+        build_sorted(values);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline OrderedSample<T, NodeCapacity>::OrderedSample(std::vector<T> values)
+    {
+        std::sort(values.begin(), values.end());
+        build_sorted(values);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline OrderedSample<T, NodeCapacity>::OrderedSample(const OrderedSample& other)
+    {
+        // Rebuilding from the ordered sequence is O(n) and yields compact nodes
+        build_sorted(std::vector<T>(other.begin(), other.end()));
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline OrderedSample<T, NodeCapacity>::OrderedSample(OrderedSample&& other) noexcept
+        : root(other.root), height(other.height), total(other.total)
+    {
+        other.root = nullptr;
+        other.height = 0;
+        other.total = 0;
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline OrderedSample<T, NodeCapacity>& OrderedSample<T, NodeCapacity>::operator=(const OrderedSample& other)
+    {
+        if (this != &other)
+        {
+            OrderedSample copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline OrderedSample<T, NodeCapacity>& OrderedSample<T, NodeCapacity>::operator=(OrderedSample&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy(root, height);
+            root = other.root;
+            height = other.height;
+            total = other.total;
+            other.root = nullptr;
+            other.height = 0;
+            other.total = 0;
+        }
+        return *this;
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline OrderedSample<T, NodeCapacity>::~OrderedSample()
+    {
+        destroy(root, height);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline void OrderedSample<T, NodeCapacity>::insert(value_type value)
+    {
+        if (root == nullptr) root = new Leaf();
+
+        Split split;
+        if (insert_into(root, height, value, split))
+        {
+            // The root overflowed: grow the tree by one level
+            auto* new_root = new Internal();
+            new_root->count = 2;
+            new_root->children[0] = root;
+            new_root->children[1] = split.right;
+            new_root->keys[0] = height == 0 ? static_cast<Leaf*>(root)->keys[0]
+                                            : static_cast<Internal*>(root)->keys[0];
+            new_root->keys[1] = split.key;
+            new_root->sizes[1] = split.right_size;
+            new_root->sizes[0] = total + 1 - split.right_size;
+            root = new_root;
+            ++height;
+        }
+        ++total;
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline bool OrderedSample<T, NodeCapacity>::erase(value_type value)
+    {
+        size_type pos = rank(value);
+        if (pos >= total || kth(pos) != value)
+            return false;
+        erase_at(pos);
+        return true;
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline void OrderedSample<T, NodeCapacity>::erase_at(size_type index)
+    {
+        if (index >= total)
+            throw std::out_of_range("OrderedSample::erase_at: index out of range");
+
+        erase_from(root, height, index);
+        --total;
+
+        // Collapse a root that is left with a single child
+        while (height > 0 && root->count == 1)
+        {
+            auto* old_root = static_cast<Internal*>(root);
+            root = old_root->children[0];
+            delete old_root;
+            --height;
+        }
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline typename OrderedSample<T, NodeCapacity>::size_type OrderedSample<T, NodeCapacity>::size() const noexcept
+    {
+        return total;
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline bool OrderedSample<T, NodeCapacity>::empty() const noexcept
+    {
+        return total == 0;
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline void OrderedSample<T, NodeCapacity>::clear()
+    {
+        destroy(root, height);
+        root = new Leaf();
+        height = 0;
+        total = 0;
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline const T& OrderedSample<T, NodeCapacity>::kth(size_type k) const
+    {
+        if (k >= total)
+            throw std::out_of_range("OrderedSample::kth: index out of range");
+
+        const Node* node = root;
+        for (size_type h = height; h > 0; --h)
+        {
+            const auto* in = static_cast<const Internal*>(node);
+            size_type i = 0;
+            while (k >= in->sizes[i])
+            {
+                k -= in->sizes[i];
+                ++i;
+            }
+            node = in->children[i];
+        }
+        return static_cast<const Leaf*>(node)->keys[k];
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline typename OrderedSample<T, NodeCapacity>::size_type OrderedSample<T, NodeCapacity>::rank(value_type x) const
+    {
+        // Children before the last one whose lower bound is < x hold only values < x,
+        // children after it hold only values >= x
+        if (total == 0) return 0;
+
+        size_type result = 0;
+        const Node* node = root;
+        for (size_type h = height; h > 0; --h)
+        {
+            const auto* in = static_cast<const Internal*>(node);
+            size_type i = static_cast<size_type>(std::lower_bound(in->keys + 1, in->keys + in->count, x) - in->keys) - 1;
+            for (size_type j = 0; j < i; ++j)
+                result += in->sizes[j];
+            node = in->children[i];
+        }
+        const auto* leaf = static_cast<const Leaf*>(node);
+        return result + static_cast<size_type>(std::lower_bound(leaf->keys, leaf->keys + leaf->count, x) - leaf->keys);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline typename OrderedSample<T, NodeCapacity>::size_type OrderedSample<T, NodeCapacity>::count(value_type x) const
+    {
+        return count_not_greater(x) - rank(x);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline bool OrderedSample<T, NodeCapacity>::contains(value_type x) const
+    {
+        size_type pos = rank(x);
+        return pos < total && kth(pos) == x;
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline T OrderedSample<T, NodeCapacity>::min() const
+    {
+        if (total == 0) throw std::invalid_argument("min: empty container");
+        return kth(0);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline T OrderedSample<T, NodeCapacity>::max() const
+    {
+        if (total == 0) throw std::invalid_argument("max: empty container");
+        return kth(total - 1);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline T OrderedSample<T, NodeCapacity>::median() const
+    {
+        if (total == 0) throw std::invalid_argument("median: empty container");
+
+        if (total % 2 == 1)
+            return kth(total / 2);
+        return (kth(total / 2 - 1) + kth(total / 2)) / static_cast<T>(2);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline auto OrderedSample<T, NodeCapacity>::percentile(double p) const -> std::common_type_t<value_type, double>
+    {
+        if (total == 0)
+            throw std::invalid_argument("percentile: empty data");
+
+        if (p < 0.0 || p > 100.0)
+            throw std::out_of_range("percentile: p must be in [0, 100]");
+
+        const double pos = (p / 100.0) * (total - 1);
+        const size_type idx = static_cast<size_type>(std::floor(pos));
+        const double frac = pos - idx;
+
+        if (idx + 1 < total)
+            return kth(idx) * (1.0 - frac) + kth(idx + 1) * frac;
+        else
+            return kth(idx);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline typename OrderedSample<T, NodeCapacity>::const_iterator OrderedSample<T, NodeCapacity>::begin() const noexcept
+    {
+        if (total == 0) return end();
+        return const_iterator(leftmost_leaf(), 0);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline typename OrderedSample<T, NodeCapacity>::const_iterator OrderedSample<T, NodeCapacity>::end() const noexcept
+    {
+        return const_iterator(nullptr, 0);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline typename OrderedSample<T, NodeCapacity>::const_iterator OrderedSample<T, NodeCapacity>::cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline typename OrderedSample<T, NodeCapacity>::const_iterator OrderedSample<T, NodeCapacity>::cend() const noexcept
+    {
+        return end();
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline bool OrderedSample<T, NodeCapacity>::insert_into(Node* node, size_type h, const T& value, Split& split)
+    {
+        if (h == 0)
+        {
+            auto* leaf = static_cast<Leaf*>(node);
+            size_type pos = static_cast<size_type>(std::upper_bound(leaf->keys, leaf->keys + leaf->count, value) - leaf->keys);
+            std::copy_backward(leaf->keys + pos, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+            leaf->keys[pos] = value;
+            ++leaf->count;
+
+            if (leaf->count <= NodeCapacity)
+                return false;
+
+            // Overflow: move the upper half into a new right sibling
+            auto* right = new Leaf();
+            size_type keep = leaf->count / 2;
+            right->count = leaf->count - keep;
+            std::copy(leaf->keys + keep, leaf->keys + leaf->count, right->keys);
+            leaf->count = keep;
+            right->next = leaf->next;
+            leaf->next = right;
+
+            split.right = right;
+            split.key = right->keys[0];
+            split.right_size = right->count;
+            return true;
+        }
+
+        auto* in = static_cast<Internal*>(node);
+        size_type i = static_cast<size_type>(std::upper_bound(in->keys + 1, in->keys + in->count, value) - in->keys) - 1;
+        if (i == 0 && value < in->keys[0])
+            in->keys[0] = value;
+
+        Split child_split;
+        bool child_overflow = insert_into(in->children[i], h - 1, value, child_split);
+        ++in->sizes[i];
+
+        if (!child_overflow)
+            return false;
+
+        // Register the new sibling right after child i
+        for (size_type j = in->count; j > i + 1; --j)
+        {
+            in->keys[j] = in->keys[j - 1];
+            in->sizes[j] = in->sizes[j - 1];
+            in->children[j] = in->children[j - 1];
+        }
+        in->keys[i + 1] = child_split.key;
+        in->sizes[i + 1] = child_split.right_size;
+        in->children[i + 1] = child_split.right;
+        in->sizes[i] -= child_split.right_size;
+        ++in->count;
+
+        if (in->count <= NodeCapacity)
+            return false;
+
+        auto* right = new Internal();
+        size_type keep = in->count / 2;
+        right->count = in->count - keep;
+        size_type moved = 0;
+        for (size_type j = 0; j < right->count; ++j)
+        {
+            right->keys[j] = in->keys[keep + j];
+            right->sizes[j] = in->sizes[keep + j];
+            right->children[j] = in->children[keep + j];
+            moved += right->sizes[j];
+        }
+        in->count = keep;
+
+        split.right = right;
+        split.key = right->keys[0];
+        split.right_size = moved;
+        return true;
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline void OrderedSample<T, NodeCapacity>::erase_from(Node* node, size_type h, size_type index)
+    {
+        if (h == 0)
+        {
+            auto* leaf = static_cast<Leaf*>(node);
+            std::copy(leaf->keys + index + 1, leaf->keys + leaf->count, leaf->keys + index);
+            --leaf->count;
+            return;
+        }
+
+        auto* in = static_cast<Internal*>(node);
+        size_type i = 0;
+        while (index >= in->sizes[i])
+        {
+            index -= in->sizes[i];
+            ++i;
+        }
+
+        erase_from(in->children[i], h - 1, index);
+        --in->sizes[i];
+        rebalance_child(in, i, h - 1);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline void OrderedSample<T, NodeCapacity>::rebalance_child(Internal* parent, size_type child, size_type child_height)
+    {
+        if (parent->children[child]->count >= min_fill || parent->count < 2)
+            return;
+
+        size_type li = child + 1 < parent->count ? child : child - 1;
+        size_type ri = li + 1;
+        Node* left = parent->children[li];
+        Node* right = parent->children[ri];
+
+        if (left->count + right->count <= NodeCapacity)
+        {
+            // Merge right into left and drop right from the parent
+            if (child_height == 0)
+            {
+                auto* l = static_cast<Leaf*>(left);
+                auto* r = static_cast<Leaf*>(right);
+                std::copy(r->keys, r->keys + r->count, l->keys + l->count);
+                l->count += r->count;
+                l->next = r->next;
+                delete r;
+            }
+            else
+            {
+                auto* l = static_cast<Internal*>(left);
+                auto* r = static_cast<Internal*>(right);
+                for (size_type j = 0; j < r->count; ++j)
+                {
+                    l->keys[l->count + j] = r->keys[j];
+                    l->sizes[l->count + j] = r->sizes[j];
+                    l->children[l->count + j] = r->children[j];
+                }
+                l->count += r->count;
+                delete r;
+            }
+
+            parent->sizes[li] += parent->sizes[ri];
+            for (size_type j = ri; j + 1 < parent->count; ++j)
+            {
+                parent->keys[j] = parent->keys[j + 1];
+                parent->sizes[j] = parent->sizes[j + 1];
+                parent->children[j] = parent->children[j + 1];
+            }
+            --parent->count;
+            return;
+        }
+
+        // Too many entries to merge: split them evenly between the two siblings
+        size_type combined = left->count + right->count;
+        size_type new_left = combined / 2;
+
+        if (child_height == 0)
+        {
+            auto* l = static_cast<Leaf*>(left);
+            auto* r = static_cast<Leaf*>(right);
+            if (l->count < new_left)
+            {
+                size_type shift = new_left - l->count;
+                std::copy(r->keys, r->keys + shift, l->keys + l->count);
+                std::copy(r->keys + shift, r->keys + r->count, r->keys);
+            }
+            else
+            {
+                size_type shift = l->count - new_left;
+                std::copy_backward(r->keys, r->keys + r->count, r->keys + r->count + shift);
+                std::copy(l->keys + new_left, l->keys + l->count, r->keys);
+            }
+            l->count = new_left;
+            r->count = combined - new_left;
+            parent->sizes[li] = l->count;
+            parent->sizes[ri] = r->count;
+            parent->keys[ri] = r->keys[0];
+        }
+        else
+        {
+            auto* l = static_cast<Internal*>(left);
+            auto* r = static_cast<Internal*>(right);
+            size_type moved = 0;
+            if (l->count < new_left)
+            {
+                size_type shift = new_left - l->count;
+                for (size_type j = 0; j < shift; ++j)
+                {
+                    l->keys[l->count + j] = r->keys[j];
+                    l->sizes[l->count + j] = r->sizes[j];
+                    l->children[l->count + j] = r->children[j];
+                    moved += r->sizes[j];
+                }
+                for (size_type j = shift; j < r->count; ++j)
+                {
+                    r->keys[j - shift] = r->keys[j];
+                    r->sizes[j - shift] = r->sizes[j];
+                    r->children[j - shift] = r->children[j];
+                }
+                parent->sizes[li] += moved;
+                parent->sizes[ri] -= moved;
+            }
+            else
+            {
+                size_type shift = l->count - new_left;
+                for (size_type j = r->count; j-- > 0;)
+                {
+                    r->keys[j + shift] = r->keys[j];
+                    r->sizes[j + shift] = r->sizes[j];
+                    r->children[j + shift] = r->children[j];
+                }
+                for (size_type j = 0; j < shift; ++j)
+                {
+                    r->keys[j] = l->keys[new_left + j];
+                    r->sizes[j] = l->sizes[new_left + j];
+                    r->children[j] = l->children[new_left + j];
+                    moved += r->sizes[j];
+                }
+                parent->sizes[li] -= moved;
+                parent->sizes[ri] += moved;
+            }
+            l->count = new_left;
+            r->count = combined - new_left;
+            parent->keys[ri] = r->keys[0];
+        }
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline typename OrderedSample<T, NodeCapacity>::size_type OrderedSample<T, NodeCapacity>::count_not_greater(const T& x) const
+    {
+        if (total == 0) return 0;
+
+        size_type result = 0;
+        const Node* node = root;
+        for (size_type h = height; h > 0; --h)
+        {
+            const auto* in = static_cast<const Internal*>(node);
+            size_type i = static_cast<size_type>(std::upper_bound(in->keys + 1, in->keys + in->count, x) - in->keys) - 1;
+            for (size_type j = 0; j < i; ++j)
+                result += in->sizes[j];
+            node = in->children[i];
+        }
+        const auto* leaf = static_cast<const Leaf*>(node);
+        return result + static_cast<size_type>(std::upper_bound(leaf->keys, leaf->keys + leaf->count, x) - leaf->keys);
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline void OrderedSample<T, NodeCapacity>::build_sorted(const std::vector<T>& sorted)
+    {
+        // Bulk load bottom-up, leaving a quarter of every node free for inserts
+        const size_type fill = std::max<size_type>(min_fill, NodeCapacity * 3 / 4);
+        const size_type n = sorted.size();
+
+        root = nullptr;
+        height = 0;
+        total = n;
+
+        if (n <= fill)
+        {
+            auto* leaf = new Leaf();
+            std::copy(sorted.begin(), sorted.end(), leaf->keys);
+            leaf->count = n;
+            root = leaf;
+            return;
+        }
+
+        std::vector<Node*> level;
+        std::vector<T> level_keys;
+        std::vector<size_type> level_sizes;
+
+        size_type leaves = (n + fill - 1) / fill;
+        Leaf* previous = nullptr;
+        size_type offset = 0;
+        for (size_type i = 0; i < leaves; ++i)
+        {
+            // Spread the remainder so that no leaf ends up underfull
+            size_type take = n / leaves + (i < n % leaves ? 1 : 0);
+            auto* leaf = new Leaf();
+            std::copy(sorted.begin() + offset, sorted.begin() + offset + take, leaf->keys);
+            leaf->count = take;
+            if (previous) previous->next = leaf;
+            previous = leaf;
+            offset += take;
+
+            level.push_back(leaf);
+            level_keys.push_back(leaf->keys[0]);
+            level_sizes.push_back(take);
+        }
+
+        while (level.size() > 1)
+        {
+            std::vector<Node*> parents;
+            std::vector<T> parent_keys;
+            std::vector<size_type> parent_sizes;
+
+            size_type m = level.size();
+            size_type groups = (m + fill - 1) / fill;
+            size_type pos = 0;
+            for (size_type g = 0; g < groups; ++g)
+            {
+                size_type take = m / groups + (g < m % groups ? 1 : 0);
+                auto* in = new Internal();
+                size_type subtotal = 0;
+                for (size_type j = 0; j < take; ++j)
+                {
+                    in->children[j] = level[pos + j];
+                    in->keys[j] = level_keys[pos + j];
+                    in->sizes[j] = level_sizes[pos + j];
+                    subtotal += level_sizes[pos + j];
+                }
+                in->count = take;
+                pos += take;
+
+                parents.push_back(in);
+                parent_keys.push_back(in->keys[0]);
+                parent_sizes.push_back(subtotal);
+            }
+
+            level = std::move(parents);
+            level_keys = std::move(parent_keys);
+            level_sizes = std::move(parent_sizes);
+            ++height;
+        }
+
+        root = level.front();
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline void OrderedSample<T, NodeCapacity>::destroy(Node* node, size_type h) noexcept
+    {
+        if (node == nullptr) return;
+
+        if (h == 0)
+        {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+
+        auto* in = static_cast<Internal*>(node);
+        for (size_type i = 0; i < in->count; ++i)
+            destroy(in->children[i], h - 1);
+        delete in;
+    }
+
+    template <typename T, std::size_t NodeCapacity>
+    inline const typename OrderedSample<T, NodeCapacity>::Leaf* OrderedSample<T, NodeCapacity>::leftmost_leaf() const noexcept
+    {
+        const Node* node = root;
+        for (size_type h = height; h > 0; --h)
+            node = static_cast<const Internal*>(node)->children[0];
+        return static_cast<const Leaf*>(node);
+    }
+}
+
+#endif // NUMERA_CORE_ORDEREDSAMPLE_H
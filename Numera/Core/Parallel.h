@@ -0,0 +1,78 @@
+#ifndef NUMERA_CORE_PARALLEL_H
+#define NUMERA_CORE_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Minimal data-parallel loop over row ranges.
+ *
+ * parallel_tasks() runs a fixed number of independent tasks on their
+ * own threads. parallel_chunks() splits [0, n) into one contiguous
+ * chunk per thread. Chunk boundaries are multiples of 64, so threads
+ * that set bits of a shared Bitmap never write to the same word, and
+ * the same (n, threads) always yields the same chunks, so a second pass
+ * can reuse per-chunk results of the first one. An exception thrown by a task is rethrown
+ * on the calling thread after all workers have finished.
+ */
+
+namespace nr
+{
+    namespace detail
+    {
+        /// Threads worth starting for n rows: requested (0 = hardware_concurrency()),
+        /// at most one per min_rows rows and at least one
+        inline std::size_t worker_count(std::size_t requested, std::size_t n, std::size_t min_rows = 16384)
+        {
+            if (requested == 0) requested = std::max(1u, std::thread::hardware_concurrency());
+            return std::max<std::size_t>(1, std::min(requested, n / min_rows));
+        }
+
+        /// Runs task(i) for every i in [0, tasks), one thread per task
+        template <typename Task>
+        void parallel_tasks(std::size_t tasks, Task task)
+        {
+            if (tasks <= 1) {
+                if (tasks == 1) task(std::size_t{0});
+                return;
+            }
+
+            std::vector<std::thread> workers;
+            std::vector<std::exception_ptr> errors(tasks);
+            workers.reserve(tasks);
+            for (std::size_t i = 0; i < tasks; ++i) {
+                workers.emplace_back([&, i]() {
+                    try {
+                        task(i);
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                    }
+                });
+            }
+            for (auto& w : workers) w.join();
+            for (auto& e : errors)
+                if (e) std::rethrow_exception(e);
+        }
+
+        /// Runs body(begin, end, chunk) for every chunk of [0, n), chunk < threads
+        template <typename Body>
+        void parallel_chunks(std::size_t n, std::size_t threads, Body body)
+        {
+            std::size_t chunk = threads <= 1 ? n : (n + threads - 1) / threads;
+            chunk = (chunk + 63) / 64 * 64;
+            if (threads <= 1 || chunk >= n) {
+                body(std::size_t{0}, n, std::size_t{0});
+                return;
+            }
+
+            parallel_tasks((n + chunk - 1) / chunk, [&](std::size_t t) {
+                body(t * chunk, std::min(n, (t + 1) * chunk), t);
+            });
+        }
+    }
+}
+
+#endif // NUMERA_CORE_PARALLEL_H
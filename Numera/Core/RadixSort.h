@@ -0,0 +1,66 @@
+#ifndef NUMERA_CORE_RADIXSORT_H
+#define NUMERA_CORE_RADIXSORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Stable LSD radix sort of row indices by 64-bit unsigned keys.
+ *
+ * Keys are sorted a byte at a time from the least significant byte up.
+ * The histograms of all eight bytes are built in one pass over the keys,
+ * and bytes that are equal for every key are skipped, so narrow keys
+ * (dictionary ranks, booleans, small integers) cost only the passes
+ * their value range needs.
+ *
+ * Signed and descending keys are mapped onto unsigned order by the
+ * caller (flip the sign bit, then complement for descending order).
+ */
+
+namespace nr
+{
+    namespace detail
+    {
+        /// Reorders rows so that keys[rows[i]] is non-decreasing; rows with equal
+        /// keys keep their relative order
+        inline void radix_sort_rows(const std::uint64_t* keys, std::vector<std::size_t>& rows)
+        {
+            const std::size_t n = rows.size();
+            if (n < 2) return;
+
+            // Keys travel with their rows so every pass reads sequentially
+            std::vector<std::uint64_t> key(n), key_scratch(n);
+            std::vector<std::size_t> row_scratch(n);
+            for (std::size_t i = 0; i < n; ++i)
+                key[i] = keys[rows[i]];
+
+            std::vector<std::size_t> counts(8 * 256, 0);
+            for (std::uint64_t k : key)
+                for (int b = 0; b < 8; ++b)
+                    ++counts[b * 256 + ((k >> (8 * b)) & 0xFF)];
+
+            for (int b = 0; b < 8; ++b)
+            {
+                std::size_t* hist = counts.data() + b * 256;
+                if (hist[(key[0] >> (8 * b)) & 0xFF] == n) continue;   // same byte everywhere
+
+                std::size_t offset = 0;
+                for (int d = 0; d < 256; ++d) {
+                    std::size_t c = hist[d];
+                    hist[d] = offset;
+                    offset += c;
+                }
+                for (std::size_t i = 0; i < n; ++i) {
+                    std::size_t dst = hist[(key[i] >> (8 * b)) & 0xFF]++;
+                    key_scratch[dst] = key[i];
+                    row_scratch[dst] = rows[i];
+                }
+                key.swap(key_scratch);
+                rows.swap(row_scratch);
+            }
+        }
+    }
+}
+
+#endif // NUMERA_CORE_RADIXSORT_H
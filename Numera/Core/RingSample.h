@@ -0,0 +1,409 @@
+#ifndef NUMERA_CORE_RINGSAMPLE_H
+#define NUMERA_CORE_RINGSAMPLE_H
+#include "stats/BasicStats.h"
+#include "Core/Span.h"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A fixed-capacity sample that keeps only the last N observations.
+ *
+ * RingSample stores its values in a circular buffer. Once the buffer is full,
+ * push_back() overwrites the oldest value in O(1), which makes it the natural
+ * container for "last N observations" windows (instead of remove_at(0) +
+ * push_back on a NumericSample, which is O(n) per update).
+ *
+ * Logically the sample is ordered from oldest to newest. Physically it is at
+ * most two contiguous segments of the buffer; segments() exposes them as
+ * spans so scans can run over plain memory. The class provides the container
+ * surface used by BasicStats (value_type, size, empty, iterators,
+ * operator[]), so every nr:: statistic accepts a RingSample directly; median,
+ * quartiles and percentiles go through the selection path on a scratch copy.
+ *
+ * @tparam T Type of stored elements
+ * @tparam N Compile-time capacity; 0 selects a capacity given at construction
+ */
+
+namespace nr
+{
+    template <typename T, std::size_t N = 0>
+    class RingSample
+    {
+        template <typename Value>
+        class basic_iterator;
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using container_type = std::conditional_t<N == 0, std::vector<T>, std::array<T, N>>;
+        using iterator = basic_iterator<T>;
+        using const_iterator = basic_iterator<const T>;
+        using segment_type = Span<const T>;
+
+        template <std::size_t M = N, typename = std::enable_if_t<M != 0>>
+        RingSample() : buffer(), head(0), count(0) {}
+
+        template <std::size_t M = N, typename = std::enable_if_t<M == 0>>
+        explicit RingSample(size_type capacity);
+
+        RingSample(const RingSample&) = default;
+        RingSample(RingSample&&) = default;
+        RingSample& operator=(const RingSample&) = default;
+        RingSample& operator=(RingSample&&) = default;
+        ~RingSample() = default;
+
+        /// Appends a value, overwriting the oldest one when the buffer is full (O(1))
+        void push_back(value_type value);
+        void add(value_type value);
+
+        /// Removes the oldest value
+        void pop_front();
+
+        value_type& operator[](size_type index);
+        const value_type& operator[](size_type index) const;
+        const value_type& at(size_type index) const;
+
+        /// Oldest and newest values
+        const value_type& front() const;
+        const value_type& back() const;
+
+        size_type size() const noexcept;
+        size_type capacity() const noexcept;
+        bool empty() const noexcept;
+        bool full() const noexcept;
+        void clear() noexcept;
+
+        /// Contiguous views in logical order: oldest part first, the second may be empty
+        std::pair<segment_type, segment_type> segments() const noexcept;
+
+        /// Copy in logical order (oldest first)
+        std::vector<value_type> to_vector() const;
+
+        value_type min() const;
+        value_type max() const;
+        value_type arithmetic_mean() const;
+        value_type median() const;
+        value_type lower_quartile() const;
+        value_type upper_quartile() const;
+        auto percentile(double p) const -> std::common_type_t<value_type, double>;
+        std::optional<value_type> mode() const;
+        value_type Scope() const;
+        value_type interquartile_range() const;
+
+        iterator begin() noexcept;
+        iterator end() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cbegin() const noexcept;
+        const_iterator cend() const noexcept;
+
+    private:
+        size_type physical(size_type index) const noexcept;
+
+        container_type buffer;
+        size_type head;     // physical index of the oldest value
+        size_type count;
+    };
+
+    template <typename T, std::size_t N>
+    template <typename Value>
+    class RingSample<T, N>::basic_iterator
+    {
+        using ring_pointer = std::conditional_t<std::is_const_v<Value>, const RingSample*, RingSample*>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<Value>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        basic_iterator() = default;
+        basic_iterator(ring_pointer ring, size_type pos) : ring(ring), pos(pos) {}
+
+        // iterator -> const_iterator
+        template <typename Other, typename = std::enable_if_t<std::is_const_v<Value> && !std::is_const_v<Other>>>
+        basic_iterator(const basic_iterator<Other>& other) : ring(other.ring), pos(other.pos) {}
+
+        reference operator*() const { return (*ring)[pos]; }
+        pointer operator->() const { return &(*ring)[pos]; }
+        reference operator[](difference_type n) const { return (*ring)[pos + n]; }
+
+        basic_iterator& operator++() { ++pos; return *this; }
+        basic_iterator operator++(int) { basic_iterator tmp = *this; ++pos; return tmp; }
+        basic_iterator& operator--() { --pos; return *this; }
+        basic_iterator operator--(int) { basic_iterator tmp = *this; --pos; return tmp; }
+        basic_iterator& operator+=(difference_type n) { pos += n; return *this; }
+        basic_iterator& operator-=(difference_type n) { pos -= n; return *this; }
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+        friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+        friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const basic_iterator& a, const basic_iterator& b)
+        {
+            return static_cast<difference_type>(a.pos) - static_cast<difference_type>(b.pos);
+        }
+
+        bool operator==(const basic_iterator& other) const { return pos == other.pos && ring == other.ring; }
+        bool operator!=(const basic_iterator& other) const { return !(*this == other); }
+        bool operator<(const basic_iterator& other) const { return pos < other.pos; }
+        bool operator>(const basic_iterator& other) const { return pos > other.pos; }
+        bool operator<=(const basic_iterator& other) const { return pos <= other.pos; }
+        bool operator>=(const basic_iterator& other) const { return pos >= other.pos; }
+
+    private:
+        template <typename> friend class basic_iterator;
+
+        ring_pointer ring = nullptr;
+        size_type pos = 0;
+    };
+
+    template <typename T, std::size_t N>
+    template <std::size_t M, typename>
+    inline RingSample<T, N>::RingSample(size_type capacity)
+        : buffer(capacity), head(0), count(0)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument("RingSample: capacity must be positive");
+    }
+
+    template <typename T, std::size_t N>
+    inline void RingSample<T, N>::push_back(value_type value)
+    {
+        const size_type cap = buffer.size();
+        if (count < cap)
+        {
+            buffer[physical(count)] = std::move(value);
+            ++count;
+        }
+        else
+        {
+            buffer[head] = std::move(value);
+            head = (head + 1 == cap) ? 0 : head + 1;
+        }
+    }
+
+    template <typename T, std::size_t N>
+    inline void RingSample<T, N>::add(value_type value)
+    {
+        push_back(std::move(value));
+    }
+
+    template <typename T, std::size_t N>
+    inline void RingSample<T, N>::pop_front()
+    {
+        if (count == 0)
+            throw std::out_of_range("pop_front: empty ring");
+        head = (head + 1 == buffer.size()) ? 0 : head + 1;
+        --count;
+    }
+
+    template <typename T, std::size_t N>
+    inline T& RingSample<T, N>::operator[](size_type index)
+    {
+        return buffer[physical(index)];
+    }
+
+    template <typename T, std::size_t N>
+    inline const T& RingSample<T, N>::operator[](size_type index) const
+    {
+        return buffer[physical(index)];
+    }
+
+    template <typename T, std::size_t N>
+    inline const T& RingSample<T, N>::at(size_type index) const
+    {
+        if (index >= count)
+            throw std::out_of_range("at: index out of range");
+        return buffer[physical(index)];
+    }
+
+    template <typename T, std::size_t N>
+    inline const T& RingSample<T, N>::front() const
+    {
+        return at(0);
+    }
+
+    template <typename T, std::size_t N>
+    inline const T& RingSample<T, N>::back() const
+    {
+        if (count == 0)
+            throw std::out_of_range("back: empty ring");
+        return buffer[physical(count - 1)];
+    }
+
+    template <typename T, std::size_t N>
+    inline typename RingSample<T, N>::size_type RingSample<T, N>::size() const noexcept
+    {
+        return count;
+    }
+
+    template <typename T, std::size_t N>
+    inline typename RingSample<T, N>::size_type RingSample<T, N>::capacity() const noexcept
+    {
+        return buffer.size();
+    }
+
+    template <typename T, std::size_t N>
+    inline bool RingSample<T, N>::empty() const noexcept
+    {
+        return count == 0;
+    }
+
+    template <typename T, std::size_t N>
+    inline bool RingSample<T, N>::full() const noexcept
+    {
+        return count == buffer.size();
+    }
+
+    template <typename T, std::size_t N>
+    inline void RingSample<T, N>::clear() noexcept
+    {
+        head = 0;
+        count = 0;
+    }
+
+    template <typename T, std::size_t N>
+    inline std::pair<typename RingSample<T, N>::segment_type, typename RingSample<T, N>::segment_type>
+    RingSample<T, N>::segments() const noexcept
+    {
+        const size_type first_len = std::min(count, buffer.size() - head);
+        segment_type first(buffer.data() + head, first_len);
+        segment_type second(buffer.data(), count - first_len);
+        return {first, second};
+    }
+
+    template <typename T, std::size_t N>
+    inline std::vector<T> RingSample<T, N>::to_vector() const
+    {
+        auto [first, second] = segments();
+        std::vector<T> out;
+        out.reserve(count);
+        out.insert(out.end(), first.begin(), first.end());
+        out.insert(out.end(), second.begin(), second.end());
+        return out;
+    }
+
+    template <typename T, std::size_t N>
+    inline T RingSample<T, N>::min() const
+    {
+        // Scan each contiguous segment separately
+        auto [first, second] = segments();
+        if (first.empty()) throw std::invalid_argument("min: empty container");
+        T result = nr::min(first);
+        return second.empty() ? result : std::min(result, nr::min(second));
+    }
+
+    template <typename T, std::size_t N>
+    inline T RingSample<T, N>::max() const
+    {
+        auto [first, second] = segments();
+        if (first.empty()) throw std::invalid_argument("max: empty container");
+        T result = nr::max(first);
+        return second.empty() ? result : std::max(result, nr::max(second));
+    }
+
+    template <typename T, std::size_t N>
+    inline T RingSample<T, N>::arithmetic_mean() const
+    {
+        auto [first, second] = segments();
+        if (first.empty()) throw std::invalid_argument("arithmetic_mean: empty container");
+        double sum = std::accumulate(first.begin(), first.end(), 0.0);
+        sum = std::accumulate(second.begin(), second.end(), sum);
+        return static_cast<T>(sum / count);
+    }
+
+    template <typename T, std::size_t N>
+    inline T RingSample<T, N>::median() const
+    {
+        return nr::median(*this);
+    }
+
+    template <typename T, std::size_t N>
+    inline T RingSample<T, N>::lower_quartile() const
+    {
+        return nr::lower_quartile(*this);
+    }
+
+    template <typename T, std::size_t N>
+    inline T RingSample<T, N>::upper_quartile() const
+    {
+        return nr::upper_quartile(*this);
+    }
+
+    template <typename T, std::size_t N>
+    inline auto RingSample<T, N>::percentile(double p) const -> std::common_type_t<value_type, double>
+    {
+        return nr::percentile(*this, p);
+    }
+
+    template <typename T, std::size_t N>
+    inline std::optional<T> RingSample<T, N>::mode() const
+    {
+        return nr::mode(*this);
+    }
+
+    template <typename T, std::size_t N>
+    inline T RingSample<T, N>::Scope() const
+    {
+        return max() - min();
+    }
+
+    template <typename T, std::size_t N>
+    inline T RingSample<T, N>::interquartile_range() const
+    {
+        return nr::interquartile_range(*this);
+    }
+
+    template <typename T, std::size_t N>
+    inline typename RingSample<T, N>::iterator RingSample<T, N>::begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    template <typename T, std::size_t N>
+    inline typename RingSample<T, N>::iterator RingSample<T, N>::end() noexcept
+    {
+        return iterator(this, count);
+    }
+
+    template <typename T, std::size_t N>
+    inline typename RingSample<T, N>::const_iterator RingSample<T, N>::begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    template <typename T, std::size_t N>
+    inline typename RingSample<T, N>::const_iterator RingSample<T, N>::end() const noexcept
+    {
+        return const_iterator(this, count);
+    }
+
+    template <typename T, std::size_t N>
+    inline typename RingSample<T, N>::const_iterator RingSample<T, N>::cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    template <typename T, std::size_t N>
+    inline typename RingSample<T, N>::const_iterator RingSample<T, N>::cend() const noexcept
+    {
+        return end();
+    }
+
+    template <typename T, std::size_t N>
+    inline typename RingSample<T, N>::size_type RingSample<T, N>::physical(size_type index) const noexcept
+    {
+        size_type p = head + index;
+        return p >= buffer.size() ? p - buffer.size() : p;
+    }
+}
+
+#endif // NUMERA_CORE_RINGSAMPLE_H
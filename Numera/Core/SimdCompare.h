@@ -0,0 +1,170 @@
+#ifndef NUMERA_CORE_SIMDCOMPARE_H
+#define NUMERA_CORE_SIMDCOMPARE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Column-at-a-time comparison kernels producing bit masks.
+ *
+ * compare_to_words() compares every element of a contiguous array with
+ * a constant and writes one bit per element into 64-bit words (bit j of
+ * word w belongs to element 64*w + j), the layout used by Bitmap.
+ *
+ * Full 64-element blocks are compared with AVX2 (4 lanes) when the
+ * translation unit is built with -mavx2, otherwise with SSE2 (2 lanes)
+ * for doubles; int64 needs AVX2 for a vector compare and uses a
+ * branch-free scalar loop without it. The tail is always scalar.
+ * Comparisons follow C++ operator semantics, including NaN (only !=
+ * holds).
+ */
+
+namespace nr
+{
+    enum class CompareOp
+    {
+        eq,     // ==
+        ne,     // !=
+        lt,     // <
+        le,     // <=
+        gt,     // >
+        ge      // >=
+    };
+
+    namespace detail
+    {
+        template <CompareOp Op, typename T>
+        inline bool compare_scalar(T a, T b) noexcept
+        {
+            if constexpr (Op == CompareOp::eq) return a == b;
+            else if constexpr (Op == CompareOp::ne) return a != b;
+            else if constexpr (Op == CompareOp::lt) return a < b;
+            else if constexpr (Op == CompareOp::le) return a <= b;
+            else if constexpr (Op == CompareOp::gt) return a > b;
+            else return a >= b;
+        }
+
+        template <CompareOp Op, typename T>
+        inline std::uint64_t compare_block_scalar(const T* data, std::size_t count, T value) noexcept
+        {
+            std::uint64_t word = 0;
+            for (std::size_t j = 0; j < count; ++j)
+                word |= static_cast<std::uint64_t>(compare_scalar<Op>(data[j], value)) << j;
+            return word;
+        }
+
+        template <CompareOp Op>
+        inline std::uint64_t compare_block(const double* data, double value) noexcept
+        {
+#if defined(__AVX2__)
+            constexpr int predicate =
+                Op == CompareOp::eq ? _CMP_EQ_OQ :
+                Op == CompareOp::ne ? _CMP_NEQ_UQ :
+                Op == CompareOp::lt ? _CMP_LT_OQ :
+                Op == CompareOp::le ? _CMP_LE_OQ :
+                Op == CompareOp::gt ? _CMP_GT_OQ : _CMP_GE_OQ;
+
+            const __m256d v = _mm256_set1_pd(value);
+            std::uint64_t word = 0;
+            for (int j = 0; j < 64; j += 4)
+            {
+                __m256d x = _mm256_loadu_pd(data + j);
+                auto bits = static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(x, v, predicate)));
+                word |= bits << j;
+            }
+            return word;
+#elif defined(__SSE2__)
+            const __m128d v = _mm_set1_pd(value);
+            std::uint64_t word = 0;
+            for (int j = 0; j < 64; j += 2)
+            {
+                __m128d x = _mm_loadu_pd(data + j);
+                __m128d m;
+                if constexpr (Op == CompareOp::eq) m = _mm_cmpeq_pd(x, v);
+                else if constexpr (Op == CompareOp::ne) m = _mm_cmpneq_pd(x, v);
+                else if constexpr (Op == CompareOp::lt) m = _mm_cmplt_pd(x, v);
+                else if constexpr (Op == CompareOp::le) m = _mm_cmple_pd(x, v);
+                else if constexpr (Op == CompareOp::gt) m = _mm_cmpgt_pd(x, v);
+                else m = _mm_cmpge_pd(x, v);
+                word |= static_cast<std::uint64_t>(_mm_movemask_pd(m)) << j;
+            }
+            return word;
+#else
+            return compare_block_scalar<Op>(data, 64, value);
+#endif
+        }
+
+        template <CompareOp Op>
+        inline std::uint64_t compare_block(const std::int64_t* data, std::int64_t value) noexcept
+        {
+#if defined(__AVX2__)
+            const __m256i v = _mm256_set1_epi64x(value);
+            std::uint64_t word = 0;
+            for (int j = 0; j < 64; j += 4)
+            {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + j));
+                __m256i m;
+                bool negate = false;
+                if constexpr (Op == CompareOp::eq) m = _mm256_cmpeq_epi64(x, v);
+                else if constexpr (Op == CompareOp::ne) { m = _mm256_cmpeq_epi64(x, v); negate = true; }
+                else if constexpr (Op == CompareOp::lt) m = _mm256_cmpgt_epi64(v, x);
+                else if constexpr (Op == CompareOp::le) { m = _mm256_cmpgt_epi64(x, v); negate = true; }
+                else if constexpr (Op == CompareOp::gt) m = _mm256_cmpgt_epi64(x, v);
+                else { m = _mm256_cmpgt_epi64(v, x); negate = true; }
+
+                auto bits = static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+                if (negate) bits ^= 0xF;
+                word |= bits << j;
+            }
+            return word;
+#else
+            return compare_block_scalar<Op>(data, 64, value);
+#endif
+        }
+
+        template <CompareOp Op, typename T>
+        inline void compare_to_words(const T* data, std::size_t n, T value, std::uint64_t* words) noexcept
+        {
+            std::size_t full = n / 64;
+            for (std::size_t w = 0; w < full; ++w)
+                words[w] = compare_block<Op>(data + w * 64, value);
+            if (n % 64 != 0)
+                words[full] = compare_block_scalar<Op>(data + full * 64, n % 64, value);
+        }
+
+        /// Writes (n + 63) / 64 words: bit i is set when data[i] op value holds
+        template <typename T>
+        inline void compare_to_words(const T* data, std::size_t n, CompareOp op, T value, std::uint64_t* words) noexcept
+        {
+            switch (op) {
+                case CompareOp::eq: compare_to_words<CompareOp::eq>(data, n, value, words); break;
+                case CompareOp::ne: compare_to_words<CompareOp::ne>(data, n, value, words); break;
+                case CompareOp::lt: compare_to_words<CompareOp::lt>(data, n, value, words); break;
+                case CompareOp::le: compare_to_words<CompareOp::le>(data, n, value, words); break;
+                case CompareOp::gt: compare_to_words<CompareOp::gt>(data, n, value, words); break;
+                case CompareOp::ge: compare_to_words<CompareOp::ge>(data, n, value, words); break;
+            }
+        }
+
+        /// Scalar reference for any comparable type
+        template <typename T>
+        inline bool compare(const T& a, CompareOp op, const T& b)
+        {
+            switch (op) {
+                case CompareOp::eq: return a == b;
+                case CompareOp::ne: return a != b;
+                case CompareOp::lt: return a < b;
+                case CompareOp::le: return a <= b;
+                case CompareOp::gt: return a > b;
+                case CompareOp::ge: return a >= b;
+            }
+            return false;
+        }
+    }
+}
+
+#endif // NUMERA_CORE_SIMDCOMPARE_H
@@ -0,0 +1,86 @@
+#ifndef NUMERA_CORE_SPAN_H
+#define NUMERA_CORE_SPAN_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief A non-owning view over a contiguous range of elements.
+ *
+ * Span is a minimal C++17 stand-in for std::span. It exposes the usual
+ * container surface (value_type, size, empty, begin/end, operator[]) so a
+ * view can be passed straight to the statistics functions in BasicStats
+ * without copying the viewed data.
+ *
+ * The viewed storage must outlive the span.
+ *
+ * @tparam T Element type, const-qualified for read-only views
+ */
+
+namespace nr
+{
+    template <typename T>
+    class Span
+    {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = std::size_t;
+        using pointer = T*;
+        using reference = T&;
+        using iterator = T*;
+        using const_iterator = T*;
+
+        constexpr Span() noexcept = default;
+        constexpr Span(T* data, size_type size) noexcept : ptr(data), count(size) {}
+        constexpr Span(T* first, T* last) noexcept : ptr(first), count(static_cast<size_type>(last - first)) {}
+
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+        constexpr Span(const Span<U>& other) noexcept : ptr(other.data()), count(other.size()) {}
+
+        template <typename U, typename Alloc,
+                  typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+        Span(std::vector<U, Alloc>& vec) noexcept : ptr(vec.data()), count(vec.size()) {}
+
+        template <typename U, typename Alloc,
+                  typename = std::enable_if_t<std::is_convertible_v<const U(*)[], T(*)[]>>>
+        Span(const std::vector<U, Alloc>& vec) noexcept : ptr(vec.data()), count(vec.size()) {}
+
+        constexpr pointer data() const noexcept { return ptr; }
+        constexpr size_type size() const noexcept { return count; }
+        constexpr bool empty() const noexcept { return count == 0; }
+
+        constexpr iterator begin() const noexcept { return ptr; }
+        constexpr iterator end() const noexcept { return ptr + count; }
+        constexpr const_iterator cbegin() const noexcept { return ptr; }
+        constexpr const_iterator cend() const noexcept { return ptr + count; }
+
+        constexpr reference operator[](size_type index) const { return ptr[index]; }
+        constexpr reference front() const { return ptr[0]; }
+        constexpr reference back() const { return ptr[count - 1]; }
+
+        reference at(size_type index) const
+        {
+            if (index >= count)
+                throw std::out_of_range("Span::at: index out of range");
+            return ptr[index];
+        }
+
+        /// View of [offset, offset + length), clamped to the end of the span
+        Span subspan(size_type offset, size_type length) const
+        {
+            if (offset > count)
+                throw std::out_of_range("Span::subspan: offset out of range");
+            if (length > count - offset) length = count - offset;
+            return Span(ptr + offset, length);
+        }
+
+    private:
+        T* ptr = nullptr;
+        size_type count = 0;
+    };
+}
+
+#endif // NUMERA_CORE_SPAN_H
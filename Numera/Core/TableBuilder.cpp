@@ -0,0 +1,151 @@
+#include "TableBuilder.h"
+#include "CSVTable.h"
+
+nr::TableBuilder::TableBuilder(std::vector<std::string> headers, std::vector<ColumnType> types, size_type capacity)
+    : headers(std::move(headers)), buffers(types.size())
+{
+    if (this->headers.size() != types.size())
+        throw std::invalid_argument("TableBuilder: header and type counts differ");
+
+    for (size_type c = 0; c < types.size(); ++c)
+    {
+        Buffer& b = buffers[c];
+        b.type = types[c];
+        switch (b.type) {
+            case ColumnType::int64:   b.ints.reserve(capacity); break;
+            case ColumnType::float64: b.doubles.reserve(capacity); break;
+            case ColumnType::boolean: b.bools.reserve(capacity); break;
+            case ColumnType::string:  b.strings.reserve(capacity); break;
+            case ColumnType::dictionary:
+                b.dictionary = Column(ColumnType::dictionary);
+                b.dictionary.reserve(capacity);
+                break;
+        }
+    }
+}
+
+void nr::TableBuilder::append_na(size_type column)
+{
+    if (column >= buffers.size())
+        throw std::out_of_range("TableBuilder: column index out of range");
+
+    Buffer& b = buffers[column];
+    if (b.type == ColumnType::string) {
+        b.strings.emplace_back();
+        return;
+    }
+    if (b.type == ColumnType::dictionary) {
+        b.dictionary.push_back(std::string_view());
+        return;
+    }
+
+    // Materialize the validity bitmap on the first missing value
+    const size_type n = size(column);
+    if (b.validity.empty())
+        b.validity.resize(n, true);
+    switch (b.type) {
+        case ColumnType::int64:   b.ints.push_back(0); break;
+        case ColumnType::float64: b.doubles.push_back(0.0); break;
+        default:                  b.bools.push_back(0); break;
+    }
+    b.validity.push_back(false);
+}
+
+nr::TableBuilder::size_type nr::TableBuilder::column_count() const noexcept
+{
+    return buffers.size();
+}
+
+nr::TableBuilder::size_type nr::TableBuilder::size(size_type column) const
+{
+    if (column >= buffers.size())
+        throw std::out_of_range("TableBuilder: column index out of range");
+
+    const Buffer& b = buffers[column];
+    switch (b.type) {
+        case ColumnType::int64:   return b.ints.size();
+        case ColumnType::float64: return b.doubles.size();
+        case ColumnType::boolean: return b.bools.size();
+        case ColumnType::string:  return b.strings.size();
+        case ColumnType::dictionary: return b.dictionary.size();
+    }
+    return 0;
+}
+
+nr::CSVTable nr::TableBuilder::finish()
+{
+    const size_type n = buffers.empty() ? 0 : size(0);
+    for (size_type c = 0; c < buffers.size(); ++c)
+        if (size(c) != n)
+            throw std::logic_error("TableBuilder::finish: column " + headers[c] + " has " + std::to_string(size(c)) +
+                                   " cells, expected " + std::to_string(n));
+
+    std::vector<Column> columns;
+    columns.reserve(buffers.size());
+    for (Buffer& b : buffers)
+    {
+        switch (b.type) {
+            case ColumnType::int64:   columns.push_back(Column::from_values(std::move(b.ints), std::move(b.validity))); break;
+            case ColumnType::float64: columns.push_back(Column::from_values(std::move(b.doubles), std::move(b.validity))); break;
+            case ColumnType::boolean: columns.push_back(Column::from_values(std::move(b.bools), std::move(b.validity))); break;
+            case ColumnType::string:  columns.push_back(Column::from_values(std::move(b.strings))); break;
+            case ColumnType::dictionary: columns.push_back(std::move(b.dictionary)); break;
+        }
+    }
+
+    CSVTable table(std::move(headers), std::move(columns));
+    table.pinned.assign(table.cols_count, true);
+
+    headers.clear();
+    buffers.clear();
+    return table;
+}
+
+nr::TableBuilder::Buffer& nr::TableBuilder::buffer(size_type column, ColumnType type)
+{
+    if (column >= buffers.size())
+        throw std::out_of_range("TableBuilder: column index out of range");
+
+    Buffer& b = buffers[column];
+    const bool fits = b.type == type || (type == ColumnType::int64 && b.type == ColumnType::float64) ||
+                      (type == ColumnType::string && b.type == ColumnType::dictionary);
+    if (!fits)
+        throw std::invalid_argument("TableBuilder: cannot append a " + std::string(to_string(type)) + " value to " +
+                                    headers[column] + ", a " + to_string(b.type) + " column");
+    return b;
+}
+
+void nr::TableBuilder::mark_valid(Buffer &b)
+{
+    if (!b.validity.empty())
+        b.validity.push_back(true);
+}
+
+void nr::TableBuilder::append_int(size_type column, std::int64_t value)
+{
+    Buffer& b = buffer(column, ColumnType::int64);
+    if (b.type == ColumnType::float64) b.doubles.push_back(static_cast<double>(value));
+    else b.ints.push_back(value);
+    mark_valid(b);
+}
+
+void nr::TableBuilder::append_double(size_type column, double value)
+{
+    Buffer& b = buffer(column, ColumnType::float64);
+    b.doubles.push_back(value);
+    mark_valid(b);
+}
+
+void nr::TableBuilder::append_bool(size_type column, bool value)
+{
+    Buffer& b = buffer(column, ColumnType::boolean);
+    b.bools.push_back(value ? 1 : 0);
+    mark_valid(b);
+}
+
+void nr::TableBuilder::append_text(size_type column, std::string_view value)
+{
+    Buffer& b = buffer(column, ColumnType::string);
+    if (b.type == ColumnType::dictionary) b.dictionary.push_back(value);
+    else b.strings.emplace_back(value);
+}
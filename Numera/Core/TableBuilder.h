@@ -0,0 +1,107 @@
+#ifndef NUMERA_CORE_TABLEBUILDER_H
+#define NUMERA_CORE_TABLEBUILDER_H
+#include "Core/Bitmap.h"
+#include "Core/Column.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Assembles a CSVTable from typed values.
+ *
+ *     nr::TableBuilder builder({"ts", "host", "latency"},
+ *                              {nr::ColumnType::int64, nr::ColumnType::dictionary,
+ *                               nr::ColumnType::float64}, expected_rows);
+ *     builder.append(0, ts);
+ *     builder.append(1, host);
+ *     builder.append_na(2);
+ *     ...
+ *     nr::CSVTable table = builder.finish();
+ *
+ * Every column is a typed buffer preallocated for the expected number
+ * of rows. Values are appended as they are (no text round trip), in any
+ * order across columns. finish() moves the buffers into the table's
+ * columns without copying them; every column must then hold the same
+ * number of cells. The types are explicit, so the table's columns behave
+ * like schema columns (add_row rejects cells that do not fit).
+ *
+ * append(column, value) accepts integers for int64 and float64 columns,
+ * floating point values for float64, bool for boolean and text
+ * (std::string, std::string_view, const char*) for string and dictionary
+ * columns. A value of another kind throws std::invalid_argument. As in
+ * Column, empty text in a dictionary column is a missing value.
+ */
+
+namespace nr
+{
+    class CSVTable;
+
+    class TableBuilder
+    {
+    public:
+        using size_type = std::size_t;
+
+        /// One column per header with the given storage type, each preallocated for capacity rows
+        TableBuilder(std::vector<std::string> headers, std::vector<ColumnType> types, size_type capacity = 0);
+
+        template <typename T>
+        void append(size_type column, const T& value);
+
+        /// Append a missing value (an empty string in a string column)
+        void append_na(size_type column);
+
+        size_type column_count() const noexcept;
+
+        /// Cells appended to a column so far
+        size_type size(size_type column) const;
+
+        /// Move the columns into a table and leave the builder empty. Throws
+        /// std::logic_error when the columns differ in length.
+        CSVTable finish();
+
+    private:
+        struct Buffer
+        {
+            ColumnType type = ColumnType::string;
+            std::vector<std::int64_t> ints;
+            std::vector<double> doubles;
+            std::vector<std::uint8_t> bools;
+            std::vector<std::string> strings;
+            Column dictionary;          // codes are assigned as values arrive
+            Bitmap validity;            // empty while nothing is missing
+        };
+
+        Buffer& buffer(size_type column, ColumnType type);
+        void mark_valid(Buffer& b);
+
+        void append_int(size_type column, std::int64_t value);
+        void append_double(size_type column, double value);
+        void append_bool(size_type column, bool value);
+        void append_text(size_type column, std::string_view value);
+
+        std::vector<std::string> headers;
+        std::vector<Buffer> buffers;
+    };
+
+    template <typename T>
+    inline void TableBuilder::append(size_type column, const T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            append_bool(column, value);
+        else if constexpr (std::is_integral_v<T>)
+            append_int(column, static_cast<std::int64_t>(value));
+        else if constexpr (std::is_floating_point_v<T>)
+            append_double(column, static_cast<double>(value));
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            append_text(column, std::string_view(value));
+        else
+            static_assert(std::is_same_v<T, bool>, "TableBuilder::append: unsupported value type");
+    }
+}
+
+#endif // NUMERA_CORE_TABLEBUILDER_H
@@ -0,0 +1,169 @@
+#ifndef NUMERA_CORE_ZONEMAP_H
+#define NUMERA_CORE_ZONEMAP_H
+#include "Core/SimdCompare.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Per-block min/max summaries of a numeric column.
+ *
+ * A ZoneMap splits a column into blocks of block_rows consecutive rows
+ * and keeps one Zone per block: the smallest and largest present value
+ * and how many cells are missing or NaN. Column maintains it as cells
+ * are appended, so it exists as soon as a table is loaded.
+ *
+ * match() decides a comparison for a whole block from its zone. On
+ * time-ordered data most blocks of a range filter are either entirely
+ * outside the range (skipped) or entirely inside it (answered from the
+ * validity bits), and only the blocks on the boundary are scanned.
+ *
+ * block_rows is a multiple of 64, so blocks start on Bitmap word
+ * boundaries.
+ */
+
+namespace nr
+{
+    /// Outcome of a comparison for a whole block
+    enum class ZoneMatch
+    {
+        none,   // no cell matches
+        all,    // every present cell matches
+        some    // the cells must be read
+    };
+
+    template <typename T>
+    class ZoneMap
+    {
+    public:
+        using size_type = std::size_t;
+
+        static constexpr size_type block_rows = 4096;
+
+        struct Zone
+        {
+            T min{};                    // valid when values > 0
+            T max{};
+            std::uint32_t values = 0;   // present cells that are not NaN
+            std::uint32_t nulls = 0;    // missing cells
+            std::uint32_t nans = 0;     // NaN cells (float64 only)
+        };
+
+        ZoneMap() = default;
+
+        /// Zones over values, where cells whose bit is cleared in validity are
+        /// missing (an empty validity means none are)
+        template <typename Values, typename Validity>
+        static ZoneMap build(const Values& values, const Validity& validity);
+
+        void push_back(T value);
+        void push_na();
+        void clear() noexcept;
+
+        /// Number of rows summarized
+        size_type size() const noexcept { return rows; }
+
+        const std::vector<Zone>& zones() const noexcept { return blocks; }
+
+        /// Decide (cell op value) for every cell of a zone; missing cells never match,
+        /// NaN cells only match ne
+        static ZoneMatch match(const Zone& zone, CompareOp op, T value) noexcept;
+
+    private:
+        Zone& open_block();
+
+        std::vector<Zone> blocks;
+        size_type rows = 0;
+    };
+
+    template <typename T>
+    template <typename Values, typename Validity>
+    inline ZoneMap<T> ZoneMap<T>::build(const Values& values, const Validity& validity)
+    {
+        ZoneMap map;
+        map.blocks.reserve((values.size() + block_rows - 1) / block_rows);
+        for (size_type i = 0; i < values.size(); ++i) {
+            if (validity.empty() || validity.test(i)) map.push_back(values[i]);
+            else map.push_na();
+        }
+        return map;
+    }
+
+    template <typename T>
+    inline void ZoneMap<T>::push_back(T value)
+    {
+        Zone& zone = open_block();
+        if (value != value) {   // NaN
+            ++zone.nans;
+        } else if (zone.values++ == 0) {
+            zone.min = zone.max = value;
+        } else {
+            zone.min = std::min(zone.min, value);
+            zone.max = std::max(zone.max, value);
+        }
+    }
+
+    template <typename T>
+    inline void ZoneMap<T>::push_na()
+    {
+        ++open_block().nulls;
+    }
+
+    template <typename T>
+    inline void ZoneMap<T>::clear() noexcept
+    {
+        blocks.clear();
+        rows = 0;
+    }
+
+    template <typename T>
+    inline typename ZoneMap<T>::Zone& ZoneMap<T>::open_block()
+    {
+        if (rows++ % block_rows == 0) blocks.emplace_back();
+        return blocks.back();
+    }
+
+    template <typename T>
+    inline ZoneMatch ZoneMap<T>::match(const Zone& zone, CompareOp op, T value) noexcept
+    {
+        if (value != value)     // NaN: only ne holds, for every present cell
+            return op == CompareOp::ne ? ZoneMatch::all : ZoneMatch::none;
+
+        // NaN cells fail every comparison but ne, so "all" needs a block without them
+        const bool clean = zone.nans == 0;
+        if (zone.values == 0)
+            return op == CompareOp::ne && !clean ? ZoneMatch::all : ZoneMatch::none;
+
+        switch (op) {
+            case CompareOp::eq:
+                if (value < zone.min || value > zone.max) return ZoneMatch::none;
+                if (clean && zone.min == value && zone.max == value) return ZoneMatch::all;
+                break;
+            case CompareOp::ne:
+                if (value < zone.min || value > zone.max) return ZoneMatch::all;
+                if (clean && zone.min == value && zone.max == value) return ZoneMatch::none;
+                break;
+            case CompareOp::lt:
+                if (zone.min >= value) return ZoneMatch::none;
+                if (clean && zone.max < value) return ZoneMatch::all;
+                break;
+            case CompareOp::le:
+                if (zone.min > value) return ZoneMatch::none;
+                if (clean && zone.max <= value) return ZoneMatch::all;
+                break;
+            case CompareOp::gt:
+                if (zone.max <= value) return ZoneMatch::none;
+                if (clean && zone.min > value) return ZoneMatch::all;
+                break;
+            case CompareOp::ge:
+                if (zone.max < value) return ZoneMatch::none;
+                if (clean && zone.min >= value) return ZoneMatch::all;
+                break;
+        }
+        return ZoneMatch::some;
+    }
+}
+
+#endif // NUMERA_CORE_ZONEMAP_H
@@ -1,32 +1,248 @@
 #include "CsvDataLoader.h"
+#include "CsvScanner.h"
+#include "Core/Parallel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+    // Start of the first line break at or after pos, size when there is none
+    std::size_t find_newline(const MappedFile& text, std::size_t pos)
+    {
+        if (pos >= text.size()) return text.size();
+        const void* nl = std::memchr(text.data() + pos, '\n', text.size() - pos);
+        return nl ? static_cast<std::size_t>(static_cast<const char*>(nl) - text.data()) : text.size();
+    }
+
+    using Views = std::vector<std::vector<std::string_view>>;   // cells of each column
+
+    // Bytes below which another parsing thread is not worth starting
+    constexpr std::size_t min_chunk_bytes = std::size_t{1} << 20;
+
+    // Lines starting in one byte range of the body, parsed into their own columns
+    struct Chunk
+    {
+        std::size_t begin = 0;      // first line parsed
+        std::size_t stop = 0;       // first line of the next chunk, as found by this one
+        bool quoted = false;        // some cell starts with a quote
+        Views columns;
+    };
+
+    // slots[c]: where file column c goes among the n_cols loaded columns (npos: skipped)
+    void parse_chunk(const MappedFile& text, std::size_t limit, const std::vector<std::size_t>& slots,
+                     std::size_t n_cols, std::size_t estimate, Chunk& chunk)
+    {
+        chunk.quoted = false;
+        chunk.columns.assign(n_cols, {});
+        for (auto& col : chunk.columns) col.reserve(estimate);
+
+        // Cells of skipped columns are only delimited, never stored or unescaped
+        chunk.stop = nr::detail::scan_lines(text.data(), text.size(), chunk.begin, limit,
+            [&](std::size_t column, const char* first, const char* last) {
+                if (column >= slots.size() || slots[column] == CSVDataLoader::npos) return;
+                if (first != last && *first == '"') chunk.quoted = true;
+                chunk.columns[slots[column]].emplace_back(first, static_cast<std::size_t>(last - first));
+            },
+            [](std::size_t) {});
+    }
+
+    // Parses the lines after the header with up to threads threads (0 = hardware_concurrency())
+    Views parse_body(MappedFile& text, std::size_t body, const std::vector<std::size_t>& slots, std::size_t n_cols,
+                     std::size_t threads)
+    {
+        const std::size_t bytes = text.size() - body;
+        const std::size_t chunks_count = nr::detail::worker_count(threads, bytes, min_chunk_bytes);
+        const std::size_t width = (bytes + chunks_count - 1) / std::max<std::size_t>(1, chunks_count);
+
+        // Rows per chunk estimated from the first line keeps reallocations down
+        std::size_t estimate = 0;
+        if (body < text.size()) estimate = width / (find_newline(text, body) - body + 1) + 1;
+
+        // Speculative pass: every chunk starts after the first line break past its offset,
+        // assuming that break is not inside quotes
+        std::vector<Chunk> chunks(chunks_count);
+        nr::detail::parallel_tasks(chunks_count, [&](std::size_t t) {
+            const std::size_t from = body + t * width;
+            Chunk& chunk = chunks[t];
+            if (t == 0) chunk.begin = body;
+            else chunk.begin = std::min(text.size(), find_newline(text, from - 1) + 1);
+            parse_chunk(text, std::min(text.size(), from + width), slots, n_cols, estimate, chunk);
+        });
+
+        // Fix-up: a chunk is right when it begins where the previous (right) one stopped
+        for (std::size_t t = 1; t < chunks_count; ++t) {
+            if (chunks[t].begin == chunks[t - 1].stop) continue;
+            chunks[t].begin = chunks[t - 1].stop;
+            parse_chunk(text, std::min(text.size(), body + (t + 1) * width), slots, n_cols, estimate, chunks[t]);
+        }
+
+        // The chunks now cover disjoint bytes, so quoted cells can be unescaped in place
+        nr::detail::parallel_tasks(chunks_count, [&](std::size_t t) {
+            if (!chunks[t].quoted) return;
+            for (auto& col : chunks[t].columns)
+                for (auto& cell : col) {
+                    if (cell.empty() || cell.front() != '"') continue;
+                    char* first = text.data() + (cell.data() - text.data());
+                    cell = nr::detail::unquote(first, first + cell.size());
+                }
+        });
+
+        // Concatenate per column: the first chunk's buffers are moved, the others appended
+        Views columns(n_cols);
+        const std::size_t movers = std::min(chunks_count, n_cols);
+        nr::detail::parallel_tasks(movers, [&](std::size_t t) {
+            for (std::size_t c = t; c < n_cols; c += movers) {
+                columns[c] = std::move(chunks[0].columns[c]);
+                std::size_t total = columns[c].size();
+                for (std::size_t k = 1; k < chunks_count; ++k) total += chunks[k].columns[c].size();
+                columns[c].reserve(total);
+                for (std::size_t k = 1; k < chunks_count; ++k)
+                    columns[c].insert(columns[c].end(), chunks[k].columns[c].begin(), chunks[k].columns[c].end());
+            }
+        });
+        return columns;
+    }
+
+    // Header cells of the first line (unescaped in place); returns where the body starts
+    std::size_t parse_header(MappedFile& text, std::vector<std::string>& headers)
+    {
+        return nr::detail::scan_lines(text.data(), text.size(), 0, 1,
+            [&](std::size_t, const char* first, const char* last) {
+                char* begin = text.data() + (first - text.data());
+                headers.emplace_back(nr::detail::unquote(begin, begin + (last - first)));
+            },
+            [](std::size_t) {});
+    }
+
+    // Loaded headers in their loaded order
+    std::vector<std::string> project(const std::vector<std::string>& headers, const std::vector<std::size_t>& slots,
+                                     std::size_t n_cols)
+    {
+        std::vector<std::string> out(n_cols);
+        for (std::size_t c = 0; c < headers.size(); ++c)
+            if (slots[c] != CSVDataLoader::npos) out[slots[c]] = headers[c];
+        return out;
+    }
+}
+
+std::vector<CSVDataLoader::size_type> CSVDataLoader::Projection::resolve(const std::vector<std::string>& headers) const
+{
+    std::vector<size_type> slots(headers.size(), npos);
+    if (empty()) {
+        for (size_type c = 0; c < slots.size(); ++c) slots[c] = c;
+        return slots;
+    }
+
+    if (!names.empty()) {
+        for (size_type i = 0; i < names.size(); ++i) {
+            auto it = std::find(headers.begin(), headers.end(), names[i]);
+            if (it == headers.end())
+                throw std::invalid_argument("CSVDataLoader: projected column not found: " + names[i]);
+            size_type& slot = slots[static_cast<size_type>(it - headers.begin())];
+            if (slot != npos) throw std::invalid_argument("CSVDataLoader: column projected twice: " + names[i]);
+            slot = i;
+        }
+        return slots;
+    }
+
+    for (size_type i = 0; i < indices.size(); ++i) {
+        if (indices[i] >= headers.size())
+            throw std::out_of_range("CSVDataLoader: projected column index out of range: " + std::to_string(indices[i]));
+        if (slots[indices[i]] != npos)
+            throw std::invalid_argument("CSVDataLoader: column projected twice: " + headers[indices[i]]);
+        slots[indices[i]] = i;
+    }
+    return slots;
+}
 
 std::unordered_map<std::string, std::vector<std::string>> CSVDataLoader::load(const std::string& filename)
+{
+    return load(filename, m_projection);
+}
+
+CSVDataLoader::container_type CSVDataLoader::load(const std::string& filename, const Projection& projection)
 {
     container_type result;
     column_order.clear();
 
-    std::ifstream file(filename);
-    if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+    std::shared_ptr<MappedFile> text = MappedFile::open(filename);
+    if (text->empty()) return result; // пустой файл
 
-    std::string line;
-    if (!std::getline(file, line)) return result; // пустой файл
+    std::vector<std::string> headers;
+    const size_type body = parse_header(*text, headers);
+    const std::vector<size_type> slots = projection.resolve(headers);
+    const size_type n_cols = headers.size() - static_cast<size_type>(std::count(slots.begin(), slots.end(), npos));
+    column_order = project(headers, slots, n_cols);
+    Views views = parse_body(*text, body, slots, n_cols, m_threads);
 
-    // Сохраняем заголовки и порядок
-    column_order = split(line, ',');
-    for (const auto& col : column_order) result[col] = {};
-
-    // Чтение строк
-    while (std::getline(file, line)) {
-        auto values = split(line, ',');
-        for (size_t i = 0; i < values.size() && i < column_order.size(); ++i) {
-            result[column_order[i]].push_back(values[i]);
+    // Cells are copied out of the buffer, one column per task
+    std::vector<std::vector<std::string>> cells(views.size());
+    const size_type copiers = std::min(views.size(), nr::detail::worker_count(m_threads, text->size(), min_chunk_bytes));
+    nr::detail::parallel_tasks(copiers, [&](size_type t) {
+        for (size_type c = t; c < views.size(); c += copiers) {
+            cells[c].reserve(views[c].size());
+            for (std::string_view cell : views[c]) cells[c].emplace_back(cell);
+            views[c] = {};
         }
+    });
+
+    for (size_type c = 0; c < column_order.size(); ++c) {
+        auto& target = result[column_order[c]];
+        if (target.empty()) target = std::move(cells[c]);
+        else target.insert(target.end(), std::make_move_iterator(cells[c].begin()), std::make_move_iterator(cells[c].end()));
     }
 
-    m_data = result; // сохраняем внутрь класса, если нужно
     return result;
 }
 
+CSVDataLoader::RawTable CSVDataLoader::load_views(const std::string &filename)
+{
+    return load_views(filename, m_projection);
+}
+
+CSVDataLoader::RawTable CSVDataLoader::load_views(const std::string &filename, const Projection &projection)
+{
+    RawTable result;
+    column_order.clear();
+
+    std::shared_ptr<MappedFile> text = MappedFile::open(filename);
+    if (text->empty()) return result; // empty file
+
+    // Cells view the mapped bytes (quoted cells are unescaped in place, in copy-on-write pages)
+    std::vector<std::string> headers;
+    const size_type body = parse_header(*text, headers);
+    const std::vector<size_type> slots = projection.resolve(headers);
+    const size_type n_cols = headers.size() - static_cast<size_type>(std::count(slots.begin(), slots.end(), npos));
+    result.headers = project(headers, slots, n_cols);
+    column_order = result.headers;
+    result.columns = parse_body(*text, body, slots, n_cols, m_threads);
+    result.buffer = text;
+    return result;
+}
+
+void CSVDataLoader::set_projection(Projection projection)
+{
+    m_projection = std::move(projection);
+}
+
+const CSVDataLoader::Projection& CSVDataLoader::projection() const
+{
+    return m_projection;
+}
+
+void CSVDataLoader::set_threads(size_type threads)
+{
+    m_threads = threads;
+}
+
+CSVDataLoader::size_type CSVDataLoader::threads() const
+{
+    return m_threads;
+}
+
 void CSVDataLoader::save(const std::string &filename, const std::unordered_map<std::string, std::vector<std::string>> &data) const
 {
     std::ofstream file(filename);
@@ -56,12 +272,3 @@ const std::vector<std::string> &CSVDataLoader::get_column_order() const
 {
     return column_order; 
 }
-
-std::vector<std::string> CSVDataLoader::split(const std::string &s, char delimiter) const
-{
-    std::vector<std::string> tokens;
-    std::string token;
-    std::istringstream ss(s);
-    while (std::getline(ss, token, delimiter)) tokens.push_back(token);
-    return tokens;
-}
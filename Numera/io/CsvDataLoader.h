@@ -1,6 +1,7 @@
 #ifndef CSVDATALOADER_H
 #define CSVDATALOADER_H
 #include "IDataLoader.h"
+#include "MappedFile.h"
 
 #include <iostream>
 #include <fstream>
@@ -8,6 +9,8 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
+#include <string_view>
 #include <unordered_map>
 
 class CSVDataLoader : public IDataLoader<std::unordered_map<std::string, std::vector<std::string>>>{
@@ -22,19 +25,55 @@ public:
     using container_type = std::unordered_map<std::string, std::vector<std::string>>;
     using size_type = std::size_t;
 
-    // Reading a CSV file
+    // Whole file in one buffer (the file mapping, see MappedFile.h), cells are views into it
+    struct RawTable {
+        std::shared_ptr<const void> buffer;     // keeps the cells' bytes alive
+        std::vector<std::string> headers;
+        std::vector<std::vector<std::string_view>> columns;  // in header order
+    };
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Columns to load, by header name or by position (names win when both are given);
+    // both empty loads every column. Loaded columns come out in the order given, and the
+    // cells of the others are skipped by the tokenizer without being stored.
+    struct Projection {
+        std::vector<std::string> names;
+        std::vector<size_type> indices;
+
+        bool empty() const noexcept { return names.empty() && indices.empty(); }
+
+        // Position among the loaded columns of every file column (npos: skipped). Throws
+        // std::invalid_argument for unknown or repeated columns, std::out_of_range for
+        // positions past the last column.
+        std::vector<size_type> resolve(const std::vector<std::string>& headers) const;
+    };
+
+    // Reading a CSV file (RFC 4180 quoting, see CsvScanner.h)
     container_type load(const std::string& filename) override;
+    container_type load(const std::string& filename, const Projection& projection);
+
+    // Reading a CSV file into a single buffer without allocating per cell
+    RawTable load_views(const std::string& filename);
+    RawTable load_views(const std::string& filename, const Projection& projection);
+
+    // Projection used by load(filename) and load_views(filename)
+    void set_projection(Projection projection);
+    const Projection& projection() const;
+
+    // Threads used to parse a file (0 = hardware_concurrency(), the default). Files are
+    // split into byte ranges of at least 1 MiB, so small files are parsed on one thread.
+    void set_threads(size_type threads);
+    size_type threads() const;
 
     // Write to file
     void save(const std::string& filename, const std::unordered_map<std::string, std::vector<std::string>>& data) const override;
     const std::vector<std::string>& get_column_order() const;
 private:
     value_type m_filename;
-    container_type m_data;
     std::vector<std::string> column_order;
-
-    // Helper function for splitting a string by a delimiter
-    std::vector<std::string> split(const std::string& s, char delimiter) const;
+    size_type m_threads = 0;
+    Projection m_projection;
 };
 
 #endif //CSVDATALOADER_H
\ No newline at end of file
@@ -0,0 +1,204 @@
+#ifndef NUMERA_IO_CSVSCANNER_H
+#define NUMERA_IO_CSVSCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Structural-character scanner that splits CSV text into cells.
+ *
+ * The text is processed in 64-byte blocks, in the style of simdcsv and
+ * simdjson. Each block is compared with ',', '\n' and '"' using vector
+ * compares (AVX2 with -mavx2, otherwise SSE2, scalar elsewhere), which
+ * gives one 64-bit mask per character. A prefix XOR over the quote mask
+ * marks the bytes inside quoted fields, so only delimiters and newlines
+ * outside quotes remain. The loop then jumps from one remaining bit to
+ * the next (count trailing zeros) instead of looking at every byte.
+ *
+ * Cells follow RFC 4180 quoting: a quoted cell may contain delimiters,
+ * newlines and doubled quotes. The surrounding quotes are removed and
+ * "" becomes ", in place, which is why the scanner takes mutable text;
+ * every cell is a std::string_view into it. A '\r' before a line break
+ * is dropped.
+ *
+ * Lines are split like CSVDataLoader always split them: a delimiter at
+ * the end of a line does not start another (empty) cell, and a blank
+ * line has no cells.
+ *
+ * scan_lines() is the read-only core: it parses the lines that start in
+ * a byte range and reports where the next one starts, which is what the
+ * chunked parallel loader builds on. It leaves quotes in place, so
+ * threads scanning overlapping guesses never write to the text.
+ */
+
+namespace nr
+{
+    namespace detail
+    {
+        // Bit i set where block[i] == c, for the 64 bytes at block
+        inline std::uint64_t byte_mask(const char* block, char c) noexcept
+        {
+#if defined(__AVX2__)
+            const __m256i v = _mm256_set1_epi8(c);
+            const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+            const auto lo_bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, v)));
+            const auto hi_bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, v)));
+            return lo_bits | (static_cast<std::uint64_t>(hi_bits) << 32);
+#elif defined(__SSE2__)
+            const __m128i v = _mm_set1_epi8(c);
+            std::uint64_t bits = 0;
+            for (int j = 0; j < 64; j += 16)
+            {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + j));
+                bits |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, v)))) << j;
+            }
+            return bits;
+#else
+            std::uint64_t bits = 0;
+            for (int j = 0; j < 64; ++j)
+                bits |= static_cast<std::uint64_t>(block[j] == c) << j;
+            return bits;
+#endif
+        }
+
+        // Bit i = XOR of bits 0..i: the bytes from an opening quote up to its closing quote
+        inline std::uint64_t prefix_xor(std::uint64_t x) noexcept
+        {
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+            return x;
+        }
+
+        // Removes the quotes of a quoted cell and collapses "" in place
+        inline std::string_view unquote(char* begin, char* end) noexcept
+        {
+            if (end - begin < 2 || *begin != '"' || *(end - 1) != '"')
+                return std::string_view(begin, static_cast<std::size_t>(end - begin));   // not a quoted cell
+
+            char* first = begin + 1;
+            char* last = end - 1;
+            char* out = static_cast<char*>(std::memchr(first, '"', static_cast<std::size_t>(last - first)));
+            if (out == nullptr) return std::string_view(first, static_cast<std::size_t>(last - first));
+
+            for (char* in = out; in < last; ++in) {
+                *out++ = *in;
+                if (*in == '"' && in + 1 < last && in[1] == '"') ++in;
+            }
+            return std::string_view(first, static_cast<std::size_t>(out - first));
+        }
+
+        /// Splits the lines that start in [begin, limit): cell(column, first, last) with the raw
+        /// bytes of every cell (quotes kept, '\r' before a line break dropped), then row_end(cells)
+        /// after every line (cells == 0 for a blank line). begin must start a line outside quotes.
+        /// Returns where the first line at or after limit starts (size at the end of the text).
+        /// A row_end returning bool stops the scan after the line for which it returns false.
+        template <typename Cell, typename RowEnd>
+        std::size_t scan_lines(const char* text, std::size_t size, std::size_t begin, std::size_t limit,
+                               Cell cell, RowEnd row_end)
+        {
+            std::size_t start = begin;  // first byte of the current cell
+            std::size_t column = 0;     // cells emitted on the current line
+            bool more = true;           // row_end asked for further lines
+            if (begin >= limit) return begin;
+
+            auto finish = [&](std::size_t end, bool line_end) {
+                const char* first = text + start;
+                const char* last = text + end;
+                if (line_end && last > first && *(last - 1) == '\r') --last;
+
+                // A line's last cell only counts when it is not empty
+                if (!line_end || last > first) cell(column++, first, last);
+                if (line_end) {
+                    if constexpr (std::is_same_v<std::invoke_result_t<RowEnd&, std::size_t>, bool>)
+                        more = row_end(column);
+                    else
+                        row_end(column);
+                    column = 0;
+                }
+            };
+
+            std::uint64_t inside = 0;   // all ones while a quoted cell continues into the next block
+            char tail[64];
+            for (std::size_t block = begin; block < size; block += 64)
+            {
+                const char* bytes = text + block;
+                if (size - block < 64) {
+                    // Pad the last block with bytes that are not structural
+                    std::memset(tail, ' ', sizeof(tail));
+                    std::memcpy(tail, bytes, size - block);
+                    bytes = tail;
+                }
+
+                const std::uint64_t quotes = byte_mask(bytes, '"');
+                const std::uint64_t quoted = prefix_xor(quotes) ^ inside;
+                inside = static_cast<std::uint64_t>(static_cast<std::int64_t>(quoted) >> 63);
+
+                std::uint64_t structural = (byte_mask(bytes, ',') | byte_mask(bytes, '\n')) & ~quoted;
+                while (structural != 0) {
+                    const std::size_t pos = block + static_cast<std::size_t>(__builtin_ctzll(structural));
+                    structural &= structural - 1;
+                    const bool line_end = text[pos] == '\n';
+                    finish(pos, line_end);
+                    start = pos + 1;
+                    if (line_end && (start >= limit || !more)) return start;
+                }
+            }
+
+            // Last line without a trailing newline
+            if (start < size || column > 0) finish(size, true);
+            return size;
+        }
+
+        /// Position just after the last line break outside quotes in [begin, size), begin when
+        /// there is none. begin must start a line outside quotes.
+        inline std::size_t last_line_end(const char* text, std::size_t begin, std::size_t size) noexcept
+        {
+            std::size_t found = begin;
+            std::uint64_t inside = 0;
+            char tail[64];
+            for (std::size_t block = begin; block < size; block += 64)
+            {
+                const char* bytes = text + block;
+                if (size - block < 64) {
+                    std::memset(tail, ' ', sizeof(tail));
+                    std::memcpy(tail, bytes, size - block);
+                    bytes = tail;
+                }
+
+                const std::uint64_t quoted = prefix_xor(byte_mask(bytes, '"')) ^ inside;
+                inside = static_cast<std::uint64_t>(static_cast<std::int64_t>(quoted) >> 63);
+
+                const std::uint64_t breaks = byte_mask(bytes, '\n') & ~quoted;
+                if (breaks != 0) found = block + static_cast<std::size_t>(63 - __builtin_clzll(breaks)) + 1;
+            }
+            return found;
+        }
+
+        /// Splits text into cells: cell(column, token) for every cell of a line, then
+        /// row_end(cells) after every line (cells == 0 for a blank line). Quoted cells are
+        /// unescaped in place.
+        template <typename Cell, typename RowEnd>
+        void scan_csv(char* text, std::size_t size, Cell cell, RowEnd row_end)
+        {
+            scan_lines(text, size, 0, size,
+                [&](std::size_t column, const char* first, const char* last) {
+                    cell(column, unquote(text + (first - text), text + (last - text)));
+                },
+                row_end);
+        }
+    }
+}
+
+#endif // NUMERA_IO_CSVSCANNER_H
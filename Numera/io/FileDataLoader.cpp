@@ -1,26 +1,68 @@
 #include "FileDataLoader.h"
+#include "MappedFile.h"
+#include "Core/NumericParse.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+    // Calls f(token) for every token of text separated by ',' or a line break, with
+    // spaces and '\r' trimmed. A separator at the very end does not start another token.
+    template <typename F>
+    void for_each_token(const MappedFile& text, F f)
+    {
+        const char* it = text.data();
+        const char* end = it + text.size();
+        while (it < end) {
+            const char* first = it;
+            while (it < end && *it != ',' && *it != '\n') ++it;
+            const char* last = it;
+            if (it < end) ++it;
+
+            while (first < last && (*first == ' ' || *first == '\t')) ++first;
+            while (last > first && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r')) --last;
+            f(std::string_view(first, static_cast<std::size_t>(last - first)));
+        }
+    }
+
+    double parse_number(std::string_view token)
+    {
+        double value = 0.0;
+        if (!nr::detail::parse_floating(token, value))
+            throw std::runtime_error("Invalid number: " + std::string(token));
+        return value;
+    }
+}
 
 std::vector<double> FileDataLoader::load(const std::string& filename)
 {
-    char delimiter = ',';
+    std::shared_ptr<MappedFile> text = MappedFile::open(filename);
+
     std::vector<double> numbers;
-    std::ifstream file(filename);
+    for_each_token(*text, [&](std::string_view token) {
+        if (!token.empty()) numbers.push_back(parse_number(token));
+    });
+    return numbers;
+}
 
-    if (!file) {
-        throw std::runtime_error("Failed to open file: " + filename);
-    }
+std::vector<double> FileDataLoader::load(const std::string& filename, nr::Bitmap& validity)
+{
+    std::shared_ptr<MappedFile> text = MappedFile::open(filename);
 
-    std::string token;
-    while (std::getline(file, token, delimiter)) {
-        if (token.empty()) continue;
+    validity.clear();
 
-        try {
-            numbers.push_back(std::stod(token));
-        } catch (const std::exception&) {
-            throw std::runtime_error("Invalid number: " + token);
+    std::vector<double> numbers;
+    for_each_token(*text, [&](std::string_view token) {
+        if (token.empty()) {
+            numbers.push_back(0.0);
+            validity.push_back(false);
+            return;
         }
-    }
-
+        numbers.push_back(parse_number(token));
+        validity.push_back(true);
+    });
     return numbers;
 }
 
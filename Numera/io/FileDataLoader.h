@@ -1,6 +1,7 @@
 #ifndef NUMERA_FILEDATALOADER_H
 #define NUMERA_FILEDATALOADER_H
 #include "IDataLoader.h"
+#include "Core/Bitmap.h"
 
 #include<fstream>
 #include<vector>
@@ -15,6 +16,8 @@ public:
     17.0
     15.5
     ...
+    or with values separated by commas. The file is memory-mapped (see MappedFile.h)
+    and every token must be a number.
     */
     using value_type = double;
     using container_type = std::vector<double>;
@@ -23,6 +26,10 @@ public:
     //Reading a file
     std::vector<double> load(const std::string& filename) override;
 
+    //Reading a file keeping empty tokens as missing values:
+    //they are stored as 0.0 with their validity bit cleared
+    std::vector<double> load(const std::string& filename, nr::Bitmap& validity);
+
     //Writing to a file
     void save(const std::string& filename, const std::vector<double>& data) const override;
 };
@@ -0,0 +1,117 @@
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NUMERA_POSIX_IO 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace
+{
+    constexpr std::size_t read_block = std::size_t{8} << 20;   // bytes per pread()/read() call
+}
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string &filename)
+{
+    return std::make_shared<MappedFile>(filename);
+}
+
+#if defined(NUMERA_POSIX_IO)
+
+MappedFile::MappedFile(const std::string &filename)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open file: " + filename);
+
+    struct FdGuard
+    {
+        int fd;
+        ~FdGuard() { ::close(fd); }
+    } guard{fd};
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0) throw std::runtime_error("Cannot read file: " + filename);
+
+    if (!S_ISREG(info.st_mode)) {
+        read_stream(fd, filename);      // pipes and devices have no size to map
+        return;
+    }
+
+    length = static_cast<size_type>(info.st_size);
+    if (length == 0) return;
+
+    void* map = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+        ::madvise(map, length, MADV_SEQUENTIAL);
+        bytes = static_cast<char*>(map);
+        is_mapped = true;
+        return;
+    }
+
+    // Mapping refused (e.g. some network file systems): one large pread() per block
+    heap.reset(new char[length]);
+    bytes = heap.get();
+    for (size_type done = 0; done < length;) {
+        const ssize_t got = ::pread(fd, bytes + done, std::min(read_block, length - done), static_cast<off_t>(done));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) throw std::runtime_error("Cannot read file: " + filename);
+        done += static_cast<size_type>(got);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (is_mapped) ::munmap(bytes, length);
+}
+
+void MappedFile::read_stream(int fd, const std::string &filename)
+{
+    size_type capacity = 0;
+    for (;;) {
+        if (length == capacity) {
+            capacity = std::max(read_block, capacity * 2);
+            std::unique_ptr<char[]> grown(new char[capacity]);
+            if (length > 0) std::memcpy(grown.get(), heap.get(), length);
+            heap = std::move(grown);
+        }
+        const ssize_t got = ::read(fd, heap.get() + length, capacity - length);
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0) throw std::runtime_error("Cannot read file: " + filename);
+        if (got == 0) break;
+        length += static_cast<size_type>(got);
+    }
+    bytes = heap.get();
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+
+    file.seekg(0, std::ios::end);
+    length = static_cast<size_type>(file.tellg());
+    file.seekg(0, std::ios::beg);
+    heap.reset(new char[std::max<size_type>(length, 1)]);
+    bytes = heap.get();
+    if (length > 0 && !file.read(bytes, static_cast<std::streamsize>(length)))
+        throw std::runtime_error("Cannot read file: " + filename);
+}
+
+MappedFile::~MappedFile() = default;
+
+void MappedFile::read_stream(int, const std::string &)
+{
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef NUMERA_IO_MAPPEDFILE_H
+#define NUMERA_IO_MAPPEDFILE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Whole-file input without iostream copies.
+ *
+ * A regular file is memory-mapped privately (copy-on-write): tokenizers
+ * read the mapped bytes directly, and in-place edits such as unescaping
+ * a quoted CSV cell only copy the pages they touch, never the file. When
+ * a file cannot be mapped (a pipe, a character device, or mmap failing),
+ * it is read into a heap buffer instead: regular files with one pread()
+ * per 8 MiB, anything else with read() into a buffer that grows
+ * geometrically. On platforms without POSIX I/O the heap path uses
+ * std::ifstream.
+ *
+ * Text cells may view data() for as long as the MappedFile lives, so
+ * loaders hand it out as a std::shared_ptr for tables to hold on to.
+ */
+
+class MappedFile
+{
+public:
+    using size_type = std::size_t;
+
+    /// Maps (or reads) filename; throws std::runtime_error when it cannot be opened or read
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    static std::shared_ptr<MappedFile> open(const std::string& filename);
+
+    char* data() noexcept { return bytes; }
+    const char* data() const noexcept { return bytes; }
+    size_type size() const noexcept { return length; }
+    bool empty() const noexcept { return length == 0; }
+
+    /// True when the bytes are a mapping of the file rather than a copy
+    bool mapped() const noexcept { return is_mapped; }
+
+private:
+    void read_stream(int fd, const std::string& filename);
+
+    char* bytes = nullptr;
+    size_type length = 0;
+    bool is_mapped = false;
+    std::unique_ptr<char[]> heap;   // fallback copy of the file
+};
+
+#endif // NUMERA_IO_MAPPEDFILE_H
@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include <numeric>
+#include <iterator>
 #include <type_traits>
 #include <map>
 #include <vector>
@@ -14,6 +15,89 @@
 
 namespace nr
 {
+    namespace detail
+    {
+        /*
+            Selection helpers shared by median, quartiles and percentile.
+            They work on a scratch copy that they are free to reorder and use
+            std::nth_element (O(N) on average) instead of a full sort, so any
+            container with forward iterators can be summarized without being
+            linearized and sorted first.
+        */
+        template <typename T>
+        T median_of(std::vector<T>& values)
+        {
+            const std::size_t n = values.size();
+            const std::size_t mid = n / 2;
+            std::nth_element(values.begin(), values.begin() + mid, values.end());
+
+            if (n % 2 == 1)
+                return values[mid];
+
+            // the lower middle element is the largest one left of mid
+            T lower = *std::max_element(values.begin(), values.begin() + mid);
+            return (lower + values[mid]) / static_cast<T>(2);
+        }
+
+        // R7 percentile of a non-empty range that may be reordered (e.g. one group's
+        // slice of a larger buffer)
+        template <typename RandomIt>
+        auto percentile_of_range(RandomIt first, RandomIt last, double p)
+        -> std::common_type_t<typename std::iterator_traits<RandomIt>::value_type, double>
+        {
+            using T = typename std::iterator_traits<RandomIt>::value_type;
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            const double pos = (p / 100.0) * (n - 1);
+
+            const std::size_t idx = static_cast<std::size_t>(std::floor(pos));
+            const double frac = pos - idx;
+
+            std::nth_element(first, first + idx, last);
+            if (idx + 1 < n)
+            {
+                T next = *std::min_element(first + idx + 1, last);
+                return first[idx] * (1.0 - frac) + next * frac;
+            }
+            return first[idx];
+        }
+
+        template <typename T>
+        auto percentile_of(std::vector<T>& values, double p) -> std::common_type_t<T, double>
+        {
+            return percentile_of_range(values.begin(), values.end(), p);
+        }
+
+        template <typename T>
+        T lower_quartile_of(std::vector<T>& values)
+        {
+            const std::size_t mid = values.size() / 2;
+            if (mid == 0) {
+                throw std::logic_error("lower_quartile: not enough data");
+            }
+
+            // After selection the lowest `mid` values occupy the front
+            std::nth_element(values.begin(), values.begin() + mid, values.end());
+            values.resize(mid);
+            return median_of(values);
+        }
+
+        template <typename T>
+        T upper_quartile_of(std::vector<T>& values)
+        {
+            const std::size_t n = values.size();
+            const std::size_t mid = n / 2;
+            if (mid == 0) {
+                throw std::logic_error("upper_quartile: not enough data");
+            }
+
+            // For odd n we skip the median.
+            const std::size_t start = (n % 2 == 0) ? mid : mid + 1;
+
+            std::nth_element(values.begin(), values.begin() + start, values.end());
+            values.erase(values.begin(), values.begin() + start);
+            return median_of(values);
+        }
+    }
     template<typename Iterator>
     auto min(Iterator begin, Iterator end) 
     -> typename std::iterator_traits<Iterator>::value_type
@@ -183,22 +267,13 @@ namespace nr
     {
         // Finds the median
         // Throws if the range is empty.
-        using mut_container = std::vector<typename std::iterator_traits<Iterator>::value_type>;
-        using value_type = typename mut_container::value_type;
+        using value_type = typename std::iterator_traits<Iterator>::value_type;
 
         if (begin == end) throw std::invalid_argument("median: empty container");;
 
-        // Make a mutable copy (decayed type) even if `Container` is const-qualified
-        mut_container numbersCopy(begin, end);
-        std::sort(numbersCopy.begin(), numbersCopy.end());
-
-        size_t n = numbersCopy.size();
-        if (n % 2 == 1) {
-            return numbersCopy[n / 2];
-        } else {
-            // compute average of two middle elements, cast to value_type
-            return (numbersCopy[n / 2 - 1] + numbersCopy[n / 2]) / static_cast<value_type>(2);
-        }
+        // Selection on a scratch copy, the input range is left untouched
+        std::vector<value_type> numbersCopy(begin, end);
+        return detail::median_of(numbersCopy);
     }
 
     template <typename Container>
@@ -206,22 +281,13 @@ namespace nr
     {
         // Finds the median
         // Throws if the range is empty.
-        using mut_container = std::decay_t<Container>;
-        using value_type = typename mut_container::value_type;
+        using value_type = typename std::decay_t<Container>::value_type;
 
         if (std::begin(data) == std::end(data)) throw std::invalid_argument("median: empty container");
 
-        // Make a mutable copy (decayed type) even if `Container` is const-qualified
-        mut_container numbersCopy(std::begin(data), std::end(data));
-        std::sort(numbersCopy.begin(), numbersCopy.end());
-
-        size_t n = numbersCopy.size();
-        if (n % 2 == 1) {
-            return numbersCopy[n / 2];
-        } else {
-            // compute average of two middle elements, cast to value_type
-            return (numbersCopy[n / 2 - 1] + numbersCopy[n / 2]) / static_cast<value_type>(2);
-        }
+        // Selection on a scratch copy, works for any container with forward iterators
+        std::vector<value_type> numbersCopy(std::begin(data), std::end(data));
+        return detail::median_of(numbersCopy);
     }
 
     template<typename KeyType, typename ArrayDataType>
@@ -451,26 +517,14 @@ namespace nr
     -> std::common_type_t<typename std::decay_t<Container>::value_type, double>
     {
         // Finds the lower quartile
-        using mut_container = std::decay_t<Container>;
-        using value_type = typename mut_container::value_type;
+        using value_type = typename std::decay_t<Container>::value_type;
 
         if (data.empty()) {
             throw std::invalid_argument("lower_quartile: empty data");
         }
 
-        mut_container dataCopy(data.begin(), data.end());
-        std::sort(dataCopy.begin(), dataCopy.end());
-
-        const std::size_t size_ = dataCopy.size();
-        const std::size_t mid = size_ / 2;
-
-        if (mid == 0) {
-            throw std::logic_error("lower_quartile: not enough data");
-        }
-
-        mut_container dataLower(dataCopy.begin(), dataCopy.begin() + mid);
-
-        return median(dataLower);
+        std::vector<value_type> dataCopy(data.begin(), data.end());
+        return detail::lower_quartile_of(dataCopy);
     }
 
     template<typename Iterator>
@@ -478,26 +532,14 @@ namespace nr
     -> typename std::iterator_traits<Iterator>::value_type
     {
         // Finds the lower quartile
-        using mut_container = std::vector<typename std::iterator_traits<Iterator>::value_type>;
-        using value_type = typename mut_container::value_type;
+        using value_type = typename std::iterator_traits<Iterator>::value_type;
 
         if (begin == end) {
             throw std::invalid_argument("lower_quartile: empty data");
         }
 
-        mut_container dataCopy(begin, end);
-        std::sort(dataCopy.begin(), dataCopy.end());
-
-        const std::size_t size_ = dataCopy.size();
-        const std::size_t mid = size_ / 2;
-
-        if (mid == 0) {
-            throw std::logic_error("lower_quartile: not enough data");
-        }
-
-        mut_container dataLower(dataCopy.begin(), dataCopy.begin() + mid);
-
-        return median(dataLower);
+        std::vector<value_type> dataCopy(begin, end);
+        return detail::lower_quartile_of(dataCopy);
     }
 
     template <typename Container>
@@ -505,32 +547,14 @@ namespace nr
     -> std::common_type_t<typename std::decay_t<Container>::value_type, double>
     {
         // Finds the upper quartile
-        using mut_container = std::decay_t<Container>;
+        using value_type = typename std::decay_t<Container>::value_type;
 
         if (data.empty()) {
             throw std::invalid_argument("upper_quartile: empty data");
         }
 
-        mut_container dataCopy(data.begin(), data.end());
-        std::sort(dataCopy.begin(), dataCopy.end());
-
-        const std::size_t n = dataCopy.size();
-        const std::size_t mid = n / 2;
-
-        if (mid == 0) {
-            throw std::logic_error("upper_quartile: not enough data");
-        }
-
-        // For odd n we skip the median.
-        const std::size_t start =
-            (n % 2 == 0) ? mid : mid + 1;
-
-        mut_container dataUpper(
-            dataCopy.begin() + start,
-            dataCopy.end()
-        );
-
-        return median(dataUpper);
+        std::vector<value_type> dataCopy(data.begin(), data.end());
+        return detail::upper_quartile_of(dataCopy);
     }
 
     template<typename Iterator>
@@ -538,32 +562,14 @@ namespace nr
     -> typename std::iterator_traits<Iterator>::value_type
     {
         // Finds the upper quartile
-        using mut_container = std::vector<typename std::iterator_traits<Iterator>::value_type>;
+        using value_type = typename std::iterator_traits<Iterator>::value_type;
 
         if (begin == end) {
             throw std::invalid_argument("upper_quartile: empty data");
         }
 
-        mut_container dataCopy(begin, end);
-        std::sort(dataCopy.begin(), dataCopy.end());
-
-        const std::size_t n = dataCopy.size();
-        const std::size_t mid = n / 2;
-
-        if (mid == 0) {
-            throw std::logic_error("upper_quartile: not enough data");
-        }
-
-        // For odd n we skip the median.
-        const std::size_t start =
-            (n % 2 == 0) ? mid : mid + 1;
-
-        mut_container dataUpper(
-            dataCopy.begin() + start,
-            dataCopy.end()
-        );
-
-        return median(dataUpper);
+        std::vector<value_type> dataCopy(begin, end);
+        return detail::upper_quartile_of(dataCopy);
     }
 
     template <typename Container>
@@ -573,7 +579,7 @@ namespace nr
         /**
      * Calculates the p-th percentile using linear interpolation (R7/Excel style).
      * * Nuances:
-     * - Complexity: O(N log N) due to full internal copy & sort.
+     * - Complexity: O(N) on average, a scratch copy plus nth_element selection.
      * - Interpolation: Uses (p/100)*(n-1) to find the fractional index.
      * - Safety: Throws if data is empty or p is out of [0, 100] range.
      * - Precision: Returns double to handle fractional results between elements.
@@ -586,19 +592,8 @@ namespace nr
         if (p < 0.0 || p > 100.0)
             throw std::out_of_range("percentile: p must be in [0, 100]");
 
-        std::vector<value_type> sorted(data.begin(), data.end());
-        std::sort(sorted.begin(), sorted.end());
-
-        const std::size_t n = sorted.size();
-        const double pos = (p / 100.0) * (n - 1);
-
-        const std::size_t idx = static_cast<std::size_t>(std::floor(pos));
-        const double frac = pos - idx;
-
-        if (idx + 1 < n)
-            return sorted[idx] * (1.0 - frac) + sorted[idx + 1] * frac;
-        else
-            return sorted[idx];
+        std::vector<value_type> values(data.begin(), data.end());
+        return detail::percentile_of(values, p);
     }
 
     template<typename Iterator>
@@ -608,7 +603,7 @@ namespace nr
         /**
          * Calculates the p-th percentile using linear interpolation (R7/Excel style).
          * * Nuances:
-         * - Complexity: O(N log N) due to full internal copy & sort.
+         * - Complexity: O(N) on average, a scratch copy plus nth_element selection.
          * - Interpolation: Uses (p/100)*(n-1) to find the fractional index.
          * - Safety: Throws if data is empty or p is out of [0, 100] range.
          * - Precision: Returns double to handle fractional results between elements.
@@ -621,19 +616,8 @@ namespace nr
         if (p < 0.0 || p > 100.0)
             throw std::out_of_range("percentile: p must be in [0, 100]");
 
-        std::vector<value_type> sorted(begin, end);
-        std::sort(sorted.begin(), sorted.end());
-
-        const std::size_t n = sorted.size();
-        const double pos = (p / 100.0) * (n - 1);
-
-        const std::size_t idx = static_cast<std::size_t>(std::floor(pos));
-        const double frac = pos - idx;
-
-        if (idx + 1 < n)
-            return sorted[idx] * (1.0 - frac) + sorted[idx + 1] * frac;
-        else
-            return sorted[idx];
+        std::vector<value_type> values(begin, end);
+        return detail::percentile_of(values, p);
     }
 
     template <typename Container>
@@ -0,0 +1,173 @@
+#ifndef NUMERA_STATS_NULLABLESTATS_H
+#define NUMERA_STATS_NULLABLESTATS_H
+#include "stats/BasicStats.h"
+#include "Core/Bitmap.h"
+
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace nr
+{
+    /*
+        Statistics over data with missing values (NA).
+
+        Missing values are described by an Arrow-style validity bitmap next to
+        the values: bit i set means data[i] is present. An empty bitmap means
+        "no missing values". The bitmap is walked a word at a time, so fully
+        valid stretches are processed as plain contiguous loops and
+        fully missing words are skipped without touching the values.
+    */
+
+    enum class na_policy
+    {
+        skip,   // ignore missing values
+        error   // throw std::domain_error if any value is missing
+    };
+
+    namespace detail
+    {
+        template <typename Container>
+        void check_validity(const Container& data, const Bitmap& validity, na_policy policy, const char* name)
+        {
+            if (!validity.empty() && validity.size() != data.size())
+                throw std::invalid_argument(std::string(name) + ": validity bitmap size mismatch");
+
+            if (policy == na_policy::error && !validity.empty() && validity.count() != validity.size())
+                throw std::domain_error(std::string(name) + ": missing values present");
+        }
+
+        // Calls f(begin, end) for every contiguous range of present values
+        template <typename Container, typename F>
+        void for_each_valid_run(const Container& data, const Bitmap& validity, F f)
+        {
+            if (validity.empty())
+            {
+                if (!data.empty()) f(std::size_t{0}, static_cast<std::size_t>(data.size()));
+                return;
+            }
+            validity.for_each_run(f);
+        }
+
+        template <typename Container>
+        auto gather_valid(const Container& data, const Bitmap& validity)
+        -> std::vector<typename std::decay_t<Container>::value_type>
+        {
+            std::vector<typename std::decay_t<Container>::value_type> out;
+            out.reserve(validity.empty() ? data.size() : validity.count());
+            for_each_valid_run(data, validity, [&](std::size_t b, std::size_t e) {
+                out.insert(out.end(), data.begin() + b, data.begin() + e);
+            });
+            return out;
+        }
+    }
+
+    template <typename Container>
+    std::size_t count_valid(const Container& data, const Bitmap& validity)
+    {
+        // Number of present (non-missing) values
+        if (!validity.empty() && validity.size() != data.size())
+            throw std::invalid_argument("count_valid: validity bitmap size mismatch");
+        return validity.empty() ? data.size() : validity.count();
+    }
+
+    template <typename Container>
+    auto min(const Container& data, const Bitmap& validity, na_policy policy)
+    -> typename std::decay_t<Container>::value_type
+    {
+        // Returns the minimum present value.
+        // Throws if there are no present values.
+        using T = typename std::decay_t<Container>::value_type;
+        detail::check_validity(data, validity, policy, "min");
+
+        bool found = false;
+        T result{};
+        detail::for_each_valid_run(data, validity, [&](std::size_t b, std::size_t e) {
+            T local = data[b];
+            for (std::size_t i = b + 1; i < e; ++i)
+                local = data[i] < local ? data[i] : local;
+            if (!found || local < result) result = local;
+            found = true;
+        });
+
+        if (!found)
+            throw std::invalid_argument("min: no present values");
+        return result;
+    }
+
+    template <typename Container>
+    auto max(const Container& data, const Bitmap& validity, na_policy policy)
+    -> typename std::decay_t<Container>::value_type
+    {
+        // Returns the maximum present value.
+        // Throws if there are no present values.
+        using T = typename std::decay_t<Container>::value_type;
+        detail::check_validity(data, validity, policy, "max");
+
+        bool found = false;
+        T result{};
+        detail::for_each_valid_run(data, validity, [&](std::size_t b, std::size_t e) {
+            T local = data[b];
+            for (std::size_t i = b + 1; i < e; ++i)
+                local = data[i] > local ? data[i] : local;
+            if (!found || local > result) result = local;
+            found = true;
+        });
+
+        if (!found)
+            throw std::invalid_argument("max: no present values");
+        return result;
+    }
+
+    template <typename Container>
+    auto sum(const Container& data, const Bitmap& validity, na_policy policy)
+    -> std::common_type_t<typename std::decay_t<Container>::value_type, double>
+    {
+        // Sum of present values (0 if there are none)
+        detail::check_validity(data, validity, policy, "sum");
+
+        double total = 0.0;
+        detail::for_each_valid_run(data, validity, [&](std::size_t b, std::size_t e) {
+            double local = 0.0;
+            for (std::size_t i = b; i < e; ++i)
+                local += static_cast<double>(data[i]);
+            total += local;
+        });
+        return total;
+    }
+
+    template <typename Container>
+    auto arithmetic_mean(const Container& data, const Bitmap& validity, na_policy policy)
+    -> typename std::decay_t<Container>::value_type
+    {
+        // Calculates the arithmetic mean of present values.
+        // Throws if there are no present values.
+        using T = typename std::decay_t<Container>::value_type;
+
+        double total = sum(data, validity, policy);
+        std::size_t n = count_valid(data, validity);
+        if (n == 0)
+            throw std::invalid_argument("arithmetic_mean: no present values");
+        return static_cast<T>(total / n);
+    }
+
+    template <typename Container>
+    auto median(const Container& data, const Bitmap& validity, na_policy policy)
+    -> typename std::decay_t<Container>::value_type
+    {
+        // Finds the median of present values
+        detail::check_validity(data, validity, policy, "median");
+        return median(detail::gather_valid(data, validity));
+    }
+
+    template <typename Container>
+    auto percentile(const Container& data, const Bitmap& validity, double p, na_policy policy)
+    -> std::common_type_t<typename std::decay_t<Container>::value_type, double>
+    {
+        // Calculates the p-th percentile (R7) of present values
+        detail::check_validity(data, validity, policy, "percentile");
+        return percentile(detail::gather_valid(data, validity), p);
+    }
+}
+
+#endif // NUMERA_STATS_NULLABLESTATS_H
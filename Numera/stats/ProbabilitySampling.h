@@ -10,6 +10,8 @@
 #include<iostream>
 #include<cmath>
 #include "Core/NumericSample.h"
+#include "Core/Span.h"
+#include <cstdint>
 
 namespace nr
 {
@@ -34,6 +36,14 @@ namespace nr
             const std::vector<size_t>& strataLabels,
             size_t sampleSize);
 
+        // Rows whose code is >= strataCount (e.g. missing labels) are not sampled
+        template<typename T>
+        static std::vector<T> stratified(
+            const std::vector<T>& data,
+            Span<const std::uint32_t> strataCodes,
+            size_t strataCount,
+            size_t sampleSize);
+
 ////////////////////////////////////////////////////
         template<typename T>
         static std::vector<T> simple_random(
@@ -50,6 +60,14 @@ namespace nr
             const nr::NumericSample<T>& data,
             const std::vector<size_t>& strataLabels,
             size_t sampleSize);
+
+    private:
+        // Draws a proportional sample from every non-empty group of indices into data
+        template<typename T, typename Data>
+        static std::vector<T> sample_strata(
+            const Data& data,
+            const std::vector<std::vector<size_t>>& groups,
+            size_t sampleSize);
     };
 
     template<typename T>
@@ -119,22 +137,65 @@ namespace nr
 
         if (data.empty() || strataLabels.size() != data.size() || sampleSize == 0) return {};
 
-        size_t dataSize = data.size();
-
         // Grouping indices by strata
-        std::unordered_map<size_t, std::vector<size_t>> groups;
+        std::unordered_map<size_t, size_t> slot; // {stratum label, index into groups}
+        std::vector<std::vector<size_t>> groups;
         for (size_t i = 0; i < strataLabels.size(); ++i) 
         {
-            groups[strataLabels[i]].push_back(i);
+            auto it = slot.try_emplace(strataLabels[i], groups.size()).first;
+            if (it->second == groups.size()) groups.emplace_back();
+            groups[it->second].push_back(i);
         }
 
+        return sample_strata<T>(data, groups, sampleSize);
+    }
+
+    template<typename T>
+    std::vector<T> ProbabilitySampling::stratified(
+        const std::vector<T>& data,
+        Span<const std::uint32_t> strataCodes,
+        size_t strataCount,
+        size_t sampleSize)
+    {
+        // Stratified sampling over dense integer labels (e.g. dictionary codes):
+        // strata are found by direct indexing instead of hashing
+
+        if (data.empty() || strataCodes.size() != data.size() || sampleSize == 0) return {};
+
+        std::vector<size_t> counts(strataCount, 0);
+        for (std::uint32_t code : strataCodes)
+            if (code < strataCount) ++counts[code];
+
+        std::vector<std::vector<size_t>> groups(strataCount);
+        for (size_t g = 0; g < strataCount; ++g) groups[g].reserve(counts[g]);
+        for (size_t i = 0; i < strataCodes.size(); ++i)
+            if (strataCodes[i] < strataCount) groups[strataCodes[i]].push_back(i);
+
+        return sample_strata<T>(data, groups, sampleSize);
+    }
+
+    template<typename T, typename Data>
+    std::vector<T> ProbabilitySampling::sample_strata(
+        const Data& data,
+        const std::vector<std::vector<size_t>>& groups,
+        size_t sampleSize)
+    {
+        // Proportional allocation over the given strata (largest remainder method)
+
+        size_t dataSize = 0;
+        for (const auto& idxs : groups) dataSize += idxs.size();
+        if (dataSize == 0 || sampleSize == 0) return {};
+
         // A vector to store the target size k for each stratum and its fractional remainder
         std::vector<std::pair<double, size_t>> fractional_targets; // {fractional remainder, stratum mark}
-        std::unordered_map<size_t, size_t> final_k_values; // {stratum label, final size k}
+        std::vector<size_t> final_k_values(groups.size(), 0); // final size k per stratum
         size_t total_picked_so_far = 0;
 
-        for (auto const& [label, idxs] : groups) 
+        for (size_t label = 0; label < groups.size(); ++label) 
         {
+            const auto& idxs = groups[label];
+            if (idxs.empty()) continue;
+
             // Calculating the size of k using floating point
             double target_k_double = (static_cast<double>(idxs.size()) * sampleSize) / dataSize;
             
@@ -172,7 +233,7 @@ namespace nr
         });
 
         // Distribution of missing elements
-        for (size_t i = 0; i < remainder; ++i) 
+        for (size_t i = 0; i < remainder && i < fractional_targets.size(); ++i) 
         {
             size_t label_to_increase = fractional_targets[i].second;
             final_k_values[label_to_increase]++;
@@ -180,13 +241,14 @@ namespace nr
 
         // --- FORMATION OF THE FINAL SAMPLE ---
 
-        std::vector<double> out;
+        std::vector<T> out;
         out.reserve(sampleSize); 
         auto &gen = nr::RandomValueGenerator::get_thread_local_generator();
 
-        for (auto const& [label, idxs] : groups) 
+        for (size_t label = 0; label < groups.size(); ++label) 
         {
-            size_t k = final_k_values.at(label); // We get the EXACTLY calculated k
+            const auto& idxs = groups[label];
+            size_t k = final_k_values[label]; // We get the EXACTLY calculated k
             
             // We guarantee that k does not exceed the size of the stratum
             k = std::min(k, idxs.size()); 
@@ -271,90 +333,19 @@ namespace nr
 
         if (data.empty() || strataLabels.size() != data.size() || sampleSize == 0) return {};
 
-        size_t dataSize = data.size();
-
         // Grouping indices by strata
-        std::unordered_map<size_t, std::vector<size_t>> groups;
+        std::unordered_map<size_t, size_t> slot; // {stratum label, index into groups}
+        std::vector<std::vector<size_t>> groups;
         for (size_t i = 0; i < strataLabels.size(); ++i) 
         {
-            groups[strataLabels[i]].push_back(i);
-        }
-
-        // A vector to store the target size k for each stratum and its fractional remainder
-        std::vector<std::pair<double, size_t>> fractional_targets; // {fractional remainder, stratum mark}
-        std::unordered_map<size_t, size_t> final_k_values; // {stratum label, final size k}
-        size_t total_picked_so_far = 0;
-
-        for (auto const& [label, idxs] : groups) 
-        {
-            // Calculating the size of k using floating point
-            double target_k_double = (static_cast<double>(idxs.size()) * sampleSize) / dataSize;
-            
-            // Base size k - round down (integer part)
-            size_t base_k = static_cast<size_t>(std::floor(target_k_double));
-
-            // Guarantee that a small stratum selects at least 1 element if it is not empty
-            if (base_k == 0 && idxs.size() > 0) 
-            {
-                base_k = 1;
-            }
-
-            // We calculate the fractional remainder for the distribution of missing elements
-            double fraction = target_k_double - base_k;
-            
-            // We write down the base value
-            final_k_values[label] = base_k;
-            total_picked_so_far += base_k;
-
-            // Save the remainder and the stratum label
-            fractional_targets.push_back({fraction, label});
-        }
-
-        // Calculation of missing elements (the remainder to be distributed)
-        size_t remainder = 0;
-        if (sampleSize > total_picked_so_far) 
-        {
-            remainder = sampleSize - total_picked_so_far;
+            auto it = slot.try_emplace(strataLabels[i], groups.size()).first;
+            if (it->second == groups.size()) groups.emplace_back();
+            groups[it->second].push_back(i);
         }
-        
-        // Sort by descending fractional remainder
-        // The strata with the largest remainder will receive additional missing elements
-        std::sort(fractional_targets.begin(), fractional_targets.end(), [](const auto& a, const auto& b) {
-            return a.first > b.first; 
-        });
 
-        // Distribution of missing elements
-        for (size_t i = 0; i < remainder; ++i) 
-        {
-            size_t label_to_increase = fractional_targets[i].second;
-            final_k_values[label_to_increase]++;
-        }
-
-        // --- FORMATION OF THE FINAL SAMPLE ---
-
-        std::vector<double> out;
-        out.reserve(sampleSize); 
-        auto &gen = nr::RandomValueGenerator::get_thread_local_generator();
-
-        for (auto const& [label, idxs] : groups) 
-        {
-            size_t k = final_k_values.at(label); // We get the EXACTLY calculated k
-            
-            // We guarantee that k does not exceed the size of the stratum
-            k = std::min(k, idxs.size()); 
-
-            std::vector<size_t> picked;
-            picked.reserve(k);
-            // We use std::sample
-            std::sample(idxs.begin(), idxs.end(), std::back_inserter(picked), k, gen);
-
-            for (auto id : picked) out.push_back(data[id]);
-        }
-
-        // Mixing
-        std::shuffle(out.begin(), out.end(), gen);
-        return out;
+        return sample_strata<T>(data, groups, sampleSize);
     }
+
 }
 
 #endif // PROBABILITY_SAMPLING_H
\ No newline at end of file
@@ -0,0 +1,139 @@
+#ifndef NUMERA_STATS_RUNNINGSTATS_H
+#define NUMERA_STATS_RUNNINGSTATS_H
+#include "stats/NullableStats.h"
+#include "Core/Column.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace nr
+{
+    /*
+        Count, mean, variance, min and max of a stream of values in O(1)
+        memory, e.g. over the batches of a CSVReader:
+
+            nr::RunningStats latency;
+            for (;;) {
+                const nr::CSVBatch& batch = reader.next_batch(65536);
+                if (batch.empty()) break;
+                latency.add(batch.column("latency"));
+            }
+
+        Each contiguous run of values is summarized with a two-pass mean and
+        sum of squared deviations, then folded into the running state with
+        Chan's parallel form of Welford's update. This keeps the variance
+        accurate for values far from zero, and states of independent streams
+        (threads, files) can be combined with merge().
+    */
+    class RunningStats
+    {
+    public:
+        void add(double value) noexcept
+        {
+            add_summary(1, value, 0.0, value, value);
+        }
+
+        // Present values of data (an empty validity means all are present)
+        template <typename Container>
+        void add(const Container& data, const Bitmap& validity = Bitmap())
+        {
+            detail::check_validity(data, validity, na_policy::skip, "RunningStats::add");
+            detail::for_each_valid_run(data, validity, [&](std::size_t b, std::size_t e) {
+                double total = 0.0;
+                double lo = static_cast<double>(data[b]);
+                double hi = lo;
+                for (std::size_t i = b; i < e; ++i) {
+                    const double x = static_cast<double>(data[i]);
+                    total += x;
+                    lo = std::min(lo, x);
+                    hi = std::max(hi, x);
+                }
+                const double run_mean = total / static_cast<double>(e - b);
+                double run_m2 = 0.0;
+                for (std::size_t i = b; i < e; ++i) {
+                    const double d = static_cast<double>(data[i]) - run_mean;
+                    run_m2 += d * d;
+                }
+                add_summary(e - b, run_mean, run_m2, lo, hi);
+            });
+        }
+
+        // Present values of an int64 or float64 column; throws std::invalid_argument otherwise
+        void add(const Column& column)
+        {
+            if (column.type() == ColumnType::int64)
+                add(column.view<std::int64_t>(), column.validity());
+            else if (column.type() == ColumnType::float64)
+                add(column.view<double>(), column.validity());
+            else
+                throw std::invalid_argument(std::string("RunningStats::add: column is not numeric: ") +
+                                            to_string(column.type()));
+        }
+
+        void merge(const RunningStats& other) noexcept
+        {
+            if (other.n > 0) add_summary(other.n, other.running_mean, other.m2, other.lo, other.hi);
+        }
+
+        std::size_t count() const noexcept { return n; }
+        bool empty() const noexcept { return n == 0; }
+
+        // The accessors below throw std::invalid_argument when nothing was added
+        double mean() const { check("mean"); return running_mean; }
+        double sum() const { check("sum"); return running_mean * static_cast<double>(n); }
+        double min() const { check("min"); return lo; }
+        double max() const { check("max"); return hi; }
+
+        // Sample variance (n - 1 in the denominator); needs two values
+        double variance() const
+        {
+            if (n < 2) throw std::invalid_argument("RunningStats::variance: fewer than two values");
+            return m2 / static_cast<double>(n - 1);
+        }
+
+        double standard_deviation() const { return std::sqrt(variance()); }
+
+        // Population variance (n in the denominator)
+        double population_variance() const { check("population_variance"); return m2 / static_cast<double>(n); }
+
+        void clear() noexcept { *this = RunningStats(); }
+
+    private:
+        void add_summary(std::size_t count_b, double mean_b, double m2_b, double lo_b, double hi_b) noexcept
+        {
+            if (n == 0) {
+                n = count_b;
+                running_mean = mean_b;
+                m2 = m2_b;
+                lo = lo_b;
+                hi = hi_b;
+                return;
+            }
+            const double total = static_cast<double>(n + count_b);
+            const double delta = mean_b - running_mean;
+            running_mean += delta * static_cast<double>(count_b) / total;
+            m2 += m2_b + delta * delta * static_cast<double>(n) * static_cast<double>(count_b) / total;
+            lo = std::min(lo, lo_b);
+            hi = std::max(hi, hi_b);
+            n += count_b;
+        }
+
+        void check(const char* name) const
+        {
+            if (n == 0) throw std::invalid_argument(std::string("RunningStats::") + name + ": no values");
+        }
+
+        std::size_t n = 0;
+        double running_mean = 0.0;
+        double m2 = 0.0;        // sum of squared deviations from the mean
+        double lo = std::numeric_limits<double>::infinity();
+        double hi = -std::numeric_limits<double>::infinity();
+    };
+}
+
+#endif // NUMERA_STATS_RUNNINGSTATS_H
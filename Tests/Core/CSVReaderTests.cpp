@@ -0,0 +1,181 @@
+#include "CSVReaderTests.h"
+
+namespace
+{
+    void write_file(const char* path, const std::string& text)
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    }
+}
+
+void csv_reader_tests()
+{
+    {
+        std::cout << "[TEST] CSVReader yields fixed-size typed batches\n";
+        const char* tmp_file = "tmp_reader_batches.csv";
+        std::string text = "id,latency,region\n";
+        for (int i = 0; i < 10; ++i)
+            text += std::to_string(i) + "," + std::to_string(i * 1.5) + "," + (i % 2 ? "eu" : "us") + "\n";
+        write_file(tmp_file, text);
+
+        nr::CSVReader reader(tmp_file);
+        assert((reader.headers() == std::vector<std::string>{"id", "latency", "region"}));
+
+        const nr::CSVBatch& first = reader.next_batch(4);
+        assert(first.row_count() == 4 && first.first_row() == 0);
+        assert(first.column("id").type() == nr::ColumnType::int64);
+        assert(first.column("latency").type() == nr::ColumnType::float64);
+        assert(first.view<std::int64_t>("id")[3] == 3);
+        assert(first.column(2).format(1) == "eu");
+
+        assert(reader.next_batch(4).first_row() == 4);
+        const nr::CSVBatch& last = reader.next_batch(4);
+        assert(last.row_count() == 2 && last.first_row() == 8);
+        assert(last.view<double>("latency")[1] == 13.5);
+        assert(reader.done());
+        assert(reader.next_batch(4).empty());
+        assert(reader.rows_read() == 10);
+
+        bool threw = false;
+        try {
+            last.column("missing");
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+        std::remove(tmp_file);
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVReader widens inferred columns across batches\n";
+        const char* tmp_file = "tmp_reader_widen.csv";
+        write_file(tmp_file, "a,b\n1,x\n2,y\n3.5,z\n4,w\nfive,v\n6,u\n");
+
+        nr::CSVLoadOptions options;
+        options.inference_rows = 2;
+        nr::CSVReader reader(tmp_file, options);
+
+        const nr::CSVBatch& one = reader.next_batch(3);
+        assert(one.column("a").type() == nr::ColumnType::float64);
+        assert(one.view<double>("a")[2] == 3.5);
+        assert(reader.types()[0] == nr::ColumnType::float64);
+
+        const nr::CSVBatch& two = reader.next_batch(3);
+        assert(two.column("a").type() == nr::ColumnType::string);
+        assert(two.column("a").format(0) == "4" && two.column("a").format(1) == "five");
+        assert(reader.types()[0] == nr::ColumnType::string);
+        std::remove(tmp_file);
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVReader schema columns reject cells that do not fit\n";
+        const char* tmp_file = "tmp_reader_schema.csv";
+        write_file(tmp_file, "a,b\n1,2\nx,3\n");
+
+        nr::CSVLoadOptions options;
+        options.schema["a"] = nr::ColumnType::int64;
+        nr::CSVReader reader(tmp_file, options);
+        bool threw = false;
+        try {
+            reader.next_batch(10);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+
+        options.schema["c"] = nr::ColumnType::int64;
+        threw = false;
+        try {
+            nr::CSVReader unknown(tmp_file, options);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+        std::remove(tmp_file);
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVReader handles quotes, CRLF, short rows and blank lines\n";
+        const char* tmp_file = "tmp_reader_quotes.csv";
+        write_file(tmp_file, "\"name\",score,note\r\n\"a, b\",1,\"x\r\n\"\"y\"\"\"\r\n\r\nc,2\r\nd,,z");
+
+        nr::CSVReader reader(tmp_file);
+        assert(reader.headers()[0] == "name");
+        const nr::CSVBatch& batch = reader.next_batch(100);
+        assert(batch.row_count() == 3);
+        assert(batch.column("name").format(0) == "a, b");
+        assert(batch.column("note").format(0) == "x\r\n\"y\"");
+        assert(batch.column("score").type() == nr::ColumnType::int64);
+        assert(batch.column("score").is_na(2));
+        assert(batch.column("note").format(1).empty());     // padded
+        assert(batch.column("note").format(2) == "z");
+        std::remove(tmp_file);
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVReader keeps only projected columns\n";
+        const char* tmp_file = "tmp_reader_projection.csv";
+        write_file(tmp_file, "a,b,c\n1,x,2.5\n3,y\n");
+
+        nr::CSVLoadOptions options;
+        options.columns = {"c", "a"};
+        nr::CSVReader reader(tmp_file, options);
+        assert((reader.headers() == std::vector<std::string>{"c", "a"}));
+        const nr::CSVBatch& batch = reader.next_batch(10);
+        assert(batch.column_count() == 2 && batch.row_count() == 2);
+        assert(batch.view<std::int64_t>("a")[1] == 3);
+        assert(batch.column("c").is_na(1));
+        std::remove(tmp_file);
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVReader streams a file larger than its window\n";
+        const char* tmp_file = "tmp_reader_stream.csv";
+        std::string text = "id,value,note\n";
+        std::vector<double> values;
+        for (int i = 0; text.size() < (std::size_t{9} << 20); ++i) {
+            values.push_back(1e6 + (i % 1000) * 0.25);
+            text += std::to_string(i) + "," + std::to_string(values.back()) + ",\"n," + std::to_string(i % 3) + "\"\n";
+        }
+        // One line longer than the initial window
+        values.push_back(7.0);
+        text += "-1,7,\"" + std::string(std::size_t{5} << 20, 'q') + "\"\n";
+        write_file(tmp_file, text);
+
+        nr::CSVReader reader(tmp_file);
+        nr::RunningStats stats;
+        std::size_t rows = 0;
+        std::size_t batches = 0;
+        const void* reused = nullptr;
+        for (;;) {
+            const nr::CSVBatch& batch = reader.next_batch(50000);
+            if (batch.empty()) break;
+            assert(batch.first_row() == rows);
+            if (batches == 1) reused = batch.view<double>("value").data();
+            if (batches == 2) assert(batch.view<double>("value").data() == reused);   // buffers are reused
+            stats.add(batch.column("value"));
+            rows += batch.row_count();
+            ++batches;
+        }
+        assert(rows == values.size());
+        assert(reader.window_size() >= (std::size_t{5} << 20));
+
+        double mean = 0.0;
+        for (double v : values) mean += v;
+        mean /= static_cast<double>(values.size());
+        double m2 = 0.0;
+        for (double v : values) m2 += (v - mean) * (v - mean);
+        assert(stats.count() == values.size());
+        assert(std::abs(stats.mean() - mean) < 1e-6);
+        assert(std::abs(stats.variance() - m2 / static_cast<double>(values.size() - 1)) < 1e-6 * stats.variance());
+        assert(stats.min() == 7.0);
+        std::remove(tmp_file);
+        std::cout << "Test passed\n";
+    }
+}
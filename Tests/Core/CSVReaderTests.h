@@ -0,0 +1,19 @@
+#ifndef CSVREADERTESTS_H
+#define CSVREADERTESTS_H
+#include "Core/CSVReader.h"
+#include "Core/CSVTable.h"
+#include "io/CsvDataLoader.h"
+#include "stats/RunningStats.h"
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+void csv_reader_tests();
+
+#endif // CSVREADERTESTS_H
@@ -50,4 +50,743 @@ void csv_table_tests()
     assert(names[1] == "Bob");
     assert(names[2] == "Charlie");
     
+
+    {
+        std::cout << "[TEST] CSVTable blank cells as missing values\n";
+
+        nr::CSVTable sparse(std::vector<std::string>{"id", "latency"});
+        sparse.add_row({"1", "10.5"});
+        sparse.add_row({"2", ""});
+        sparse.add_row({"3", "20.5"});
+
+        nr::Bitmap validity;
+        auto latency = sparse.extract<double>("latency", validity);
+        assert(latency.size() == 3);
+        assert(validity.size() == 3);
+        assert(validity[0] && !validity[1] && validity[2]);
+
+        auto sample = sparse.extract_sample<double>("latency");
+        assert(sample.na_count() == 1);
+        assert(sample.arithmetic_mean() == 15.5);
+
+        bool exception_thrown = false;
+        try {
+            sparse.extract<double>("latency");
+        } catch (const std::invalid_argument&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable column-major storage\n";
+
+        nr::CSVTable grid(std::vector<std::string>{"a", "b"});
+        grid.add_row({"1", "x"});
+        grid.add_row({"2", "y"});
+
+        const nr::Column& col = grid.column_data("a");
+        assert(col.size() == 2);
+        assert(&col == &grid.column_data(0));   // column access returns the stored buffer
+        assert(grid.column("a")[1] == "2");
+
+        auto r = grid.row(1);
+        assert(r.size() == 2 && r[0] == "2" && r[1] == "y");
+
+        bool exception_thrown = false;
+        try {
+            grid.row(2);
+        } catch (const std::out_of_range&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable schema inference and typed columns\n";
+
+        const char* typed_file = "tmp_typed.csv";
+        std::ofstream typed_out(typed_file);
+        typed_out << "id,score,flag,label\n"
+                     "1,0.5,true,a\n"
+                     "2,1.25,false,b\n"
+                     "3,,true,c\n"
+                     "4,2,false,7.5\n";
+        typed_out.close();
+
+        CSVDataLoader typed_loader;
+        nr::CSVTable typed(typed_loader, std::string(typed_file));
+
+        assert(typed.column_type_of("id") == nr::ColumnType::int64);
+        assert(typed.column_type_of("score") == nr::ColumnType::float64);
+        assert(typed.column_type_of("flag") == nr::ColumnType::boolean);
+        assert(typed.column_type_of("label") == nr::ColumnType::string);
+
+        auto ids = typed.view<std::int64_t>("id");
+        assert(ids.size() == 4 && ids[3] == 4);
+        assert(typed.column_data("score").na_count() == 1);
+        assert(typed.column("score")[1] == "1.25");
+        assert(typed.row(2)[1].empty());
+
+        auto small_ids = typed.extract<int>("id");
+        assert(small_ids[0] == 1 && small_ids[3] == 4);
+        auto flags = typed.extract<bool>("flag");
+        assert(flags[0] && !flags[1]);
+
+        nr::Bitmap validity;
+        auto scores = typed.extract<double>("score", validity);
+        assert(!validity[2] && scores[3] == 2.0);
+        assert(typed.extract_sample<double>("score").arithmetic_mean() == 1.25);
+
+        bool exception_thrown = false;
+        try {
+            typed.view<double>("id");
+        } catch (const std::invalid_argument&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+
+        // A one-row sample infers int64, the late fractional value forces a second pass
+        std::ofstream late_out(typed_file);
+        late_out << "v\n1\n2\n2.5\n";
+        late_out.close();
+        nr::CSVLoadOptions sampled;
+        sampled.inference_rows = 1;
+        nr::CSVTable late(typed_loader, std::string(typed_file), sampled);
+        assert(late.column_type_of("v") == nr::ColumnType::float64);
+
+        // Explicit schema overrides inference
+        nr::CSVLoadOptions explicit_types;
+        explicit_types.schema = {{"v", nr::ColumnType::string}};
+        nr::CSVTable as_text(typed_loader, std::string(typed_file), explicit_types);
+        assert(as_text.column_type_of("v") == nr::ColumnType::string);
+        assert(as_text.column("v")[2] == "2.5");
+        std::remove(typed_file);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable add_row widening and explicit schema\n";
+
+        nr::CSVTable t(std::vector<std::string>{"n", "x"},
+                       nr::CSVSchema{{"n", nr::ColumnType::int64}});
+        t.add_row({"1", "a"});
+        t.add_row({"2", "b"});
+        assert(t.column_type_of("n") == nr::ColumnType::int64);
+
+        bool exception_thrown = false;
+        try {
+            t.add_row({"x", "c"});
+        } catch (const std::invalid_argument&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        assert(t.row_count() == 2);
+
+        nr::Column c(nr::ColumnType::int64);
+        c.push_back("3");
+        c.widen_to(nr::Column::common_type(c.type(), nr::Column::infer_cell("3.5")));
+        c.push_back("3.5");
+        assert(c.type() == nr::ColumnType::float64);
+        assert(c.view<double>()[0] == 3.0 && c.view<double>()[1] == 3.5);
+        c.widen_to(nr::ColumnType::string);
+        assert(c.view<std::string>()[0] == "3");
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable dictionary-encoded columns\n";
+
+        nr::CSVTable t(std::vector<std::string>{"region", "value"},
+                       nr::CSVSchema{{"region", nr::ColumnType::dictionary}});
+        t.add_row({"eu", "1"});
+        t.add_row({"us", "2"});
+        t.add_row({"eu", "3"});
+        t.add_row({"", "4"});
+        t.add_row({"apac", "5"});
+        t.add_row({"eu", "6"});
+
+        const nr::Column& region = t.column_data("region");
+        assert(region.dictionary().size() == 3);
+        assert(region.dictionary()[0] == "eu");
+        assert(region.na_count() == 1);
+        assert(t.row(3)[0].empty());
+
+        auto codes = t.view<nr::Column::code_type>("region");
+        assert(codes[0] == codes[2] && codes[0] != codes[1]);
+        assert(codes[3] == nr::Column::na_code);
+
+        nr::Bitmap eu = t.equal_to("region", "eu");
+        assert(eu.count() == 3 && eu[0] && eu[2] && eu[5] && !eu[3]);
+        assert(t.equal_to("region", "mars").count() == 0);
+        assert(t.equal_to("value", "4").count() == 1);
+
+        auto groups = t.group_rows("region");
+        assert(groups.size() == 3);
+        assert(groups[region.find_code("us")].size() == 1);
+        assert(groups[region.find_code("eu")].size() == 3);
+
+        // Sampling uses the codes directly as strata labels
+        auto values = t.extract<double>("value");
+        auto sample = nr::ProbabilitySampling::stratified<double>(values, codes, region.dictionary().size(), 3);
+        assert(sample.size() == 3);
+        assert(std::find(sample.begin(), sample.end(), 4.0) == sample.end());
+
+        // Low-cardinality text is dictionary-encoded on inference
+        std::vector<std::string> labels = {"ok", "fail", "ok", "ok", "fail", "ok"};
+        assert(nr::Column::infer(labels, 1024) == nr::ColumnType::dictionary);
+        nr::Column text = nr::Column::from_strings(labels, nr::ColumnType::string);
+        text.widen_to(nr::ColumnType::dictionary);
+        assert(text.dictionary().size() == 2);
+        assert(text.format(4) == "fail");
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable string_view cells over one buffer\n";
+
+        const char* view_file = "tmp_views.csv";
+        std::ofstream view_out(view_file);
+        view_out << "name,age,city,\n"
+                    "Alice,25,Paris\n"
+                    "Bob,,Oslo\n"
+                    "Charlie,22,Paris\n"
+                    "Dora,41,Paris";   // no newline at the end
+        view_out.close();
+
+        CSVDataLoader view_loader;
+        nr::CSVLoadOptions views;
+        views.string_views = true;
+        nr::CSVTable owned(view_loader, std::string(view_file));
+        nr::CSVTable* borrowed = new nr::CSVTable(view_loader, std::string(view_file), views);
+        std::remove(view_file);
+
+        assert(borrowed->row_count() == 4 && borrowed->column_count() == 3);
+        assert(borrowed->column_type_of("age") == nr::ColumnType::int64);
+        assert(borrowed->column_data("name").borrowed());
+        assert(borrowed->view<std::string_view>("name")[2] == "Charlie");
+        assert(borrowed->column_data("age").na_count() == 1);
+        for (std::size_t i = 0; i < owned.row_count(); ++i)
+            assert(borrowed->row(i) == owned.row(i));
+
+        // Copies share the buffer and stay valid after the original is gone
+        nr::CSVTable copy = *borrowed;
+        delete borrowed;
+        assert(copy.column("name")[3] == "Dora");
+        assert(copy.extract<std::string>("name")[0] == "Alice");
+        assert(copy.equal_to("city", "Paris").count() == 3);
+
+        // Appending copies the borrowed text out
+        copy.add_row({"Eve", "30", "Rome"});
+        assert(!copy.column_data("name").borrowed());
+        assert(copy.view<std::string>("name")[4] == "Eve");
+        assert(copy.column_data("name").text(1) == "Bob");
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable column handles\n";
+
+        std::vector<std::string> wide_headers;
+        for (int i = 0; i < 2000; ++i) wide_headers.push_back("f" + std::to_string(i));
+        nr::CSVTable wide(wide_headers);
+        wide.add_row(std::vector<std::string>(2000, "1"));
+
+        assert(wide.has_column("f1999") && !wide.has_column("f2000"));
+        assert(wide.column_index("f1234") == 1234);
+
+        nr::ColumnHandle h = wide.handle("f1999");
+        assert(h.valid() && h.index() == 1999);
+        assert(wide.extract<int>(h)[0] == 1);
+        assert(&wide.column_data(h) == &wide.column_data("f1999"));
+        assert(!nr::ColumnHandle().valid());
+
+        bool exception_thrown = false;
+        try {
+            wide.extract<int>(nr::ColumnHandle());
+        } catch (const std::out_of_range&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+
+        // Duplicated names resolve to the first column
+        nr::CSVTable dup(std::vector<std::string>{"a", "b", "a"});
+        assert(dup.column_index("a") == 0);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable extract_into preallocated buffer\n";
+
+        nr::CSVTable t(std::vector<std::string>{"raw", "n"},
+                       nr::CSVSchema{{"raw", nr::ColumnType::string}});
+        t.add_row({" 1.5", "10"});
+        t.add_row({"2.25", "20"});
+        t.add_row({"-3", "30"});
+
+        std::vector<double> buffer(3);
+        t.extract_into<double>("raw", nr::Span<double>(buffer));
+        assert(buffer[0] == 1.5 && buffer[1] == 2.25 && buffer[2] == -3.0);
+
+        std::vector<float> narrow(3);
+        t.extract_into<float>(t.handle("n"), nr::Span<float>(narrow));
+        assert(narrow[2] == 30.0f);
+
+        bool exception_thrown = false;
+        try {
+            std::vector<double> small(2);
+            t.extract_into<double>("raw", nr::Span<double>(small));
+        } catch (const std::invalid_argument&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+
+        // Trailing garbage is still rejected
+        t.add_row({"4.0abc", "40"});
+        exception_thrown = false;
+        try {
+            t.extract<double>("raw");
+        } catch (const std::invalid_argument&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        assert(t.extract<std::string>("raw")[0] == " 1.5");
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable predicate filters and selections\n";
+
+        nr::CSVTable t(std::vector<std::string>{"status", "latency", "code", "raw"},
+                       nr::CSVSchema{{"status", nr::ColumnType::dictionary},
+                                     {"latency", nr::ColumnType::float64},
+                                     {"code", nr::ColumnType::int64}});
+        const char* statuses[] = {"ok", "error", "ok", "timeout"};
+        for (int i = 0; i < 200; ++i)
+        {
+            std::string latency = (i % 50 == 7) ? "" : std::to_string(i * 1.5);
+            t.add_row({statuses[i % 4], latency, std::to_string(i % 10), std::to_string(i % 10)});
+        }
+
+        nr::Bitmap ok = t.filter("status", nr::CompareOp::eq, "ok");
+        nr::Bitmap slow = t.filter("latency", nr::CompareOp::gt, 100.0);
+        nr::Bitmap sel = ok & slow;
+
+        std::size_t expected = 0;
+        for (int i = 0; i < 200; ++i)
+            if (i % 2 == 0 && i % 50 != 7 && i * 1.5 > 100.0) ++expected;
+        assert(sel.count() == expected);
+
+        // Missing latencies match neither a predicate nor its opposite
+        nr::Bitmap fast = t.filter("latency", nr::CompareOp::le, 100.0);
+        assert(slow.count() + fast.count() == 196);
+        assert((slow | fast).count() == 196);
+        assert((~ok).count() == 100);
+
+        // Fractional thresholds on an int64 column
+        assert(t.filter("code", nr::CompareOp::lt, 2.5).count() == 60);
+        assert(t.filter("code", nr::CompareOp::ge, 2.5).count() == 140);
+        assert(t.filter("code", nr::CompareOp::eq, 2.5).count() == 0);
+        assert(t.filter("code", nr::CompareOp::ne, "3").count() == 180);
+
+        // Numbers kept as text are parsed
+        assert(t.filter("raw", nr::CompareOp::lt, 2.5).count() == 60);
+
+        // Text ordering on a dictionary column
+        assert(t.filter("status", nr::CompareOp::lt, "ok").count() == 50);
+
+        auto selected = t.extract_selected<double>("latency", sel);
+        assert(selected.size() == expected);
+        double total = 0.0;
+        for (double v : selected) total += v;
+
+        // Stats straight over the column with the selection as mask
+        double mean = nr::arithmetic_mean(t.view<double>("latency"), sel, nr::na_policy::skip);
+        assert(std::abs(mean - total / expected) < 1e-9);
+        assert(nr::max(t.view<double>("latency"), sel, nr::na_policy::skip) == 297.0);
+
+        auto codes = t.extract_selected<int>("code", ok);
+        assert(codes.size() == 100 && codes[1] == 2);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] SIMD compare kernels match scalar comparisons\n";
+
+        std::mt19937_64 gen(11);
+        std::uniform_int_distribution<std::int64_t> ints(-50, 50);
+        const std::size_t n = 1000;
+        std::vector<std::int64_t> iv(n);
+        std::vector<double> dv(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            iv[i] = ints(gen);
+            dv[i] = (i % 97 == 0) ? std::nan("") : iv[i] / 4.0;
+        }
+
+        const nr::CompareOp ops[] = {nr::CompareOp::eq, nr::CompareOp::ne, nr::CompareOp::lt,
+                                     nr::CompareOp::le, nr::CompareOp::gt, nr::CompareOp::ge};
+        std::vector<std::uint64_t> words((n + 63) / 64);
+        for (nr::CompareOp op : ops)
+        {
+            nr::detail::compare_to_words(iv.data(), n, op, std::int64_t{3}, words.data());
+            for (std::size_t i = 0; i < n; ++i)
+                assert(((words[i / 64] >> (i % 64)) & 1) == nr::detail::compare(iv[i], op, std::int64_t{3}));
+
+            nr::detail::compare_to_words(dv.data(), n, op, 0.75, words.data());
+            for (std::size_t i = 0; i < n; ++i)
+                assert(((words[i / 64] >> (i % 64)) & 1) == nr::detail::compare(dv[i], op, 0.75));
+        }
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable sort_by permutation, percentiles and top-k\n";
+
+        nr::CSVSchema schema{{"region", nr::ColumnType::dictionary}, {"id", nr::ColumnType::int64},
+                             {"latency", nr::ColumnType::float64}};
+        nr::CSVTable t({"region", "id", "latency", "note"}, schema);
+        t.add_row({"us", "3", "12.5", "c"});
+        t.add_row({"eu", "-7", "", "a"});
+        t.add_row({"us", "1", "30", "b"});
+        t.add_row({"eu", "5", "8.25", "d"});
+        t.add_row({"", "2", "4", "e"});
+        t.add_row({"eu", "-7", "16", "f"});
+
+        // Radix path: dictionary then int64, missing region last, ties stable
+        nr::RowOrder by_region = t.sort_by({"region", "id"});
+        std::vector<std::size_t> expected{1, 5, 3, 2, 0, 4};
+        assert(std::vector<std::size_t>(by_region.begin(), by_region.end()) == expected);
+
+        nr::RowOrder mixed = t.sort_by({"region", "id"}, {nr::SortOrder::descending, nr::SortOrder::ascending});
+        expected = {2, 0, 1, 5, 3, 4};
+        assert(std::vector<std::size_t>(mixed.begin(), mixed.end()) == expected);
+
+        nr::RowOrder by_id = t.sort_by({"id"}, nr::SortOrder::descending);
+        expected = {3, 0, 4, 2, 1, 5};
+        assert(std::vector<std::size_t>(by_id.begin(), by_id.end()) == expected);
+
+        // Comparison path: float64 key with a missing value, string key
+        nr::RowOrder by_latency = t.sort_by({"latency"});
+        expected = {4, 3, 0, 5, 2, 1};
+        assert(std::vector<std::size_t>(by_latency.begin(), by_latency.end()) == expected);
+        assert(by_latency.present_count() == 5);
+
+        nr::RowOrder by_note = t.sort_by({"note"}, nr::SortOrder::descending);
+        assert(by_note[0] == 5 && by_note[5] == 1);
+
+        // Percentiles from the order agree with nr::percentile over present values
+        std::vector<double> present{12.5, 30, 8.25, 4, 16};
+        for (double p : {0.0, 10.0, 25.0, 50.0, 90.0, 100.0})
+        {
+            assert(std::abs(t.percentile(by_latency, p) - nr::percentile(present, p)) < 1e-12);
+            nr::RowOrder desc = t.sort_by({"latency"}, nr::SortOrder::descending);
+            assert(std::abs(t.percentile(desc, p) - nr::percentile(present, p)) < 1e-12);
+        }
+        assert(t.percentile(by_id, 50) == 1.5);
+
+        bool threw = false;
+        try { t.percentile(by_region, 50); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+
+        // Top-k: any column can be read in the sorted order
+        nr::RowOrder slowest = t.sort_by({"latency"}, nr::SortOrder::descending);
+        assert(slowest.top(2).size() == 2);
+        assert(t.extract_rows<std::string>("note", slowest.top(2)) == (std::vector<std::string>{"b", "f"}));
+        assert(t.extract_rows<double>("latency", slowest.top(3)) == (std::vector<double>{30, 16, 12.5}));
+        assert(slowest.top(100).size() == 6);
+
+        // Materialized once: a new table in sorted order, original untouched
+        nr::CSVTable sorted = t.materialize(by_region);
+        assert(sorted.row_count() == 6);
+        assert(sorted.column("note") == (std::vector<std::string>{"a", "f", "d", "b", "c", "e"}));
+        assert(sorted.column("latency")[0] == "" && sorted.column("latency")[1] == "16");
+        assert(sorted.column_data("latency").na_count() == 1);
+        assert(sorted.column_data("region").find_code("eu") == t.column_data("region").find_code("eu"));
+        assert(t.row(0)[3] == "c");
+
+        threw = false;
+        t.add_row({"eu", "9", "1", "g"});
+        try { t.materialize(by_region); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+
+        // Larger radix sort agrees with std::stable_sort
+        std::mt19937_64 gen(5);
+        std::uniform_int_distribution<std::int64_t> keys(-100000, 100000);
+        nr::CSVTable big({"k", "pos"}, {{"k", nr::ColumnType::int64}, {"pos", nr::ColumnType::int64}});
+        std::vector<std::int64_t> ks;
+        for (int i = 0; i < 5000; ++i)
+        {
+            ks.push_back(keys(gen) / 7);
+            big.add_row({std::to_string(ks.back()), std::to_string(i)});
+        }
+        std::vector<std::size_t> reference(ks.size());
+        std::iota(reference.begin(), reference.end(), std::size_t{0});
+        std::stable_sort(reference.begin(), reference.end(),
+                         [&](std::size_t a, std::size_t b) { return ks[a] > ks[b]; });
+        nr::RowOrder big_order = big.sort_by({"k"}, nr::SortOrder::descending);
+        assert(std::vector<std::size_t>(big_order.begin(), big_order.end()) == reference);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable append_rows / append_columns match add_row\n";
+
+        std::vector<nr::CSVTable::row_type> rows = {
+            {"1", "web", "0.5"}, {"2", "db", ""}, {"", "web", "1e3"}, {"4", "cache", "2"}};
+
+        nr::CSVTable one({"id", "host", "x"}, {{"id", nr::ColumnType::int64}, {"host", nr::ColumnType::dictionary},
+                                                {"x", nr::ColumnType::float64}});
+        nr::CSVTable bulk = one;
+        nr::CSVTable by_column = one;
+        for (const auto& r : rows) one.add_row(r);
+
+        bulk.reserve(100);
+        bulk.create_index("host", nr::IndexKind::hash);
+        bulk.append_rows(nr::Span<const nr::CSVTable::row_type>(rows));
+        by_column.append_columns({{"1", "2", "", "4"}, {"web", "db", "web", "cache"}, {"0.5", "", "1e3", "2"}});
+
+        assert(bulk.row_count() == 4 && by_column.row_count() == 4);
+        for (std::size_t i = 0; i < 4; ++i)
+            assert(bulk.row(i) == one.row(i) && by_column.row(i) == one.row(i));
+        assert(bulk.lookup("host", "web").count() == 2);
+
+        // A bad cell anywhere rejects the whole batch
+        std::vector<nr::CSVTable::row_type> bad = {{"5", "web", "1"}, {"x", "db", "2"}};
+        bool threw = false;
+        try { bulk.append_rows(nr::Span<const nr::CSVTable::row_type>(bad)); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw && bulk.row_count() == 4 && bulk.column_data("host").size() == 4);
+
+        threw = false;
+        try { bulk.append_columns({{"5"}, {"web"}}); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+
+        // Inferred columns widen once to the type add_row would end with
+        const char* file = "tmp_bulk.csv";
+        std::ofstream out(file);
+        out << "v\n1\n2\n";
+        out.close();
+        CSVDataLoader loader;
+        nr::CSVTable inferred(loader, std::string(file));
+        std::remove(file);
+        nr::CSVTable stepwise = inferred;
+
+        std::vector<nr::CSVTable::row_type> mixed = {{"3"}, {"2.5"}, {""}, {"7"}};
+        inferred.append_rows(nr::Span<const nr::CSVTable::row_type>(mixed));
+        for (const auto& r : mixed) stepwise.add_row(r);
+        assert(inferred.column_type_of("v") == nr::ColumnType::float64);
+        assert(inferred.column("v") == stepwise.column("v"));
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] TableBuilder freezes typed columns into a table\n";
+
+        nr::TableBuilder builder({"ts", "host", "latency", "ok", "note"},
+                                 {nr::ColumnType::int64, nr::ColumnType::dictionary, nr::ColumnType::float64,
+                                  nr::ColumnType::boolean, nr::ColumnType::string}, 3);
+        for (int i = 0; i < 3; ++i)
+        {
+            builder.append(0, 1000 + i);
+            builder.append(1, i == 1 ? "db" : "web");
+            if (i == 2) builder.append_na(2);
+            else builder.append(2, 0.5 * i);
+            builder.append(3, i != 1);
+            builder.append(4, std::string("n") + std::to_string(i));
+        }
+
+        bool threw = false;
+        try { builder.append(0, 1.5); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+
+        builder.append(0, 2000);
+        threw = false;
+        try { builder.finish(); } catch (const std::logic_error&) { threw = true; }
+        assert(threw);
+
+        nr::TableBuilder exact({"a", "b"}, {nr::ColumnType::float64, nr::ColumnType::dictionary});
+        exact.append(0, 3);
+        exact.append(1, "x");
+        nr::CSVTable small = exact.finish();
+        assert(small.view<double>("a")[0] == 3.0 && small.column("b")[0] == "x");
+
+        nr::TableBuilder full({"ts", "host", "latency"},
+                              {nr::ColumnType::int64, nr::ColumnType::dictionary, nr::ColumnType::float64});
+        for (int i = 0; i < 5; ++i)
+        {
+            full.append(0, std::int64_t{i});
+            full.append(1, i % 2 ? "a" : "b");
+            if (i == 3) full.append_na(2);
+            else full.append(2, i * 1.5);
+        }
+        nr::CSVTable t = full.finish();
+        assert(t.row_count() == 5 && t.column_type_of("host") == nr::ColumnType::dictionary);
+        assert(t.column_data("latency").na_count() == 1 && t.column_data("latency").is_na(3));
+        assert(t.max("latency") == 6.0);
+        assert(t.row(1) == (nr::CSVTable::row_type{"1", "a", "1.5"}));
+
+        // Built columns are typed like a schema
+        threw = false;
+        try { t.add_row({"x", "a", "1"}); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+        t.add_row({"5", "c", "2"});
+        assert(t.row_count() == 6 && full.column_count() == 0);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable extract_cached shares buffers until the table changes\n";
+
+        nr::CSVTable t({"latency", "label"}, {{"latency", nr::ColumnType::float64}});
+        for (int i = 0; i < 1000; ++i) t.add_row({std::to_string(i * 0.5), std::to_string(i)});
+
+        auto first = t.extract_cached<double>("latency");
+        auto again = t.extract_cached<double>("latency");
+        assert(first == again && *first == t.extract<double>("latency"));
+        assert(t.conversion_cache().hits() == 1 && t.conversion_cache().misses() == 1);
+
+        // Keyed by type too: parsing a text column is cached separately
+        auto labels = t.extract_cached<int>("label");
+        assert((*labels)[999] == 999 && t.conversion_cache().entries() == 2);
+
+        // Appending invalidates, old buffers stay valid for their holders
+        t.add_row({"1", "1"});
+        auto fresh = t.extract_cached<double>("latency");
+        assert(fresh != first && fresh->size() == 1001 && first->size() == 1000);
+
+        // LRU eviction within the budget: room for one 8000-byte buffer only
+        t.set_cache_budget(9000);
+        assert(t.conversion_cache().entries() == 1);
+        t.extract_cached<float>("latency");
+        t.extract_cached<double>("latency");
+        assert(t.conversion_cache().entries() == 1 && t.conversion_cache().bytes() <= 9000);
+
+        // Concurrent readers get the same buffer
+        t.set_cache_budget(nr::ConversionCache::default_budget);
+        std::vector<std::shared_ptr<const std::vector<long>>> seen(4);
+        std::vector<std::thread> readers;
+        for (std::size_t r = 0; r < seen.size(); ++r)
+            readers.emplace_back([&, r]() {
+                for (int k = 0; k < 50; ++k) seen[r] = t.extract_cached<long>("label");
+            });
+        for (auto& th : readers) th.join();
+        for (const auto& s : seen) assert(s == seen[0] && s->size() == 1001);
+
+        bool threw = false;
+        try { t.extract_cached<double>("missing"); } catch (const std::out_of_range&) { threw = true; }
+        assert(threw);
+
+        t.clear();
+        assert(t.conversion_cache().entries() == 0);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable slice / take views share the columns\n";
+
+        nr::CSVTable t({"ts", "host", "latency"}, {{"ts", nr::ColumnType::int64}, {"host", nr::ColumnType::dictionary},
+                                                   {"latency", nr::ColumnType::float64}});
+        for (int i = 0; i < 10; ++i)
+            t.add_row({std::to_string(100 + i), i % 3 ? "web" : "db", i == 4 ? "" : std::to_string(i * 1.5)});
+
+        // Training / validation windows
+        nr::TableView train = t.slice(0, 8);
+        nr::TableView valid = t.slice(8, 10);
+        assert(train.row_count() == 8 && valid.row_count() == 2 && train.contiguous());
+        assert(valid.row(0) == t.row(8));
+
+        // Slices expose the typed buffers themselves
+        nr::Span<const std::int64_t> ts = valid.view<std::int64_t>("ts");
+        assert(ts.size() == 2 && ts[1] == 109 && ts.data() == t.view<std::int64_t>("ts").data() + 8);
+
+        nr::Bitmap present;
+        std::vector<double> latency = train.extract<double>("latency", present);
+        assert(latency.size() == 8 && !present[4] && latency[5] == 7.5);
+        assert(train.extract_sample<double>("latency").size() == 8);
+        bool threw = false;
+        try { train.extract<double>("latency"); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+
+        assert(train.min("latency") == 0.0 && train.max("latency") == 10.5 && valid.min("ts") == 108.0);
+
+        // take: any rows, in any order, repeats allowed
+        nr::TableView picked = t.take({9, 0, 9});
+        assert(!picked.contiguous() && picked.column("host") == (std::vector<std::string>{"db", "db", "db"}));
+        assert(picked.extract<std::int64_t>("ts") == (std::vector<std::int64_t>{109, 100, 109}));
+        threw = false;
+        try { picked.view<std::int64_t>("ts"); } catch (const std::logic_error&) { threw = true; }
+        assert(threw);
+
+        // Views of views address the same table rows
+        nr::TableView inner = train.slice(2, 6).take({3, 0});
+        assert(inner.table_row(0) == 5 && inner.table_row(1) == 2);
+
+        // Promoting copies the rows into an owning table with the same column types
+        nr::CSVTable owned = valid.to_table();
+        assert(owned.row_count() == 2 && owned.column_type_of("host") == nr::ColumnType::dictionary);
+        assert(owned.row(1) == t.row(9));
+        threw = false;
+        try { owned.add_row({"x", "db", "1"}); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+
+        const char* file = "tmp_slice.csv";
+        t.slice(5, 8).save(file);
+        CSVDataLoader loader;
+        nr::CSVTable reloaded(loader, std::string(file));
+        std::remove(file);
+        assert(reloaded.row_count() == 3 && reloaded.row(1) == t.row(6));
+
+        threw = false;
+        try { t.slice(5, 11); } catch (const std::out_of_range&) { threw = true; }
+        assert(threw);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVTable loads a column projection\n";
+        const char* file = "tmp_projection_table.csv";
+        std::ofstream out(file, std::ios::binary);
+        out << "ts,host,latency,note\n1,web,1.5,a\n2,db,2.5,b\n3,web,,c\n";
+        out.close();
+
+        CSVDataLoader loader;
+        nr::CSVTable t(loader, file, {"latency", "ts"});
+        assert(t.column_count() == 2 && t.row_count() == 3);
+        assert(t.column_index("latency") == 0 && t.column_index("ts") == 1);
+        assert(t.column_type_of("latency") == nr::ColumnType::float64);
+        assert(!t.has_column("host"));
+
+        // Schema entries for columns left out are ignored, string_views works the same way
+        nr::CSVLoadOptions options;
+        options.string_views = true;
+        options.schema["note"] = nr::ColumnType::string;
+        options.schema["host"] = nr::ColumnType::string;
+        nr::CSVTable views(loader, file, {"host"}, options);
+        assert(views.column_count() == 1 && views.column_type_of("host") == nr::ColumnType::string);
+        assert(views.row(2) == std::vector<std::string>{"web"});
+
+        // The loader's own projection applies when the options name no columns
+        loader.set_projection(CSVDataLoader::Projection{{}, {3}});
+        nr::CSVTable by_index(loader, std::string(file));
+        assert(by_index.column_count() == 1 && by_index.column_index("note") == 0);
+        std::remove(file);
+        std::cout << "Test passed\n";
+    }
 }
@@ -6,12 +6,16 @@
 #include "stats/ProbabilitySampling.h"
 #include "stats/NonProbabilitySampling.h"
 #include "stats/BasicStats.h"
+#include "stats/NullableStats.h"
 #include "io/CsvDataLoader.h"
 
 #include<iostream>
 #include<cassert>
 #include<string>
 #include <sstream>
+#include <cmath>
+#include <random>
+#include <thread>
 
 void csv_table_tests();
 
@@ -0,0 +1,152 @@
+#include "ColumnIndexTests.h"
+
+void column_index_tests()
+{
+    {
+        std::cout << "[TEST] CSVTable lookup and range with and without indexes\n";
+
+        nr::CSVTable t({"host", "latency"}, {{"host", nr::ColumnType::dictionary},
+                                             {"latency", nr::ColumnType::float64}});
+        t.add_row({"web-1", "12"});
+        t.add_row({"db-1", "40"});
+        t.add_row({"web-2", "-0"});
+        t.add_row({"", "nan"});
+        t.add_row({"web-1", ""});
+
+        // Without an index: the same as the filters
+        nr::Bitmap web = t.lookup("host", "web-1");
+        assert(web.count() == 2 && web[0] && web[4]);
+        assert(t.range("latency", 0.0, 20.0).count() == 2);
+
+        t.create_index("host", nr::IndexKind::hash);
+        t.create_index("latency", nr::IndexKind::sorted);
+        assert(t.has_index("host", nr::IndexKind::hash) && !t.has_index("host", nr::IndexKind::sorted));
+
+        assert(t.lookup("host", "web-1").words() == web.words());
+        assert(t.lookup("host", "cache-1").count() == 0);
+
+        nr::Bitmap low = t.range("latency", 0.0, 20.0);
+        assert(low.count() == 2 && low[0] && low[2]);
+        assert(t.range("latency", "12", "40").count() == 2);
+        assert(t.range("latency", 50.0, 10.0).count() == 0);
+
+        // Appended rows are visible right away
+        t.add_row({"web-1", "15"});
+        nr::Bitmap appended = t.lookup("host", "web-1");
+        assert(appended.size() == 6 && appended.count() == 3 && appended[5]);
+        assert(t.range("latency", 0.0, 20.0).count() == 3);
+
+        nr::CSVTable names({"name"});
+        names.add_row({"carol"});
+        names.add_row({"alice"});
+        names.add_row({"bob"});
+        names.create_index("name", nr::IndexKind::sorted);
+        nr::Bitmap ab = names.range("name", "a", "bz");
+        assert(ab.count() == 2 && ab[1] && ab[2]);
+
+        bool threw = false;
+        try { names.range("name", 0.0, 1.0); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+
+        t.drop_index("host", nr::IndexKind::hash);
+        assert(!t.has_index("host", nr::IndexKind::hash));
+        assert(t.lookup("host", "web-1").count() == 3);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] inferred column widened after indexing is reindexed\n";
+
+        const char* file = "tmp_index.csv";
+        std::ofstream out(file);
+        out << "id\n1\n2\n";
+        out.close();
+
+        CSVDataLoader loader;
+        nr::CSVTable t(loader, std::string(file));
+        std::remove(file);
+        assert(t.column_type_of("id") == nr::ColumnType::int64);
+        t.create_index("id", nr::IndexKind::hash);
+        t.create_index("id", nr::IndexKind::sorted);
+
+        t.add_row({"2.5"});
+        assert(t.column_type_of("id") == nr::ColumnType::float64);
+        assert(t.lookup("id", "2.5").count() == 1);
+        assert(t.range("id", 1.5, 3.0).count() == 2);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] indexes match scans (all key types, threads, appended rows)\n";
+
+        std::mt19937_64 gen(41);
+        std::uniform_int_distribution<int> key(-500, 500);
+
+        auto cell = [&](nr::ColumnType type, std::size_t i) -> std::string {
+            int k = key(gen);
+            if (i % 89 == 0) return std::string();
+            switch (type) {
+                case nr::ColumnType::float64:
+                    if (k == 0) return "-0";
+                    if (k == 1) return "nan";
+                    return std::to_string(k / 4.0);
+                case nr::ColumnType::boolean:
+                    return k % 2 ? "true" : "false";
+                case nr::ColumnType::string:
+                case nr::ColumnType::dictionary:
+                    return "k" + std::to_string(k);
+                default:
+                    return std::to_string(k * 1000003LL);
+            }
+        };
+
+        auto check = [&](const nr::CSVTable& t, nr::ColumnType type) {
+            const nr::Column& col = t.column_data("k");
+            bool text = type == nr::ColumnType::string || type == nr::ColumnType::dictionary;
+            for (int q = 0; q < 40; ++q)
+            {
+                std::string probe = cell(type, 1);
+                nr::Bitmap expected = col.equal_to(probe);
+                assert(t.lookup("k", probe).words() == expected.words());
+
+                std::string lo = cell(type, 1), hi = cell(type, 1);
+                if (text || type == nr::ColumnType::boolean) {
+                    nr::Bitmap scan = col.compare(nr::CompareOp::ge, std::string_view(lo)) &
+                                      col.compare(nr::CompareOp::le, std::string_view(hi));
+                    assert(t.range("k", std::string_view(lo), std::string_view(hi)).words() == scan.words());
+                } else {
+                    double a = std::stod(lo) + 0.5, b = std::stod(hi) - 0.25;
+                    nr::Bitmap scan = col.compare(nr::CompareOp::ge, a) & col.compare(nr::CompareOp::le, b);
+                    assert(t.range("k", a, b).words() == scan.words());
+                }
+            }
+        };
+
+        const nr::ColumnType types[] = {nr::ColumnType::int64, nr::ColumnType::float64, nr::ColumnType::boolean,
+                                        nr::ColumnType::dictionary, nr::ColumnType::string};
+        for (nr::ColumnType type : types)
+        {
+            for (std::size_t threads : {std::size_t{1}, std::size_t{4}})
+            {
+                nr::CSVTable t({"k"}, {{"k", type}});
+                for (std::size_t i = 0; i < 40000; ++i) t.add_row({cell(type, i)});
+
+                t.create_index("k", nr::IndexKind::hash, threads);
+                t.create_index("k", nr::IndexKind::sorted, threads);
+                check(t, type);
+
+                // Enough appended rows to merge the sorted index's tail at least once
+                for (std::size_t i = 0; i < 6000; ++i)
+                {
+                    t.add_row({cell(type, i)});
+                    if (i == 100) check(t, type);
+                }
+                check(t, type);
+            }
+        }
+
+        std::cout << "Test passed\n";
+    }
+}
@@ -0,0 +1,16 @@
+#ifndef COLUMNINDEXTESTS_H
+#define COLUMNINDEXTESTS_H
+#include "Core/CSVTable.h"
+#include "Core/ColumnIndex.h"
+
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+void column_index_tests();
+
+#endif // COLUMNINDEXTESTS_H
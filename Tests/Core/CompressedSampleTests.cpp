@@ -0,0 +1,75 @@
+#include "CompressedSampleTests.h"
+
+void compressed_sample_tests()
+{
+    {
+        std::cout << "[TEST] CompressedSample double round trip\n";
+
+        std::mt19937_64 gen(7);
+        std::normal_distribution<double> step(0.0, 0.5);
+
+        std::vector<double> values;
+        double level = 100.0;
+        for (int i = 0; i < 5000; ++i)
+        {
+            // a slowly moving gauge with repeated readings and a few special values
+            if (i % 3 == 0) level += std::round(step(gen) * 10.0) / 10.0;
+            values.push_back(level);
+        }
+        values[17] = -0.0;
+        values[18] = 1e300;
+        values[19] = -1e-300;
+
+        nr::CompressedSample<double> sample(values, 256);
+        assert(sample.size() == values.size());
+        assert(sample.block_count() == (5000 + 255) / 256);
+
+        std::vector<double> decoded = sample.decompress();
+        assert(decoded.size() == values.size());
+        for (size_t i = 0; i < values.size(); ++i)
+            assert(std::memcmp(&decoded[i], &values[i], sizeof(double)) == 0);
+
+        assert(sample.min() == nr::min(values));
+        assert(sample.max() == nr::max(values));
+        assert(std::abs(sample.arithmetic_mean() - nr::arithmetic_mean(values)) < 1e-6);
+        assert(sample.median() == nr::median(values));
+        assert(sample.compression_ratio() > 1.0);
+
+        std::cout << "Test passed: ratio " << sample.compression_ratio() << "\n";
+    }
+
+    {
+        std::cout << "[TEST] CompressedSample integer round trip\n";
+
+        std::vector<std::int64_t> timestamps;
+        std::int64_t t = 1700000000;
+        for (int i = 0; i < 3000; ++i)
+        {
+            t += (i % 500 == 0) ? 7 : 1;
+            timestamps.push_back(t);
+        }
+        timestamps.push_back(std::numeric_limits<std::int64_t>::min());
+        timestamps.push_back(std::numeric_limits<std::int64_t>::max());
+
+        nr::CompressedSample<std::int64_t> sample(timestamps, 1024);
+        assert(sample.decompress() == timestamps);
+        assert(sample.min() == std::numeric_limits<std::int64_t>::min());
+        assert(sample.max() == std::numeric_limits<std::int64_t>::max());
+
+        // regular series pack into almost nothing
+        std::vector<std::int64_t> regular(timestamps.begin(), timestamps.begin() + 2048);
+        nr::CompressedSample<std::int64_t> packed(regular, 1024);
+        assert(packed.compression_ratio() > 10.0);
+
+        std::vector<int> small = {5, -3, 8, 8, 8, 2};
+        nr::CompressedSample<int> ints(small, 4);
+        std::vector<int> block;
+        ints.decode_block(0, block);
+        assert((block == std::vector<int>{5, -3, 8, 8}));
+        ints.decode_block(1, block);
+        assert((block == std::vector<int>{8, 2}));
+        assert(ints.arithmetic_mean() == 4);
+
+        std::cout << "Test passed: ratio " << packed.compression_ratio() << "\n";
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef COMPRESSEDSAMPLETESTS_H
+#define COMPRESSEDSAMPLETESTS_H
+#include "Core/CompressedSample.h"
+#include "stats/BasicStats.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+void compressed_sample_tests();
+
+#endif // COMPRESSEDSAMPLETESTS_H
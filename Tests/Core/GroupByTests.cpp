@@ -0,0 +1,142 @@
+#include "GroupByTests.h"
+
+void group_by_tests()
+{
+    {
+        std::cout << "[TEST] group_by agg on a dictionary key\n";
+
+        nr::CSVTable t({"host", "latency", "bytes"}, {{"host", nr::ColumnType::dictionary},
+                                                      {"latency", nr::ColumnType::float64},
+                                                      {"bytes", nr::ColumnType::int64}});
+        t.add_row({"web", "10", "100"});
+        t.add_row({"db", "40", "5"});
+        t.add_row({"web", "30", "200"});
+        t.add_row({"", "99", "1"});
+        t.add_row({"db", "", "7"});
+        t.add_row({"web", "20", ""});
+        t.add_row({"idle", "", "0"});
+
+        nr::CSVTable s = t.group_by("host").agg({{"latency", nr::agg::mean},
+                                                 {"latency", nr::agg::p99},
+                                                 {"bytes", nr::agg::sum},
+                                                 {"latency", nr::agg::count},
+                                                 {"latency", nr::agg::median, "median_ms"}});
+
+        assert(s.row_count() == 3);
+        assert(s.column_count() == 6);
+        assert(s.has_column("latency_mean") && s.has_column("bytes_sum") && s.has_column("latency_count"));
+        assert(s.column_index("latency_p99") == 2 && s.column_index("median_ms") == 5);
+        assert(s.column("host") == (std::vector<std::string>{"web", "db", "idle"}));
+        assert(s.column_type_of("host") == nr::ColumnType::dictionary);
+
+        auto mean = s.column_data("latency_mean");
+        assert(mean.view<double>()[0] == 20 && mean.view<double>()[1] == 40 && mean.is_na(2));
+
+        std::vector<double> web{10, 30, 20};
+        assert(std::abs(s.view<double>("latency_p99")[0] - nr::percentile(web, 99)) < 1e-12);
+        assert(s.view<double>("median_ms")[0] == 20);
+        assert(s.view<double>("bytes_sum")[0] == 300 && s.view<double>("bytes_sum")[1] == 12);
+        assert(s.view<double>("bytes_sum")[2] == 0);
+        assert(s.view<std::int64_t>("latency_count")[1] == 1 && s.view<std::int64_t>("latency_count")[2] == 0);
+
+        // Aggregated tables are ordinary tables
+        nr::RowOrder slowest = s.sort_by({"latency_mean"}, nr::SortOrder::descending);
+        assert(s.row(slowest[0])[0] == "db");
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] group_by numeric and text keys, validation\n";
+
+        nr::CSVTable t({"code", "ratio", "name", "v"}, {{"code", nr::ColumnType::int64},
+                                                        {"ratio", nr::ColumnType::float64},
+                                                        {"v", nr::ColumnType::int64}});
+        t.add_row({"7", "0", "b", "1"});
+        t.add_row({"-1", "-0", "a", "2"});
+        t.add_row({"7", "0.5", "b", "3"});
+        t.add_row({"", "", "a", "4"});
+
+        nr::CSVTable by_code = t.group_by("code").agg({{"v", nr::agg::min}, {"v", nr::agg::max}});
+        assert(by_code.column("code") == (std::vector<std::string>{"7", "-1"}));
+        assert(by_code.column("v_min") == (std::vector<std::string>{"1", "2"}));
+        assert(by_code.column("v_max") == (std::vector<std::string>{"3", "2"}));
+
+        // 0 and -0 are one key
+        nr::CSVTable by_ratio = t.group_by("ratio").agg({{"v", nr::agg::sum}});
+        assert(by_ratio.column("ratio") == (std::vector<std::string>{"0", "0.5"}));
+        assert(by_ratio.column("v_sum") == (std::vector<std::string>{"3", "3"}));
+
+        nr::CSVTable by_name = t.group_by("name").agg({{"v", nr::agg::percentile(50)}, {"code", nr::agg::count}});
+        assert(by_name.column("v_p50") == (std::vector<std::string>{"2", "3"}));
+        assert(by_name.column("code_count") == (std::vector<std::string>{"2", "1"}));
+
+        auto throws = [&](auto f, auto tag) {
+            try { f(); } catch (const decltype(tag)&) { return true; }
+            return false;
+        };
+        nr::CSVTable text({"k", "s"});
+        text.add_row({"a", "x"});
+        assert(throws([&] { text.group_by("k").agg({{"s", nr::agg::mean}}); }, std::invalid_argument("")));
+        assert(text.group_by("k").agg({{"s", nr::agg::count}}).column("s_count")[0] == "1");
+        assert(throws([&] { t.group_by("code").agg({{"v", nr::agg::sum}, {"v", nr::agg::sum}}); }, std::invalid_argument("")));
+        assert(throws([&] { t.group_by("code").agg({{"v", nr::agg::sum, "code"}}); }, std::invalid_argument("")));
+        assert(throws([&] { t.group_by("code").agg({{"missing", nr::agg::sum}}); }, std::out_of_range("")));
+        assert(throws([&] { t.group_by("code").agg({{"v", nr::agg::percentile(101)}}); }, std::out_of_range("")));
+        assert(throws([&] { t.group_by("nope"); }, std::out_of_range("")));
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] group_by parallel aggregation matches std::map reference\n";
+
+        std::mt19937_64 gen(23);
+        std::uniform_int_distribution<int> key(0, 40000);
+        std::normal_distribution<double> value(100.0, 15.0);
+
+        nr::CSVTable t({"k", "x"}, {{"k", nr::ColumnType::int64}, {"x", nr::ColumnType::float64}});
+        std::map<std::int64_t, std::vector<double>> reference;
+        std::vector<std::int64_t> first_seen;
+        for (int i = 0; i < 100000; ++i)
+        {
+            std::int64_t k = key(gen);
+            double x = std::round(value(gen) * 100) / 100;
+            bool missing = i % 50 == 0;
+            t.add_row({std::to_string(k), missing ? std::string() : nr::detail::format_double(x)});
+            if (reference.find(k) == reference.end()) first_seen.push_back(k);
+            auto& bucket = reference[k];
+            if (!missing) bucket.push_back(x);
+        }
+
+        std::vector<nr::AggregateSpec> specs{{"x", nr::agg::mean}, {"x", nr::agg::sum}, {"x", nr::agg::p95},
+                                             {"x", nr::agg::count}, {"x", nr::agg::max}};
+        nr::CSVTable serial = t.group_by("k").agg(specs, 1);
+        nr::CSVTable parallel = t.group_by("k").agg(specs, 4);
+
+        assert(serial.row_count() == reference.size());
+        assert(parallel.row_count() == serial.row_count());
+        assert(parallel.column("k") == serial.column("k"));
+
+        auto keys = parallel.view<std::int64_t>("k");
+        for (std::size_t g = 0; g < keys.size(); ++g)
+        {
+            assert(keys[g] == first_seen[g]);
+            const auto& xs = reference[keys[g]];
+            assert(parallel.view<std::int64_t>("x_count")[g] == static_cast<std::int64_t>(xs.size()));
+            if (xs.empty()) {
+                assert(parallel.column_data("x_mean").is_na(g) && parallel.column_data("x_p95").is_na(g));
+                continue;
+            }
+            double sum = 0;
+            for (double x : xs) sum += x;
+            assert(std::abs(parallel.view<double>("x_sum")[g] - sum) < 1e-9);
+            assert(std::abs(parallel.view<double>("x_mean")[g] - nr::arithmetic_mean(xs)) < 1e-9);
+            assert(parallel.view<double>("x_p95")[g] == nr::percentile(xs, 95));
+            assert(parallel.view<double>("x_max")[g] == nr::max(xs));
+            assert(serial.view<double>("x_p95")[g] == parallel.view<double>("x_p95")[g]);
+        }
+
+        std::cout << "Test passed\n";
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef GROUPBYTESTS_H
+#define GROUPBYTESTS_H
+#include "Core/CSVTable.h"
+#include "Core/GroupBy.h"
+#include "stats/BasicStats.h"
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+void group_by_tests();
+
+#endif // GROUPBYTESTS_H
@@ -0,0 +1,161 @@
+#include "JoinTests.h"
+
+#include <map>
+
+void join_tests()
+{
+    {
+        std::cout << "[TEST] join metrics with metadata (inner, left, semi, anti)\n";
+
+        nr::CSVTable metrics({"host", "latency"}, {{"host", nr::ColumnType::dictionary},
+                                                   {"latency", nr::ColumnType::float64}});
+        metrics.add_row({"web-1", "12"});
+        metrics.add_row({"db-1", "40"});
+        metrics.add_row({"web-2", "15"});
+        metrics.add_row({"", "99"});
+        metrics.add_row({"web-1", "10"});
+        metrics.add_row({"cache-9", "1"});
+
+        nr::CSVTable hosts({"host", "region"}, {{"host", nr::ColumnType::dictionary}});
+        hosts.add_row({"web-1", "eu"});
+        hosts.add_row({"web-2", "us"});
+        hosts.add_row({"db-1", "eu"});
+
+        nr::JoinResult inner = nr::join(metrics, hosts, "host");
+        assert(inner.size() == 4);
+        assert(inner.left_rows == (std::vector<std::size_t>{0, 1, 2, 4}));
+        assert(inner.right_rows == (std::vector<std::size_t>{0, 2, 1, 0}));
+
+        // Stats over the joined rows without copying them
+        auto regions = hosts.extract_rows<std::string>("region", nr::Span<const std::size_t>(inner.right_rows));
+        auto latency = metrics.extract_rows<double>("latency", nr::Span<const std::size_t>(inner.left_rows));
+        double eu_total = 0;
+        for (std::size_t i = 0; i < regions.size(); ++i)
+            if (regions[i] == "eu") eu_total += latency[i];
+        assert(eu_total == 62);
+
+        nr::JoinResult left = nr::join(metrics, hosts, "host", nr::JoinKind::left);
+        assert(left.left_rows == (std::vector<std::size_t>{0, 1, 2, 3, 4, 5}));
+        assert(left.right_rows[3] == nr::JoinResult::no_match && left.right_rows[5] == nr::JoinResult::no_match);
+        assert(left.right_rows[4] == 0);
+
+        nr::JoinResult semi = nr::join(metrics, hosts, "host", nr::JoinKind::semi);
+        assert(semi.selection.size() == 6 && semi.size() == 4);
+        assert(semi.selection[0] && !semi.selection[3] && !semi.selection[5]);
+        assert(nr::arithmetic_mean(metrics.extract_selected<double>("latency", semi.selection)) == 19.25);
+
+        nr::JoinResult anti = nr::join(metrics, hosts, "host", nr::JoinKind::anti);
+        assert(anti.size() == 2 && anti.selection[3] && anti.selection[5]);
+
+        // Same results when the left table is the smaller (build) side
+        nr::JoinResult from_hosts = nr::join(hosts, metrics, "host", nr::JoinKind::left);
+        assert(from_hosts.left_rows == (std::vector<std::size_t>{0, 0, 1, 2}));
+        assert(from_hosts.right_rows == (std::vector<std::size_t>{0, 4, 2, 1}));
+
+        hosts.add_row({"idle-1", "us"});
+        nr::JoinResult unused = nr::join(hosts, metrics, "host", nr::JoinKind::anti);
+        assert(unused.size() == 1 && unused.selection[3]);
+
+        // Different key names, text keys against dictionary keys
+        nr::CSVTable owners({"name", "owner"});
+        owners.add_row({"db-1", "dba"});
+        nr::JoinOptions options;
+        options.right_on = "name";
+        nr::JoinResult owned = nr::join(metrics, owners, "host", nr::JoinKind::inner, options);
+        assert(owned.left_rows == (std::vector<std::size_t>{1}) && owned.right_rows == (std::vector<std::size_t>{0}));
+
+        bool threw = false;
+        try { nr::join(metrics, owners, "host"); } catch (const std::out_of_range&) { threw = true; }
+        assert(threw);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] join numeric keys compare by value\n";
+
+        nr::CSVTable ints({"id"}, {{"id", nr::ColumnType::int64}});
+        for (const char* v : {"1", "2", "", "3", "2"}) ints.add_row({v});
+        nr::CSVTable reals({"id"}, {{"id", nr::ColumnType::float64}});
+        for (const char* v : {"2.0", "3.5", "1", ""}) reals.add_row({v});
+
+        nr::JoinResult r = nr::join(ints, reals, "id");
+        assert(r.left_rows == (std::vector<std::size_t>{0, 1, 4}));
+        assert(r.right_rows == (std::vector<std::size_t>{2, 0, 0}));
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] join matches a nested-loop reference (all key types, threads)\n";
+
+        std::mt19937_64 gen(17);
+        const nr::JoinKind kinds[] = {nr::JoinKind::inner, nr::JoinKind::left, nr::JoinKind::semi, nr::JoinKind::anti};
+
+        auto check = [&](const nr::CSVTable& l, const nr::CSVTable& r, std::size_t threads) {
+            // Reference: right rows by key text, missing keys never match
+            std::map<std::string, std::vector<std::size_t>> by_key;
+            const nr::Column& rk = r.column_data("k");
+            for (std::size_t i = 0; i < r.row_count(); ++i)
+                if (!rk.is_na(i)) by_key[rk.format(i)].push_back(i);
+
+            const nr::Column& lk = l.column_data("k");
+            for (nr::JoinKind kind : kinds)
+            {
+                nr::JoinOptions options;
+                options.threads = threads;
+                nr::JoinResult got = nr::join(l, r, "k", kind, options);
+
+                std::vector<std::size_t> left_rows, right_rows;
+                nr::Bitmap selection(l.row_count());
+                for (std::size_t i = 0; i < l.row_count(); ++i)
+                {
+                    auto it = lk.is_na(i) ? by_key.end() : by_key.find(lk.format(i));
+                    bool matched = it != by_key.end();
+                    if (kind == nr::JoinKind::semi && matched) selection.set(i);
+                    if (kind == nr::JoinKind::anti && !matched) selection.set(i);
+                    if (matched) {
+                        for (std::size_t j : it->second) {
+                            left_rows.push_back(i);
+                            right_rows.push_back(j);
+                        }
+                    } else if (kind == nr::JoinKind::left) {
+                        left_rows.push_back(i);
+                        right_rows.push_back(nr::JoinResult::no_match);
+                    }
+                }
+
+                if (kind == nr::JoinKind::semi || kind == nr::JoinKind::anti) {
+                    assert(got.selection.size() == selection.size());
+                    assert(got.selection.words() == selection.words());
+                } else {
+                    assert(got.left_rows == left_rows);
+                    assert(got.right_rows == right_rows);
+                }
+            }
+        };
+
+        const nr::ColumnType types[] = {nr::ColumnType::int64, nr::ColumnType::dictionary, nr::ColumnType::string};
+        for (nr::ColumnType type : types)
+        {
+            std::uniform_int_distribution<int> key(0, 3000);
+            auto make = [&](std::size_t rows) {
+                nr::CSVTable t({"k", "v"}, {{"k", type}});
+                for (std::size_t i = 0; i < rows; ++i)
+                {
+                    int k = key(gen);
+                    t.add_row({k % 97 == 0 ? std::string() : std::to_string(k), std::to_string(i)});
+                }
+                return t;
+            };
+
+            nr::CSVTable big = make(40000);
+            nr::CSVTable small = make(2500);
+            check(big, small, 1);
+            check(big, small, 4);
+            check(small, big, 4);
+        }
+
+        std::cout << "Test passed\n";
+    }
+}
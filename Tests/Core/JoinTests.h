@@ -0,0 +1,15 @@
+#ifndef JOINTESTS_H
+#define JOINTESTS_H
+#include "Core/CSVTable.h"
+#include "Core/Join.h"
+#include "stats/BasicStats.h"
+
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <string>
+#include <vector>
+
+void join_tests();
+
+#endif // JOINTESTS_H
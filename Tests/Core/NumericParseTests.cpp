@@ -0,0 +1,86 @@
+#include "NumericParseTests.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+void numeric_parse_tests()
+{
+    {
+        std::cout << "[TEST] NumericParse strict integers\n";
+
+        std::int64_t v = 0;
+        assert(nr::detail::parse_integer(std::string_view("42"), v) && v == 42);
+        assert(nr::detail::parse_integer(std::string_view("+7"), v) && v == 7);
+        assert(nr::detail::parse_integer(std::string_view("-9223372036854775808"), v) && v < 0);
+        assert(!nr::detail::parse_integer(std::string_view("9223372036854775808"), v));
+        assert(!nr::detail::parse_integer(std::string_view(""), v));
+        assert(!nr::detail::parse_integer(std::string_view("12 "), v));
+        assert(!nr::detail::parse_integer(std::string_view(" 12"), v));
+        assert(!nr::detail::parse_integer(std::string_view("+-1"), v));
+        assert(!nr::detail::parse_integer(std::string_view("1.5"), v));
+
+        unsigned u = 0;
+        assert(!nr::detail::parse_integer(std::string_view("-1"), u));
+
+        bool b = false;
+        assert(nr::detail::parse_value(std::string_view("1"), b) && b);
+        assert(nr::detail::parse_value(std::string_view("false"), b) && !b);
+        assert(!nr::detail::parse_value(std::string_view("yes"), b));
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] NumericParse floating point\n";
+
+        double d = 0.0;
+        assert(nr::detail::parse_floating(std::string_view("1.65"), d) && d == 1.65);
+        assert(nr::detail::parse_floating(std::string_view("-2.5e3"), d) && d == -2500.0);
+        assert(nr::detail::parse_floating(std::string_view("+.5"), d) && d == 0.5);
+        assert(!nr::detail::parse_floating(std::string_view("1.5x"), d));
+        assert(!nr::detail::parse_floating(std::string_view("0x1p3"), d));
+        assert(!nr::detail::parse_floating(std::string_view("1e"), d));
+        assert(!nr::detail::parse_floating(std::string_view("1e999"), d));
+
+        float f = 0.0f;
+        assert(nr::detail::parse_floating(std::string_view("0.1"), f) && f == 0.1f);
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] NumericParse fallback matches strtod\n";
+
+        const char* inputs[] = {
+            "0", "-0.0", "3.14159", "1e22", "1e23", "123456789012345678901234",
+            "0.000001234", "9007199254740993", "2.2250738585072014e-308",
+            "4.9e-324", "1.7976931348623157e308", "inf", "-nan", "00012.5000"
+        };
+        for (const char* text : inputs)
+        {
+            double fast = 0.0;
+            assert(nr::detail::parse_floating_fallback(std::string_view(text), fast));
+            double reference = std::strtod(text, nullptr);
+            assert((fast == reference) || (fast != fast && reference != reference));
+        }
+
+        std::mt19937_64 gen(7);
+        std::uniform_real_distribution<double> mantissa(-1e6, 1e6);
+        std::uniform_int_distribution<int> precision(1, 17);
+        char buf[64];
+        for (int i = 0; i < 10000; ++i)
+        {
+            std::snprintf(buf, sizeof(buf), "%.*g", precision(gen), mantissa(gen));
+            double fast = 0.0;
+            assert(nr::detail::parse_floating_fallback(std::string_view(buf), fast));
+            assert(fast == std::strtod(buf, nullptr));
+        }
+
+        double rejected = 0.0;
+        assert(!nr::detail::parse_floating_fallback(std::string_view("1.2.3"), rejected));
+        assert(!nr::detail::parse_floating_fallback(std::string_view("."), rejected));
+        assert(!nr::detail::parse_floating_fallback(std::string_view(" 1"), rejected));
+
+        std::cout << "Test passed\n";
+    }
+}
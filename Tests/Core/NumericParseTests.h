@@ -0,0 +1,12 @@
+#ifndef NUMERICPARSETESTS_H
+#define NUMERICPARSETESTS_H
+#include "Core/NumericParse.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <string>
+
+void numeric_parse_tests();
+
+#endif // NUMERICPARSETESTS_H
@@ -350,4 +350,102 @@ void numeric_sample_tests()
 
         std::cout << "All mean_absolute_deviation tests passed!" << std::endl;
     }
-}
\ No newline at end of file
+
+    {
+        std::cout << "[TEST] NumericSample batched removal\n";
+
+        nr::NumericSample<int> data({5, -1, 7, 100, 3, -8, 250, 4});
+        auto removed = data.remove_if([](int v) { return v < 0 || v > 50; });
+        assert(removed == 4);
+        assert(data.size() == 4);
+        assert(data[0] == 5 && data[1] == 7 && data[2] == 3 && data[3] == 4);
+
+        nr::NumericSample<int> data2({10, 11, 12, 13, 14, 15});
+        data2.remove_indices({0, 2, 5});
+        assert(data2.size() == 3);
+        assert(data2[0] == 11 && data2[1] == 13 && data2[2] == 14);
+
+        bool exception_thrown = false;
+        try {
+            data2.remove_indices({2, 1});
+        } catch (const std::invalid_argument&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        assert(data2.size() == 3);
+
+        std::cout << "Test passed: remove_if / remove_indices\n";
+    }
+
+    {
+        std::cout << "[TEST] NumericSample tombstones and compact\n";
+
+        nr::NumericSample<double> data({1.0, 2.0, 100.0, 3.0, 4.0, -50.0});
+        data.mark_removed(2);
+        data.mark_removed(5);
+        data.mark_removed(5);
+
+        // indices stay stable, stats skip tombstoned values
+        assert(data.size() == 6);
+        assert(data.removed_count() == 2);
+        assert(data.live_size() == 4);
+        assert(data.is_removed(2) && !data.is_removed(3));
+        assert(data.min() == 1.0);
+        assert(data.max() == 4.0);
+        assert(almostEqual(data.arithmetic_mean(), 2.5));
+        assert(almostEqual(data.median(), 2.5));
+        assert(almostEqual(data.weighted_mean({1, 1, 1, 1, 1, 1}), 2.5));
+
+        data.push_back(5.0);
+        data.remove_at(0);
+        assert(data.removed_count() == 2);
+        assert(data.is_removed(1) && data.is_removed(4));
+
+        data.compact();
+        assert(data.size() == 4);
+        assert(data.removed_count() == 0);
+        assert(data[0] == 2.0 && data[1] == 3.0 && data[2] == 4.0 && data[3] == 5.0);
+
+        // bulk removal drops pending tombstones in the same pass
+        nr::NumericSample<int> data2({1, 2, 3, 4, 5});
+        data2.mark_removed(0);
+        data2.remove_if([](int v) { return v == 5; });
+        assert(data2.size() == 3);
+        assert(data2[0] == 2 && data2[2] == 4);
+
+        std::cout << "Test passed: tombstones and compact\n";
+    }
+
+    {
+        std::cout << "[TEST] NumericSample missing values\n";
+
+        nr::NumericSample<double> data({2.0, 4.0});
+        data.push_na();
+        data.push_back(6.0);
+        data.push_na();
+
+        assert(data.size() == 5);
+        assert(data.na_count() == 2);
+        assert(data.is_na(2) && !data.is_na(3));
+        assert(data.min() == 2.0);
+        assert(almostEqual(data.arithmetic_mean(), 4.0));
+        assert(almostEqual(data.median(), 4.0));
+
+        // NA values are never passed to the predicate and survive compaction
+        data.mark_removed(0);
+        auto removed = data.remove_if([](double v) { return v > 5.0; });
+        assert(removed == 1);
+        assert(data.size() == 3);
+        assert(data.na_count() == 2);
+        assert(!data.is_na(0) && data.is_na(1) && data.is_na(2));
+        assert(data.max() == 4.0);
+
+        nr::Bitmap validity(3, true);
+        validity.reset(1);
+        nr::NumericSample<int> ints({1, 0, 3}, validity);
+        assert(ints.na_count() == 1);
+        assert(ints.arithmetic_mean() == 2);
+
+        std::cout << "Test passed: missing values skipped\n";
+    }
+}
@@ -0,0 +1,101 @@
+#include "OrderedSampleTests.h"
+
+void ordered_sample_tests()
+{
+    {
+        std::cout << "[TEST] OrderedSample basic queries\n";
+
+        nr::OrderedSample<int> data(std::vector<int>{54, 63, 48, 29, 27, 32, 41});
+        assert(data.size() == 7);
+        assert(data.min() == 27);
+        assert(data.max() == 63);
+        assert(data.kth(3) == 41);
+        assert(data.rank(41) == 3);
+        assert(data.rank(100) == 7);
+        assert(data.median() == 41);
+        assert(std::abs(data.percentile(25) - 30.5) < 1e-9);
+
+        data.insert(41);
+        assert(data.count(41) == 2);
+        assert(data.erase(41));
+        assert(data.erase(41));
+        assert(!data.erase(41));
+        assert(!data.contains(41));
+        assert(data.size() == 6);
+
+        std::vector<int> in_order(data.begin(), data.end());
+        assert((in_order == std::vector<int>{27, 29, 32, 48, 54, 63}));
+
+        std::cout << "Test passed: kth / rank / percentile\n";
+    }
+
+    {
+        std::cout << "[TEST] OrderedSample random insert/erase against sorted vector\n";
+
+        // A tiny node capacity forces frequent splits, merges and redistributions
+        nr::OrderedSample<int, 4> tree;
+        std::vector<int> reference;
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> value(0, 200);
+
+        for (int step = 0; step < 5000; ++step)
+        {
+            bool do_insert = reference.size() < 50 || gen() % 3 != 0;
+            if (do_insert)
+            {
+                int v = value(gen);
+                tree.insert(v);
+                reference.insert(std::upper_bound(reference.begin(), reference.end(), v), v);
+            }
+            else
+            {
+                int v = reference[gen() % reference.size()];
+                assert(tree.erase(v));
+                reference.erase(std::lower_bound(reference.begin(), reference.end(), v));
+            }
+
+            assert(tree.size() == reference.size());
+            if (step % 97 == 0)
+            {
+                for (size_t k = 0; k < reference.size(); ++k)
+                    assert(tree.kth(k) == reference[k]);
+                int probe = value(gen);
+                auto expected_rank = std::lower_bound(reference.begin(), reference.end(), probe) - reference.begin();
+                assert(tree.rank(probe) == static_cast<size_t>(expected_rank));
+                assert(std::abs(tree.percentile(99) - nr::percentile(reference, 99)) < 1e-9);
+            }
+        }
+
+        while (!reference.empty())
+        {
+            tree.erase_at(0);
+            reference.erase(reference.begin());
+        }
+        assert(tree.empty());
+        assert(tree.begin() == tree.end());
+
+        std::cout << "Test passed: matches sorted vector\n";
+    }
+
+    {
+        std::cout << "[TEST] OrderedSample copy and move\n";
+
+        std::vector<double> values;
+        for (int i = 0; i < 1000; ++i) values.push_back((i * 37) % 1000);
+
+        nr::OrderedSample<double> a(values.begin(), values.end());
+        nr::OrderedSample<double> b = a;
+        b.insert(-1.0);
+        assert(a.size() == 1000);
+        assert(b.size() == 1001);
+        assert(b.min() == -1.0);
+        assert(a.min() == 0.0);
+
+        nr::OrderedSample<double> c = std::move(b);
+        assert(c.size() == 1001);
+        assert(b.empty());
+        assert(std::abs(c.median() - nr::median(std::vector<double>(c.begin(), c.end()))) < 1e-9);
+
+        std::cout << "Test passed: copy and move\n";
+    }
+}
@@ -0,0 +1,12 @@
+#ifndef ORDEREDSAMPLETESTS_H
+#define ORDEREDSAMPLETESTS_H
+#include "Core/OrderedSample.h"
+#include "stats/BasicStats.h"
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <vector>
+
+void ordered_sample_tests();
+
+#endif // ORDEREDSAMPLETESTS_H
@@ -0,0 +1,68 @@
+#include "RingSampleTests.h"
+
+void ring_sample_tests()
+{
+    {
+        std::cout << "[TEST] RingSample overwrite oldest\n";
+
+        nr::RingSample<int> ring(4);
+        assert(ring.empty());
+        assert(ring.capacity() == 4);
+
+        for (int v = 1; v <= 6; ++v) ring.push_back(v);
+
+        // holds the last four values, oldest first
+        assert(ring.full());
+        assert(ring.size() == 4);
+        assert(ring.front() == 3);
+        assert(ring.back() == 6);
+        assert((ring.to_vector() == std::vector<int>{3, 4, 5, 6}));
+
+        auto [first, second] = ring.segments();
+        assert(first.size() == 2 && first[0] == 3 && first[1] == 4);
+        assert(second.size() == 2 && second[0] == 5 && second[1] == 6);
+
+        ring.pop_front();
+        assert(ring.size() == 3);
+        assert(ring[0] == 4);
+
+        std::cout << "Test passed: size is " << ring.size() << "\n";
+    }
+
+    {
+        std::cout << "[TEST] RingSample stats without linearizing\n";
+
+        nr::RingSample<double, 5> ring;
+        for (double v : {100.0, 200.0, 54.0, 63.0, 48.0, 29.0, 27.0}) ring.push_back(v);
+
+        // window is {54, 63, 48, 29, 27}, split across the end of the buffer
+        std::vector<double> window = {54, 63, 48, 29, 27};
+        assert(ring.min() == 27.0);
+        assert(ring.max() == 63.0);
+        assert(std::abs(ring.arithmetic_mean() - 44.2) < 1e-9);
+        assert(ring.median() == 48.0);
+        assert(std::abs(ring.percentile(25) - nr::percentile(window, 25)) < 1e-9);
+        assert(ring.lower_quartile() == nr::lower_quartile(window));
+        assert(ring.upper_quartile() == nr::upper_quartile(window));
+
+        // free functions accept the ring directly
+        assert(nr::median(ring) == 48.0);
+        assert(nr::Scope(ring) == 36.0);
+        assert(std::abs(nr::mean_absolute_deviation(ring) - nr::mean_absolute_deviation(window)) < 1e-9);
+
+        std::cout << "Test passed: median is " << ring.median() << "\n";
+    }
+
+    {
+        std::cout << "[TEST] Selection-based median and percentile\n";
+
+        std::vector<int> even = {7, 1, 5, 3};
+        assert(nr::median(even) == 4);
+        assert(nr::median(even.begin(), even.end()) == 4);
+        assert(std::abs(nr::percentile(even, 90) - 6.4) < 1e-9);
+        // input is left untouched
+        assert((even == std::vector<int>{7, 1, 5, 3}));
+
+        std::cout << "Test passed\n";
+    }
+}
@@ -0,0 +1,11 @@
+#ifndef RINGSAMPLETESTS_H
+#define RINGSAMPLETESTS_H
+#include "Core/RingSample.h"
+#include "stats/BasicStats.h"
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+void ring_sample_tests();
+
+#endif // RINGSAMPLETESTS_H
@@ -0,0 +1,102 @@
+#include "ZoneMapTests.h"
+
+void zone_map_tests()
+{
+    {
+        std::cout << "[TEST] range filter on time-ordered data skips blocks\n";
+
+        const std::size_t n = 100000;
+        std::vector<std::int64_t> ts(n);
+        for (std::size_t i = 0; i < n; ++i) ts[i] = 1700000000 + static_cast<std::int64_t>(i) * 10;
+        nr::Column col = nr::Column::from_values(ts);
+
+        nr::reset_scan_counters();
+        nr::Bitmap recent = col.compare(nr::CompareOp::ge, 1700000000.0 + 950000.0);
+        nr::ScanCounters c = nr::scan_counters();
+
+        assert(recent.count() == 5000 && recent[95000] && !recent[94999]);
+        const std::uint64_t blocks = (n + nr::ZoneMap<std::int64_t>::block_rows - 1) / nr::ZoneMap<std::int64_t>::block_rows;
+        assert(c.blocks_scanned == 1);
+        assert(c.blocks_scanned + c.blocks_skipped + c.blocks_answered == blocks);
+        assert(c.blocks_skipped > c.blocks_answered);
+
+        // min / max come from the zones alone
+        nr::reset_scan_counters();
+        assert(col.min() == 1700000000.0 && col.max() == 1700000000.0 + 999990.0);
+        assert(nr::scan_counters().blocks_scanned == 0);
+
+        // A selection reads only the blocks it covers partially
+        assert(col.min(recent) == 1700950000.0);
+        assert(col.max(~recent) == 1700949990.0);
+        assert(!col.min(nr::Bitmap(n)).has_value());
+
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] zoned compare and min/max match a scan (NA, NaN, appends)\n";
+
+        std::mt19937_64 gen(42);
+        std::uniform_int_distribution<int> pick(0, 999);
+
+        nr::CSVTable t({"x", "k"}, {{"x", nr::ColumnType::float64}, {"k", nr::ColumnType::int64}});
+        for (std::size_t i = 0; i < 30000; ++i)
+        {
+            int r = pick(gen);
+            // Mostly ascending with noise, some missing and NaN cells, a constant stretch
+            std::string x = r < 20 ? std::string() : r < 30 ? std::string("nan")
+                          : i >= 12288 && i < 16384 ? std::string("7") : std::to_string(static_cast<double>(i) + r / 100.0);
+            std::string k = r % 97 == 0 ? std::string() : std::to_string(static_cast<int>(i / 10) - r);
+            t.add_row({x, k});
+        }
+
+        const nr::CompareOp ops[] = {nr::CompareOp::eq, nr::CompareOp::ne, nr::CompareOp::lt,
+                                     nr::CompareOp::le, nr::CompareOp::gt, nr::CompareOp::ge};
+        const double values[] = {-5.0, 7.0, 1234.5, 20000.0, 29999.99, 1e9, std::nan("")};
+
+        for (const char* name : {"x", "k"})
+        {
+            const nr::Column& col = t.column_data(name);
+            for (nr::CompareOp op : ops)
+            {
+                for (double v : values)
+                {
+                    nr::Bitmap got = t.filter(name, op, v);
+                    for (std::size_t i = 0; i < col.size(); ++i)
+                    {
+                        bool expected = !col.is_na(i) &&
+                                        (col.type() == nr::ColumnType::float64
+                                             ? nr::detail::compare(col.view<double>()[i], op, v)
+                                             : nr::detail::compare(static_cast<double>(col.view<std::int64_t>()[i]), op, v));
+                        assert(got[i] == expected);
+                    }
+                }
+            }
+
+            // min / max against a scan, over everything and over a selection
+            nr::Bitmap sel = t.filter("x", nr::CompareOp::lt, 15000.0);
+            std::optional<double> lo, hi, sel_lo, sel_hi;
+            for (std::size_t i = 0; i < col.size(); ++i)
+            {
+                if (col.is_na(i)) continue;
+                double v = col.type() == nr::ColumnType::float64 ? col.view<double>()[i]
+                                                                 : static_cast<double>(col.view<std::int64_t>()[i]);
+                if (std::isnan(v)) continue;
+                if (!lo || v < *lo) lo = v;
+                if (!hi || v > *hi) hi = v;
+                if (sel[i] && (!sel_lo || v < *sel_lo)) sel_lo = v;
+                if (sel[i] && (!sel_hi || v > *sel_hi)) sel_hi = v;
+            }
+            assert(t.min(name) == lo && t.max(name) == hi);
+            assert(t.min(name, sel) == sel_lo && t.max(name, sel) == sel_hi);
+        }
+
+        bool threw = false;
+        nr::CSVTable names({"name"});
+        names.add_row({"a"});
+        try { names.min("name"); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+
+        std::cout << "Test passed\n";
+    }
+}
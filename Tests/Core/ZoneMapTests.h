@@ -0,0 +1,17 @@
+#ifndef ZONEMAPTESTS_H
+#define ZONEMAPTESTS_H
+#include "Core/CSVTable.h"
+#include "Core/Instrumentation.h"
+#include "Core/ZoneMap.h"
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+void zone_map_tests();
+
+#endif // ZONEMAPTESTS_H
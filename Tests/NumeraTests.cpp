@@ -1,20 +1,44 @@
+#include "Core/CSVReaderTests.h"
 #include "Core/CSVTableTests.h"
+#include "Core/ColumnIndexTests.h"
+#include "Core/CompressedSampleTests.h"
+#include "Core/GroupByTests.h"
+#include "Core/JoinTests.h"
+#include "Core/NumericParseTests.h"
 #include "Core/NumericSampleTests.h"
+#include "Core/OrderedSampleTests.h"
+#include "Core/RingSampleTests.h"
+#include "Core/ZoneMapTests.h"
 #include "io/CsvDataLoaderTests.h"
 #include "io/FileDataLoaderTests.h"
+#include "io/MappedFileTests.h"
 #include "stats/BasicStatsTests.h"
 #include "stats/NonProbabilitySamplingTests.h"
+#include "stats/NullableStatsTests.h"
 #include "stats/ProbabilitySamplingTests.h"
+#include "stats/RunningStatsTests.h"
 
 int main()
 {
     basic_stats_tests();
+    csv_reader_tests();
     csv_table_tests();
+    column_index_tests();
+    compressed_sample_tests();
+    group_by_tests();
+    join_tests();
+    numeric_parse_tests();
     numeric_sample_tests();
+    ordered_sample_tests();
+    ring_sample_tests();
+    zone_map_tests();
     csv_data_loader();
     file_data_loader_tests();    
+    mapped_file_tests();
     non_probability_sampling_tests();
+    nullable_stats_tests();
     probability_sampling_tests();
+    running_stats_tests();
 
     return 0;
 }
\ No newline at end of file
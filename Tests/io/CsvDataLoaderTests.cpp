@@ -1,7 +1,181 @@
 #include "CsvDataLoaderTests.h"
 
+namespace
+{
+    // Lines of cells as split by nr::detail::scan_csv
+    std::vector<std::vector<std::string>> scan(std::string text)
+    {
+        std::vector<std::vector<std::string>> lines(1);
+        nr::detail::scan_csv(&text[0], text.size(),
+            [&](std::size_t, std::string_view cell) { lines.back().emplace_back(cell); },
+            [&](std::size_t) { lines.emplace_back(); });
+        lines.pop_back();
+        return lines;
+    }
+
+    using Lines = std::vector<std::vector<std::string>>;
+}
+
 void csv_data_loader()
 {
+    {
+        std::cout << "[TEST] scan_csv splits plain lines like split()\n";
+        assert((scan("a,b,c\n1,2,3\n") == Lines{{"a", "b", "c"}, {"1", "2", "3"}}));
+        assert((scan("a,b\n1,2") == Lines{{"a", "b"}, {"1", "2"}}));       // no final newline
+        assert((scan("a,,c\n") == Lines{{"a", "", "c"}}));
+        assert((scan("a,b,\n") == Lines{{"a", "b"}}));                     // trailing delimiter
+        assert((scan("a\n\nb\n") == Lines{{"a"}, {}, {"b"}}));            // blank line
+        assert(scan("").empty());
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] scan_csv handles quotes and CRLF\n";
+        assert((scan("\"x,y\",2\r\n") == Lines{{"x,y", "2"}}));
+        assert((scan("\"two\nlines\",z\n") == Lines{{"two\nlines", "z"}}));
+        assert((scan("\"say \"\"hi\"\"\",\"\"\n") == Lines{{"say \"hi\"", ""}}));
+        assert((scan("a\r\nb\r\n") == Lines{{"a"}, {"b"}}));
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] scan_csv across 64-byte blocks\n";
+        std::string text;
+        Lines expected;
+        for (int row = 0; row < 200; ++row) {
+            std::vector<std::string> cells;
+            for (int col = 0; col < 7; ++col) {
+                std::string cell(static_cast<std::size_t>((row * 7 + col) % 23), static_cast<char>('a' + col));
+                if ((row + col) % 5 == 0) {
+                    // Quoted cell with a delimiter, a newline and an escaped quote somewhere in it
+                    text += "\"" + cell + ",\n\"\"" + cell + "\"";
+                    cell = cell + ",\n\"" + cell;
+                } else {
+                    text += cell;
+                }
+                if (col + 1 < 7) text += ",";
+                cells.push_back(cell);
+            }
+            text += row % 3 == 0 ? "\r\n" : "\n";
+            while (!cells.empty() && cells.back().empty()) cells.pop_back();   // trailing empty cell is dropped
+            expected.push_back(cells);
+        }
+        assert(scan(text) == expected);
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVDataLoader loads quoted cells\n";
+        const char* tmp_file = "tmp_scanner_test.csv";
+        std::ofstream out(tmp_file, std::ios::binary);
+        out << "name,\"note, long\"\r\n"
+               "alice,\"likes \"\"csv\"\"\"\r\n"
+               "bob,\"line\nbreak\"\r\n";
+        out.close();
+
+        CSVDataLoader loader;
+        auto raw = loader.load_views(tmp_file);
+        assert((raw.headers == std::vector<std::string>{"name", "note, long"}));
+        assert(raw.columns.size() == 2 && raw.columns[1].size() == 2);
+        assert(raw.columns[1][0] == "likes \"csv\"");
+        assert(raw.columns[1][1] == "line\nbreak");
+
+        auto data = loader.load(tmp_file);
+        std::remove(tmp_file);
+        assert((loader.get_column_order() == std::vector<std::string>{"name", "note, long"}));
+        assert((data.at("name") == std::vector<std::string>{"alice", "bob"}));
+        assert(data.at("note, long")[1] == "line\nbreak");
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVDataLoader parses chunks in parallel\n";
+        // Mostly quoted multi-line cells, so speculative chunk starts land inside quotes
+        const char* tmp_file = "tmp_parallel_test.csv";
+        std::string text = "id,note,value\n";
+        std::string note;
+        for (int k = 0; k < 40; ++k) note += "a,b\nc \"\"d\"\"\n";
+        int rows = 0;
+        while (text.size() < (std::size_t{6} << 20)) {
+            text += std::to_string(rows) + ",\"" + note + std::to_string(rows) + "\"," + std::to_string(rows * 0.5) + "\n";
+            if (rows % 7 == 0) text += std::to_string(rows) + "+,plain," + std::to_string(rows) + "\r\n";
+            ++rows;
+        }
+        std::ofstream out(tmp_file, std::ios::binary);
+        out << text;
+        out.close();
+
+        CSVDataLoader serial;
+        serial.set_threads(1);
+        auto one = serial.load_views(tmp_file);
+
+        CSVDataLoader parallel;
+        parallel.set_threads(6);
+        assert(parallel.threads() == 6);
+        auto many = parallel.load_views(tmp_file);
+        assert(one.headers == many.headers);
+        assert(one.columns == many.columns);
+        assert(many.columns[0].size() == static_cast<std::size_t>(rows + (rows + 6) / 7));
+        assert(many.columns[0][1] == "0+" && many.columns[1][1] == "plain");
+
+        std::string unescaped;
+        for (int k = 0; k < 40; ++k) unescaped += "a,b\nc \"d\"\n";
+        assert(many.columns[1][0] == unescaped + "0" && many.columns[1][2] == unescaped + "1");
+
+        auto data = parallel.load(tmp_file);
+        std::remove(tmp_file);
+        assert(data.at("id").size() == many.columns[0].size());
+        assert(data.at("note")[0] == unescaped + "0");
+        assert(data.at("value").back() == many.columns[2].back());
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] CSVDataLoader loads only projected columns\n";
+        const char* tmp_file = "tmp_projection_test.csv";
+        std::ofstream out(tmp_file, std::ios::binary);
+        out << "a,b,c,d\n1,\"x,\"\"y\"\"\",3,4\n5,z,7,8\n";
+        out.close();
+
+        CSVDataLoader loader;
+        auto raw = loader.load_views(tmp_file, CSVDataLoader::Projection{{"d", "b"}, {}});
+        assert((raw.headers == std::vector<std::string>{"d", "b"}));
+        assert(raw.columns.size() == 2);
+        assert(raw.columns[0][1] == "8" && raw.columns[1][0] == "x,\"y\"");
+
+        loader.set_projection(CSVDataLoader::Projection{{}, {2}});
+        auto data = loader.load(tmp_file);
+        assert(data.size() == 1);
+        assert((data.at("c") == std::vector<std::string>{"3", "7"}));
+        assert((loader.get_column_order() == std::vector<std::string>{"c"}));
+
+        bool threw = false;
+        try {
+            loader.load_views(tmp_file, CSVDataLoader::Projection{{"a", "e"}, {}});
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+
+        threw = false;
+        try {
+            loader.load(tmp_file, CSVDataLoader::Projection{{"a", "a"}, {}});
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+
+        threw = false;
+        try {
+            loader.load(tmp_file, CSVDataLoader::Projection{{}, {4}});
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+        std::remove(tmp_file);
+        std::cout << "Test passed\n";
+    }
+
     /*
     std::string csv_content = 
         "Name,Age,Height\n"
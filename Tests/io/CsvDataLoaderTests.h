@@ -1,10 +1,13 @@
 #ifndef CSVDATALOADERTESTS_H
 #define CSVDATALOADERTESTS_H
 #include "io/CsvDataLoader.h"
+#include "io/CsvScanner.h"
 #include <iostream>
 #include <cassert>
 #include <string>
 #include <fstream>
+#include <cstdio>
+#include <vector>
 #include "Core/CSVTable.h"
 
 void csv_data_loader();
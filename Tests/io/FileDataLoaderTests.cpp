@@ -13,8 +13,61 @@ void file_data_loader_tests()
         FileDataLoader file_loader;
         nr::NumericSample<double> dt(file_loader.load("tmp_test.txt"));
         std::cout << "Count:\t" << dt.size() << std::endl;
+        assert(dt.size() == 3);
         std::cout << "Min:\t" << nr::min(dt) << std::endl;
         std::cout << "Test passed\n";
         std::remove(tmp_file);
     }
+
+    {
+        const char* tmp_file = "tmp_test.txt";
+
+        std::ofstream out(tmp_file);
+        out << "1.5,,2.5,3.5";
+        out.close();
+
+        std::cout << "[TEST] Empty tokens as missing values\n";
+        FileDataLoader file_loader;
+        nr::Bitmap validity;
+        auto values = file_loader.load(tmp_file, validity);
+        assert(values.size() == 4);
+        assert(validity.size() == 4);
+        assert(!validity[1]);
+
+        nr::NumericSample<double> dt(values, validity);
+        assert(dt.na_count() == 1);
+        assert(dt.min() == 1.5);
+        std::cout << "Test passed\n";
+        std::remove(tmp_file);
+    }
+
+    {
+        const char* tmp_file = "tmp_test.txt";
+
+        std::ofstream out(tmp_file, std::ios::binary);
+        out << " 1.5 ,2e1\r\n\r\n-3,\n";
+        out.close();
+
+        std::cout << "[TEST] Mapped tokens with spaces, CRLF and blank lines\n";
+        FileDataLoader file_loader;
+        nr::Bitmap validity;
+        auto values = file_loader.load(tmp_file, validity);
+        assert(values.size() == 5);
+        assert(values[0] == 1.5 && values[1] == 20.0 && values[3] == -3.0);
+        assert(!validity[2] && !validity[4]);
+        assert(file_loader.load(tmp_file).size() == 3);
+
+        std::ofstream bad(tmp_file);
+        bad << "1.0,2.0x\n";
+        bad.close();
+        bool threw = false;
+        try {
+            file_loader.load(tmp_file);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+        std::cout << "Test passed\n";
+        std::remove(tmp_file);
+    }
 }
@@ -0,0 +1,89 @@
+#include "MappedFileTests.h"
+
+void mapped_file_tests()
+{
+    {
+        std::cout << "[TEST] MappedFile maps a regular file copy-on-write\n";
+        const char* tmp_file = "tmp_mapped_test.txt";
+        std::ofstream out(tmp_file, std::ios::binary);
+        out << "alpha,beta\n";
+        out.close();
+
+        {
+            MappedFile file(tmp_file);
+            assert(file.mapped());
+            assert(file.size() == 11);
+            assert(std::string_view(file.data(), file.size()) == "alpha,beta\n");
+            file.data()[0] = 'A';   // private mapping: the file keeps its bytes
+        }
+
+        MappedFile again(tmp_file);
+        assert(std::string_view(again.data(), again.size()) == "alpha,beta\n");
+        std::remove(tmp_file);
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] MappedFile handles empty and missing files\n";
+        const char* tmp_file = "tmp_mapped_empty.txt";
+        std::ofstream(tmp_file).close();
+        MappedFile file(tmp_file);
+        assert(file.empty());
+        std::remove(tmp_file);
+
+        bool threw = false;
+        try {
+            MappedFile missing("tmp_mapped_missing.txt");
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] MappedFile reads a pipe into a buffer\n";
+        const char* fifo = "tmp_mapped_fifo";
+        std::remove(fifo);
+        assert(mkfifo(fifo, 0600) == 0);
+
+        std::string text = "x,y\n";
+        for (int i = 0; i < 300000; ++i) text += std::to_string(i) + "," + std::to_string(i % 7) + "\n";
+        std::thread writer([&]() {
+            std::ofstream out(fifo, std::ios::binary);
+            out << text;
+        });
+
+        CSVDataLoader loader;
+        auto raw = loader.load_views(fifo);
+        writer.join();
+        std::remove(fifo);
+
+        assert(raw.columns.size() == 2);
+        assert(raw.columns[0].size() == 300000);
+        assert(raw.columns[0].back() == "299999" && raw.columns[1].back() == "0");
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] string_view cells keep the mapping alive\n";
+        const char* tmp_file = "tmp_mapped_table.csv";
+        std::ofstream out(tmp_file, std::ios::binary);
+        out << "host,\"note\"\nweb-1,\"a \"\"b\"\"\"\nweb-2,plain\n";
+        out.close();
+
+        nr::CSVLoadOptions options;
+        options.string_views = true;
+        options.schema["host"] = nr::ColumnType::string;
+        options.schema["note"] = nr::ColumnType::string;
+        nr::CSVTable table = [&]() {
+            CSVDataLoader loader;
+            return nr::CSVTable(loader, tmp_file, options);
+        }();
+        std::remove(tmp_file);
+
+        assert(table.column("note")[0] == "a \"b\"");
+        assert(table.column("host")[1] == "web-2");
+        std::cout << "Test passed\n";
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef MAPPEDFILETESTS_H
+#define MAPPEDFILETESTS_H
+#include "io/MappedFile.h"
+#include "io/CsvDataLoader.h"
+#include "Core/CSVTable.h"
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <sys/stat.h>
+
+void mapped_file_tests();
+
+#endif // MAPPEDFILETESTS_H
@@ -0,0 +1,65 @@
+#include "NullableStatsTests.h"
+
+void nullable_stats_tests()
+{
+    {
+        std::cout << "[TEST] Bitmap runs\n";
+
+        nr::Bitmap bits(200, true);
+        bits.reset(3);
+        bits.reset(64);
+        bits.reset(65);
+        for (size_t i = 130; i < 192; ++i) bits.reset(i);
+
+        std::vector<std::pair<size_t, size_t>> runs;
+        bits.for_each_run([&](size_t b, size_t e) { runs.push_back({b, e}); });
+
+        assert(runs.size() == 4);
+        assert(runs[0].first == 0 && runs[0].second == 3);
+        assert(runs[1].first == 4 && runs[1].second == 64);
+        assert(runs[2].first == 66 && runs[2].second == 130);
+        assert(runs[3].first == 192 && runs[3].second == 200);
+        assert(bits.count() == 200 - 1 - 2 - 62);
+
+        std::cout << "Test passed: runs glued across words\n";
+    }
+
+    {
+        std::cout << "[TEST] Stats with missing values\n";
+
+        std::vector<double> data = {4.0, 0.0, 1.0, 9.0, 0.0, 6.0};
+        nr::Bitmap validity(data.size(), true);
+        validity.reset(1);
+        validity.reset(4);
+
+        assert(nr::count_valid(data, validity) == 4);
+        assert(nr::min(data, validity, nr::na_policy::skip) == 1.0);
+        assert(nr::max(data, validity, nr::na_policy::skip) == 9.0);
+        assert(nr::sum(data, validity, nr::na_policy::skip) == 20.0);
+        assert(nr::arithmetic_mean(data, validity, nr::na_policy::skip) == 5.0);
+        assert(nr::median(data, validity, nr::na_policy::skip) == 5.0);
+        assert(std::abs(nr::percentile(data, validity, 50, nr::na_policy::skip) - 5.0) < 1e-9);
+
+        // An empty bitmap means that every value is present
+        assert(nr::arithmetic_mean(data, nr::Bitmap(), nr::na_policy::error) == 20.0 / 6.0);
+
+        bool exception_thrown = false;
+        try {
+            nr::arithmetic_mean(data, validity, nr::na_policy::error);
+        } catch (const std::domain_error&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+
+        nr::Bitmap none(data.size(), false);
+        exception_thrown = false;
+        try {
+            nr::min(data, none, nr::na_policy::skip);
+        } catch (const std::invalid_argument&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+
+        std::cout << "Test passed: missing values skipped\n";
+    }
+}
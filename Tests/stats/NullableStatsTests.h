@@ -0,0 +1,12 @@
+#ifndef NULLABLESTATSTESTS_H
+#define NULLABLESTATSTESTS_H
+#include "stats/NullableStats.h"
+#include "Core/Bitmap.h"
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+void nullable_stats_tests();
+
+#endif // NULLABLESTATSTESTS_H
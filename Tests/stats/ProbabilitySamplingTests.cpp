@@ -55,4 +55,19 @@ void probability_sampling_tests()
         std::cout << "[TEST] successfully!\n";
     }
 
-}
\ No newline at end of file
+    {
+        std::cout << "[TEST] Stratified sampling (dense codes)\n";
+        std::vector<double> stats({10,11,12,13, 20,21,22,23,24, 30,31,32, 99});
+        // three strata; the last row has a missing label and is never drawn
+        std::vector<std::uint32_t> codes = {1,1,1,1, 0,0,0,0,0, 2,2,2, 0xFFFFFFFFu};
+        size_t sampleSize = 6;
+
+        auto strat = nr::ProbabilitySampling::stratified<double>(stats, nr::Span<const std::uint32_t>(codes), 3, sampleSize);
+        assert(strat.size() == sampleSize);
+        assert(std::find(strat.begin(), strat.end(), 99.0) == strat.end());
+
+        std::vector<std::uint32_t> shortCodes = {0, 1};
+        assert(nr::ProbabilitySampling::stratified<double>(stats, nr::Span<const std::uint32_t>(shortCodes), 2, sampleSize).empty());
+        std::cout << "[TEST] successfully!\n";
+    }
+}
@@ -0,0 +1,78 @@
+#include "RunningStatsTests.h"
+
+void running_stats_tests()
+{
+    {
+        std::cout << "[TEST] RunningStats matches the two-pass formulas\n";
+        std::vector<double> data = {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0};
+        nr::RunningStats all;
+        all.add(data);
+        assert(all.count() == 8);
+        assert(all.mean() == 5.0);
+        assert(all.sum() == 40.0);
+        assert(std::abs(all.population_variance() - 4.0) < 1e-12);
+        assert(std::abs(all.variance() - 32.0 / 7.0) < 1e-12);
+        assert(all.min() == 2.0 && all.max() == 9.0);
+
+        // One value at a time, and two halves merged, give the same state
+        nr::RunningStats single, left, right;
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            single.add(data[i]);
+            (i < 3 ? left : right).add(data[i]);
+        }
+        left.merge(right);
+        assert(std::abs(single.variance() - all.variance()) < 1e-12);
+        assert(std::abs(left.variance() - all.variance()) < 1e-12);
+        assert(left.mean() == 5.0 && left.min() == 2.0 && left.max() == 9.0);
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] RunningStats skips missing values and reads columns\n";
+        std::vector<std::int64_t> values = {1, 100, 3, 100, 5};
+        nr::Bitmap validity(5, true);
+        validity.set(1, false);
+        validity.set(3, false);
+
+        nr::RunningStats s;
+        s.add(values, validity);
+        assert(s.count() == 3 && s.mean() == 3.0 && s.max() == 5.0);
+
+        nr::RunningStats c;
+        c.add(nr::Column::from_values(values, validity));
+        assert(c.count() == 3 && c.variance() == 4.0);
+
+        bool threw = false;
+        try {
+            c.add(nr::Column::from_values(std::vector<std::string>{"a"}));
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+        std::cout << "Test passed\n";
+    }
+
+    {
+        std::cout << "[TEST] RunningStats stays accurate far from zero\n";
+        nr::RunningStats s;
+        for (int batch = 0; batch < 100; ++batch) {
+            std::vector<double> values;
+            for (int i = 0; i < 1000; ++i) values.push_back(1e9 + (i % 2 ? 1.0 : -1.0));
+            s.add(values);
+        }
+        assert(std::abs(s.population_variance() - 1.0) < 1e-6);
+        assert(std::abs(s.mean() - 1e9) < 1e-6);
+
+        nr::RunningStats none;
+        {
+            bool threw = false;
+            try {
+                none.mean();
+            } catch (const std::invalid_argument&) {
+                threw = true;
+            }
+            assert(threw);
+        }
+        std::cout << "Test passed\n";
+    }
+}
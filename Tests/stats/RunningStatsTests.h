@@ -0,0 +1,16 @@
+#ifndef RUNNINGSTATSTESTS_H
+#define RUNNINGSTATSTESTS_H
+#include "stats/RunningStats.h"
+#include "Core/Bitmap.h"
+#include "Core/Column.h"
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+void running_stats_tests();
+
+#endif // RUNNINGSTATSTESTS_H